@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+# Copyright 2025 © Froströk. All Rights Reserved.
+"""Downloads the cl100k_base tokenizer vocabulary, so the plugin counts prompt tokens exactly.
+
+The file goes where the plugin looks when no Tokenizer Vocabulary is set in its settings:
+    Plugins/UnrealMastermind/Resources/Tokenizers/cl100k_base.tiktoken
+Any other vocabulary in tiktoken's format (one base64 token and its rank per line) can be set there instead.
+The download is checked against the hash tiktoken itself expects.
+
+    python fetch_tokenizer.py [--output PATH]
+"""
+
+import argparse
+import hashlib
+import os
+import sys
+import urllib.request
+
+URL = "https://openaipublic.blob.core.windows.net/encodings/cl100k_base.tiktoken"
+SHA256 = "223921b76ee99bde995b7ff738513eef100fb51d18c93597a113bcffe865b2a7"
+DEFAULT_OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, "Resources", "Tokenizers",
+                              "cl100k_base.tiktoken")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--output", default=DEFAULT_OUTPUT, help="where to write the vocabulary")
+    args = parser.parse_args()
+
+    with urllib.request.urlopen(URL) as response:
+        data = response.read()
+
+    digest = hashlib.sha256(data).hexdigest()
+    if digest != SHA256:
+        sys.exit(f"The download from {URL} has hash {digest}, expected {SHA256}; not written")
+
+    output = os.path.normpath(args.output)
+    os.makedirs(os.path.dirname(output), exist_ok=True)
+    with open(output, "wb") as file:
+        file.write(data)
+    print(f"Wrote {len(data)} bytes to {output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+# Copyright 2025 © Froströk. All Rights Reserved.
+"""Local stand-in for the OpenAI and Anthropic chat endpoints, for trying out streamed responses.
+
+Point the plugin's endpoint settings at it, e.g.
+    OpenAI Endpoint:    http://127.0.0.1:8765/v1/chat/completions
+    Anthropic Endpoint: http://127.0.0.1:8765/v1/messages
+Any API key is accepted. Requests with "stream": true get server-sent events, one word at a time;
+other requests get the whole response at once, like the real APIs. Connections are kept alive between
+requests, streamed ones included.
+
+    python mock_llm_server.py [--port 8765] [--first-token-delay 1.5] [--token-delay 0.03] [--fail 0]
+                              [--stall-after 0]
+"""
+
+import argparse
+import json
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+DOCUMENTATION = """# Mock Blueprint Documentation
+
+## Overview
+This documentation was streamed by the local mock server. Each word arrives as its own event, \
+so the editor should show it growing while the progress bar keeps running.
+
+## Variables
+- **Health** — the current health of the actor. Ünïcödé text checks that multi-byte characters survive being split across reads.
+
+## Functions
+- **TakeDamage** — lowers Health and destroys the actor when it reaches zero.
+"""
+
+
+class MockLLMHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length", 0))
+        try:
+            request = json.loads(self.rfile.read(length) or b"{}")
+        except json.JSONDecodeError:
+            request = {}
+
+        if self.server.options.fail:
+            # Rate limits come with a hint of when to try again, like the real APIs
+            headers = {"retry-after": "2"} if self.server.options.fail == 429 else {}
+            self.send_json(self.server.options.fail, {"error": {"message": "Mock failure requested with --fail"}},
+                           headers)
+            return
+
+        anthropic = self.path.rstrip("/").endswith("/messages")
+        if not request.get("stream"):
+            if anthropic:
+                self.send_json(200, {"content": [{"type": "text", "text": DOCUMENTATION}]})
+            else:
+                self.send_json(200, {"choices": [{"message": {"role": "assistant", "content": DOCUMENTATION}}]})
+            return
+
+        # Chunked, so the connection can carry the next request once the stream ends
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream")
+        self.send_header("Cache-Control", "no-cache")
+        self.send_header("Transfer-Encoding", "chunked")
+        self.end_headers()
+
+        try:
+            if self.stream_response(anthropic):
+                self.send_raw(b"")
+                return
+        except (BrokenPipeError, ConnectionResetError):
+            # The editor cancelled the request
+            pass
+        self.close_connection = True
+
+    def stream_response(self, anthropic):
+        """Streams the documentation; False if the stream was left hanging with --stall-after."""
+        time.sleep(self.server.options.first_token_delay)
+        if anthropic:
+            self.send_event({"type": "message_start", "message": {"role": "assistant", "content": []}}, "message_start")
+            self.send_event({"type": "content_block_start", "index": 0, "content_block": {"type": "text", "text": ""}},
+                            "content_block_start")
+        for count, word in enumerate(words(DOCUMENTATION)):
+            if count == self.server.options.stall_after > 0:
+                # A connection that died mid-response: nothing more arrives until the client hangs up
+                self.rfile.read(1)
+                return False
+            if anthropic:
+                self.send_event({"type": "content_block_delta", "index": 0,
+                                 "delta": {"type": "text_delta", "text": word}}, "content_block_delta")
+            else:
+                self.send_event({"choices": [{"index": 0, "delta": {"content": word}}]})
+            time.sleep(self.server.options.token_delay)
+
+        if anthropic:
+            self.send_event({"type": "content_block_stop", "index": 0}, "content_block_stop")
+            self.send_event({"type": "message_stop"}, "message_stop")
+        else:
+            self.send_raw(b"data: [DONE]\n\n")
+        return True
+
+    def send_json(self, status, body, headers=None):
+        payload = json.dumps(body).encode("utf-8")
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(payload)))
+        for name, value in (headers or {}).items():
+            self.send_header(name, value)
+        self.end_headers()
+        self.wfile.write(payload)
+
+    def send_event(self, data, event=None):
+        message = f"event: {event}\n" if event else ""
+        message += f"data: {json.dumps(data, ensure_ascii=False)}\n\n"
+        self.send_raw(message.encode("utf-8"))
+
+    def send_raw(self, payload):
+        # One chunk of the streamed body; an empty one ends it
+        self.wfile.write(b"%x\r\n%s\r\n" % (len(payload), payload))
+        self.wfile.flush()
+
+
+def words(text):
+    # Keep the whitespace with the word before it, so the pieces add up to the text
+    start = 0
+    for index, char in enumerate(text):
+        if char.isspace() and index + 1 < len(text) and not text[index + 1].isspace():
+            yield text[start:index + 1]
+            start = index + 1
+    yield text[start:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--first-token-delay", type=float, default=1.5, help="seconds before the first word")
+    parser.add_argument("--token-delay", type=float, default=0.03, help="seconds between words")
+    parser.add_argument("--fail", type=int, default=0, help="answer every request with this HTTP status")
+    parser.add_argument("--stall-after", type=int, default=0,
+                        help="stop sending streamed responses after this many words, without closing them")
+    options = parser.parse_args()
+
+    server = ThreadingHTTPServer(("127.0.0.1", options.port), MockLLMHandler)
+    server.options = options
+    print(f"Mock LLM server listening on http://127.0.0.1:{options.port}")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
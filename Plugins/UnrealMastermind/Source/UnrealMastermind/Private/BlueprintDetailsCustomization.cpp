@@ -2,6 +2,7 @@
 
 #include "BlueprintDetailsCustomization.h"
 #include "BlueprintDocumentation.h"
+#include "BlueprintDocumentationTags.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailWidgetRow.h"
 #include "DetailCategoryBuilder.h"
@@ -187,6 +188,12 @@ void FBlueprintDetailsCustomization::CustomizeDetails(IDetailLayoutBuilder& Deta
                 [
                     SNew(STextBlock)
                     .Text_Lambda([this, Settings]() -> FText {
+                        // The tag holds the preview already, without parsing the documentation every frame
+                        if (FBlueprintDocumentationState State; GetRegistryState(State) && State.bDocumented)
+                        {
+                            return FText::FromString(State.Preview);
+                        }
+
                         FString DocText = GetDocumentation();
                         if (const int32 MaxChars = Settings->DocumentationPreviewChars; DocText.Len() > MaxChars)
                         {
@@ -244,6 +251,9 @@ bool FBlueprintDetailsCustomization::HasDocumentation() const
 {
     if (!SelectedBlueprint.IsValid())
         return false;
+
+    if (FBlueprintDocumentationState State; GetRegistryState(State))
+        return State.bDocumented;
     
     return UBlueprintDocumentation::HasDocumentation(SelectedBlueprint.Get());
 }
@@ -256,4 +266,15 @@ FString FBlueprintDetailsCustomization::GetDocumentation() const
     return UBlueprintDocumentation::GetDocumentation(SelectedBlueprint.Get());
 }
 
+bool FBlueprintDetailsCustomization::GetRegistryState(FBlueprintDocumentationState& OutState) const
+{
+    // Tags are written on save, so documentation generated or cleared since then is only in the package
+    if (!SelectedBlueprint.IsValid() || SelectedBlueprint->GetPackage()->IsDirty())
+        return false;
+
+    FAssetData Asset;
+    return FBlueprintDocumentationTags::FindAsset(FSoftObjectPath(SelectedBlueprint.Get()), Asset) &&
+        FBlueprintDocumentationTags::GetState(Asset, OutState);
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -2,16 +2,33 @@
 
 #include "BlueprintDocumentation.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintGraphDatabase.h"
 #include "Engine/Blueprint.h"
+#include "Hash/xxhash.h"
+#include "LLMProvider.h"
 #include "Misc/PackageName.h"
 #include "UObject/UObjectHash.h"
 #include "UObject/MetaData.h"
 #include "UObject/Package.h"
 #include "UObject/SavePackage.h"
+#include "UnrealMastermindSettings.h"
 
 const FName UBlueprintDocumentation::DocumentationMetadataKey = FName("UnrealMastermindDocumentation");
 
-bool UBlueprintDocumentation::SaveDocumentation(UBlueprint* Blueprint, const FString& Documentation)
+namespace
+{
+	// As UTF-8, so the hash is the same on every platform
+	void HashString(FXxHash64Builder& Builder, const FString& Value)
+	{
+		const FTCHARToUTF8 Utf8(*Value);
+		const int32 Len = Utf8.Length();
+		Builder.Update(&Len, sizeof(Len));
+		Builder.Update(Utf8.Get(), Len);
+	}
+}
+
+bool UBlueprintDocumentation::SaveDocumentation(UBlueprint* Blueprint, const FString& Documentation,
+                                                const FString& SourceHash)
 {
 	if (!Blueprint)
 		return false;
@@ -20,6 +37,10 @@ bool UBlueprintDocumentation::SaveDocumentation(UBlueprint* Blueprint, const FSt
 	const TSharedPtr<FJsonObject> DocObject = MakeShareable(new FJsonObject);
 	DocObject->SetStringField("documentation", Documentation);
 	DocObject->SetStringField("timestamp", FDateTime::Now().ToString());
+	if (!SourceHash.IsEmpty())
+	{
+		DocObject->SetStringField("source_hash", SourceHash);
+	}
 
 	// Convert to string
 	FString DocJson;
@@ -125,6 +146,84 @@ FString UBlueprintDocumentation::GetDocumentation(UBlueprint* Blueprint)
 	return DocJson;
 }
 
+FString UBlueprintDocumentation::GetSourceHash(const UBlueprint* Blueprint)
+{
+	FString SourceHash;
+	if (const TSharedPtr<FJsonObject> DocObject = ReadMetadata(Blueprint))
+	{
+		DocObject->TryGetStringField(TEXT("source_hash"), SourceHash);
+	}
+	return SourceHash;
+}
+
+FString UBlueprintDocumentation::ComputeSourceHash(const FBlueprintIR& Snapshot,
+                                                   const FBlueprintDocumentationSettings& Settings,
+                                                   const FString& CustomPrompt)
+{
+	FXxHash64Builder Builder;
+	const uint64 SnapshotHash = FBlueprintGraphDatabase::HashSnapshot(Snapshot);
+	Builder.Update(&SnapshotHash, sizeof(SnapshotHash));
+
+	// What the prompt says about the Blueprint
+	const uint8 Flags[] = {
+		Settings.bIncludeBasicInfo, Settings.bIncludeVariables, static_cast<uint8>(Settings.ComponentDetailLevel),
+		Settings.bTraceExecutionFlow, Settings.bIncludePinValues, Settings.bTrackVariableUsage,
+		Settings.bSummarizeUnusedVariables
+	};
+	Builder.Update(Flags, sizeof(Flags));
+	Builder.Update(&Settings.MaxExecutionFlowDepth, sizeof(Settings.MaxExecutionFlowDepth));
+	for (const FString& Prefix : Settings.IgnoredPropertyPrefixes)
+	{
+		HashString(Builder, Prefix);
+	}
+
+	// What is asked, and who answers
+	const UUnrealMastermindSettings* GeneratorSettings = GetDefault<UUnrealMastermindSettings>();
+	HashString(Builder, CustomPrompt);
+	HashString(Builder, GeneratorSettings->SystemPrompt);
+	HashString(Builder, GeneratorSettings->ProjectGlossary);
+
+	const uint8 Provider = static_cast<uint8>(GeneratorSettings->SelectedProvider);
+	Builder.Update(&Provider, sizeof(Provider));
+	if (const TSharedPtr<const ILLMProvider> ProviderImpl =
+		FLLMProviderRegistry::Get().Find(GeneratorSettings->SelectedProvider))
+	{
+		HashString(Builder, ProviderImpl->GetDefaultModel());
+	}
+
+	return FString::Printf(TEXT("%016llx"), Builder.Finalize().Hash);
+}
+
+bool UBlueprintDocumentation::FindDocumentation(const UBlueprint* Blueprint, FString& OutDocumentation,
+                                                FString& OutSourceHash)
+{
+	const TSharedPtr<FJsonObject> DocObject = ReadMetadata(Blueprint);
+	if (!DocObject.IsValid() || !DocObject->TryGetStringField(TEXT("documentation"), OutDocumentation))
+		return false;
+
+	DocObject->TryGetStringField(TEXT("source_hash"), OutSourceHash);
+	return true;
+}
+
+TSharedPtr<FJsonObject> UBlueprintDocumentation::ReadMetadata(const UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+		return nullptr;
+
+	// GetMetaData would create it
+	UMetaData* MetaData = FindObjectFast<UMetaData>(Blueprint->GetPackage(), NAME_PackageMetaData);
+	const FString DocJson = MetaData ? MetaData->GetValue(Blueprint, DocumentationMetadataKey) : FString();
+	if (DocJson.IsEmpty())
+		return nullptr;
+
+	TSharedPtr<FJsonObject> DocObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DocJson);
+	if (!FJsonSerializer::Deserialize(Reader, DocObject))
+		return nullptr;
+
+	return DocObject;
+}
+
 bool UBlueprintDocumentation::HasDocumentation(UBlueprint* Blueprint)
 {
 	if (!Blueprint)
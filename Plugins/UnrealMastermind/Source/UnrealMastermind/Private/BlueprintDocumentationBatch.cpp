@@ -0,0 +1,602 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintDocumentationBatch.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "BlueprintDocumentation.h"
+#include "BlueprintDocumentationMapReduce.h"
+#include "BlueprintDocumentationTags.h"
+#include "BlueprintGraphDatabase.h"
+#include "BlueprintIRRenderer.h"
+#include "BlueprintPromptBudget.h"
+#include "BlueprintSnapshot.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "LLMConnector.h"
+#include "PromptWriter.h"
+#include "UnrealMastermindSettings.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUnrealMastermindBatch, Log, All);
+
+namespace
+{
+	const TCHAR* GetStageName(EBlueprintDocumentationStage Stage)
+	{
+		switch (Stage)
+		{
+		case EBlueprintDocumentationStage::Load: return TEXT("Load");
+		case EBlueprintDocumentationStage::Extract: return TEXT("Extract");
+		case EBlueprintDocumentationStage::Render: return TEXT("Render");
+		case EBlueprintDocumentationStage::Request: return TEXT("Request");
+		case EBlueprintDocumentationStage::Save: return TEXT("Save");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	FString FirstLine(const FString& Text)
+	{
+		int32 NewlineIndex;
+		return Text.FindChar('\n', NewlineIndex) ? Text.Left(NewlineIndex) : Text;
+	}
+}
+
+FString FBlueprintDocumentationBatchStats::ToString() const
+{
+	const int32 NumProcessed = NumDocumented + NumUpToDate + NumStale + NumFailed;
+	FString Out = FString::Printf(
+		TEXT("%d Blueprints found, %d done before, %d documented, %d up to date, %d stale, %d failed, %d not loaded in %.1f s (%.2f Blueprints/s, %.0f prompt tokens/s)\n"),
+		NumFound, NumResumed, NumDocumented, NumUpToDate, NumStale, NumFailed, NumNotLoaded, WallSeconds,
+		WallSeconds > 0.0 ? NumProcessed / WallSeconds : 0.0,
+		WallSeconds > 0.0 ? PromptTokens / WallSeconds : 0.0);
+
+	for (int32 Index = 0; Index < static_cast<int32>(EBlueprintDocumentationStage::Num); ++Index)
+	{
+		const FStage& Stage = Stages[Index];
+
+		// Busy time over wall time is how many jobs the stage kept going at once, on average
+		Out += FString::Printf(
+			TEXT("  %-8s %6d jobs, %8.3f s average, %8.3f s longest, %5.2f of %d slots busy on average, %d at most\n"),
+			GetStageName(static_cast<EBlueprintDocumentationStage>(Index)), Stage.NumJobs,
+			Stage.NumJobs > 0 ? Stage.BusySeconds / Stage.NumJobs : 0.0, Stage.MaxSeconds,
+			WallSeconds > 0.0 ? Stage.BusySeconds / WallSeconds : 0.0, Stage.Limit, Stage.MaxInFlight);
+	}
+	return Out;
+}
+
+FBlueprintDocumentationBatch::FBlueprintDocumentationBatch(const FBlueprintDocumentationBatchOptions& InOptions)
+	: Options(InOptions)
+{
+	Options.MaxLoading = FMath::Max(Options.MaxLoading, 1);
+	Options.MaxExtracting = FMath::Max(Options.MaxExtracting, 1);
+	Options.MaxRendering = FMath::Max(Options.MaxRendering, 1);
+	Options.MaxRequests = FMath::Max(Options.MaxRequests, 1);
+	Options.MaxQueued = FMath::Max(Options.MaxQueued, Options.MaxRequests);
+	Options.NumShards = FMath::Max(Options.NumShards, 1);
+	Options.ShardIndex = FMath::Clamp(Options.ShardIndex, 0, Options.NumShards - 1);
+
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	DocSettings = Settings->MakeDocumentationSettings();
+	bSplitLargeBlueprints = Settings->bSplitLargeBlueprints;
+	MaxPartRequests = FMath::Max(Settings->MaxConcurrentRequests, 1);
+	TokenBudget = ULLMConnector::GetBlueprintInfoTokenBudget(Options.CustomPrompt);
+
+	Stats.Stages[static_cast<int32>(EBlueprintDocumentationStage::Load)].Limit = Options.MaxLoading;
+	Stats.Stages[static_cast<int32>(EBlueprintDocumentationStage::Extract)].Limit = Options.MaxExtracting;
+	Stats.Stages[static_cast<int32>(EBlueprintDocumentationStage::Render)].Limit = Options.MaxRendering;
+	Stats.Stages[static_cast<int32>(EBlueprintDocumentationStage::Request)].Limit = Options.MaxRequests;
+	Stats.Stages[static_cast<int32>(EBlueprintDocumentationStage::Save)].Limit = 1;
+}
+
+bool FBlueprintDocumentationBatch::Start()
+{
+	check(IsInGameThread());
+	StartTime = FPlatformTime::Seconds();
+
+	TMap<FName, uint64> ResumedHashes;
+	if (!OpenFiles(ResumedHashes))
+		return false;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : Options.PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(Path));
+	}
+	if (Filter.PackagePaths.IsEmpty())
+	{
+		Filter.PackagePaths.Add(TEXT("/Game"));
+	}
+
+	TArray<FAssetData> BlueprintAssets;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+	Pending.Reserve(BlueprintAssets.Num());
+	for (const FAssetData& Asset : BlueprintAssets)
+	{
+		if (FBlueprintDocumentationShard::GetShardIndex(Asset.PackageName, Options.NumShards) != Options.ShardIndex)
+			continue;
+
+		++Stats.NumFound;
+		if (ResumedHashes.Contains(Asset.PackageName))
+		{
+			++Stats.NumResumed;
+			continue;
+		}
+
+		const TSharedRef<FJob> Job = MakeShared<FJob>();
+		Job->PackageName = Asset.PackageName;
+		Job->AssetPath = Asset.GetSoftObjectPath();
+
+		// The size on disk is all that is known before loading, and grows with the Blueprint's graphs
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Asset.PackageName);
+		Job->Weight = PackageData.IsSet() ? PackageData->DiskSize : 0;
+
+		FBlueprintDocumentationState State;
+		Job->bTagged = FBlueprintDocumentationTags::GetState(Asset, State);
+		Job->SavedSourceHash = MoveTemp(State.SourceHash);
+		Pending.Add(Job);
+	}
+
+	// Popped from the back, largest first, so the longest jobs don't start last
+	Pending.Sort([](const TSharedRef<FJob>& A, const TSharedRef<FJob>& B)
+	{
+		return IsHeavier(B, A);
+	});
+	if (Options.Limit > 0 && Pending.Num() > Options.Limit)
+	{
+		Pending.RemoveAt(0, Pending.Num() - Options.Limit);
+	}
+
+	UE_LOG(LogUnrealMastermindBatch, Display, TEXT("Documenting %d of %d Blueprints (shard %d of %d, %d done before)"),
+	       Pending.Num(), Stats.NumFound, Options.ShardIndex, Options.NumShards, Stats.NumResumed);
+	return true;
+}
+
+bool FBlueprintDocumentationBatch::OpenFiles(TMap<FName, uint64>& OutResumedHashes)
+{
+	if (Options.bDryRun || Options.bListStale)
+		return true;
+
+	if (!Options.JournalFile.IsEmpty() && !Journal.Open(Options.JournalFile, Options.bResume))
+		return false;
+
+	if (Options.OutputFile.IsEmpty())
+	{
+		// The journal only says saved once SaveDocumentation has written the package
+		if (Options.bResume)
+		{
+			Journal.GetSavedHashes(OutResumedHashes);
+		}
+		return true;
+	}
+
+	// Records that never made it into the output file, say because it was cleaned up, are documented again
+	if (Options.bResume && IFileManager::Get().FileExists(*Options.OutputFile))
+	{
+		TArray<FBlueprintDocumentationRecord> Records;
+		FBlueprintDocumentationShard::Read(Options.OutputFile, Records);
+		for (const FBlueprintDocumentationRecord& Record : Records)
+		{
+			uint64 SavedHash;
+			if (Journal.GetSavedHash(Record.PackageName, SavedHash) &&
+				SavedHash == FBlueprintDocumentationJournal::HashDocumentation(Record.Documentation))
+			{
+				OutResumedHashes.Add(Record.PackageName, SavedHash);
+			}
+		}
+	}
+	return Output.Open(Options.OutputFile, Options.bResume);
+}
+
+void FBlueprintDocumentationBatch::Tick()
+{
+	check(IsInGameThread());
+
+	// Downstream first, so the slots freed this tick are filled from upstream in the same tick
+	SaveCompleted();
+
+	TSharedPtr<FJob> Job;
+	while (RenderedQueue.Dequeue(Job))
+	{
+		const TSharedRef<FJob> RenderedJob = Job.ToSharedRef();
+		LeaveStage(*RenderedJob, EBlueprintDocumentationStage::Render);
+
+		// Nothing to send for documentation that is up to date, nor when only listing what is stale
+		if (RenderedJob->bUpToDate || Options.bListStale)
+		{
+			if (RenderedJob->bUpToDate)
+			{
+				++Stats.NumUpToDate;
+			}
+			else
+			{
+				++Stats.NumStale;
+				UE_LOG(LogUnrealMastermindBatch, Display, TEXT("%s: %s"), *RenderedJob->PackageName.ToString(),
+				       RenderedJob->SavedSourceHash.IsEmpty() ? TEXT("no stamped documentation") : TEXT("stale"));
+			}
+			--NumQueued;
+			Release(*RenderedJob);
+			continue;
+		}
+
+		Stats.PromptTokens += RenderedJob->PromptTokens;
+		Rendered.HeapPush(RenderedJob, &FBlueprintDocumentationBatch::IsHeavier);
+	}
+
+	StartRequests();
+	StartRenders();
+	StartExtracts();
+	CollectGarbageWhenIdle();
+	StartLoads();
+
+	if (IsComplete())
+	{
+		Stats.WallSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+bool FBlueprintDocumentationBatch::IsComplete() const
+{
+	if (!Pending.IsEmpty() || !Loaded.IsEmpty() || !Extracted.IsEmpty() || !Rendered.IsEmpty())
+		return false;
+
+	for (const int32 Count : InFlight)
+	{
+		if (Count > 0)
+			return false;
+	}
+	return RenderedQueue.IsEmpty() && CompletedQueue.IsEmpty();
+}
+
+void FBlueprintDocumentationBatch::StartLoads()
+{
+	// Loading stops while memory is reclaimed, and whenever enough is waiting further down
+	while (!Pending.IsEmpty() && !bGarbageCollectionPending &&
+	       InFlight[static_cast<int32>(EBlueprintDocumentationStage::Load)] < Options.MaxLoading &&
+	       NumQueued + InFlight[static_cast<int32>(EBlueprintDocumentationStage::Load)] < Options.MaxQueued)
+	{
+		const TSharedRef<FJob> Job = Pending.Pop(EAllowShrinking::No);
+		if (SkipLoad(Job))
+		{
+			++Stats.NumNotLoaded;
+			continue;
+		}
+		EnterStage(*Job, EBlueprintDocumentationStage::Load);
+
+		LoadPackageAsync(Job->PackageName.ToString(), FLoadPackageAsyncDelegate::CreateSPLambda(
+			this, [this, Job](const FName&, UPackage* Package, EAsyncLoadingResult::Type Result)
+			{
+				OnPackageLoaded(Job, Result == EAsyncLoadingResult::Succeeded ? Package : nullptr);
+			}));
+	}
+}
+
+bool FBlueprintDocumentationBatch::SkipLoad(const TSharedRef<FJob>& Job)
+{
+	if (!Job->bTagged || Options.bOverwrite)
+		return false;
+
+	// Undocumented, or documented before stamps: stale whatever the Blueprint holds
+	if (Job->SavedSourceHash.IsEmpty())
+	{
+		if (!Options.bListStale)
+			return false;
+
+		++Stats.NumStale;
+		UE_LOG(LogUnrealMastermindBatch, Display, TEXT("%s: no stamped documentation"), *Job->PackageName.ToString());
+		return true;
+	}
+
+	// The stamp is compared with a hash of the stored snapshot; a stale Blueprint is loaded when it is saved
+	TSharedPtr<const FBlueprintIR> StoredSnapshot =
+		FBlueprintGraphDatabase::Get().FindFresh(Job->PackageName, DocSettings);
+	if (!StoredSnapshot.IsValid())
+		return false;
+
+	Job->Snapshot = MoveTemp(StoredSnapshot);
+	Extracted.Add(Job);
+	++NumQueued;
+	return true;
+}
+
+void FBlueprintDocumentationBatch::OnPackageLoaded(const TSharedRef<FJob>& Job, UPackage* Package)
+{
+	LeaveStage(*Job, EBlueprintDocumentationStage::Load);
+
+	UBlueprint* Blueprint = Package ? Cast<UBlueprint>(Job->AssetPath.ResolveObject()) : nullptr;
+	if (!Blueprint)
+	{
+		Fail(*Job, EBlueprintDocumentationStage::Load, TEXT("The package could not be loaded"));
+		return;
+	}
+
+	Job->Blueprint.Reset(Blueprint);
+	Job->SavedSourceHash = UBlueprintDocumentation::GetSourceHash(Blueprint);
+
+	Loaded.Add(Job);
+	++NumQueued;
+}
+
+void FBlueprintDocumentationBatch::StartExtracts()
+{
+	while (!Loaded.IsEmpty() &&
+	       InFlight[static_cast<int32>(EBlueprintDocumentationStage::Extract)] < Options.MaxExtracting)
+	{
+		const TSharedRef<FJob> Job = Loaded[0];
+		Loaded.RemoveAt(0, 1, EAllowShrinking::No);
+		EnterStage(*Job, EBlueprintDocumentationStage::Extract);
+
+		// The package was just loaded from disk, so the stored snapshot of its saved state is as good as a new one
+		if (TSharedPtr<const FBlueprintIR> StoredSnapshot =
+			FBlueprintGraphDatabase::Get().FindFresh(Job->PackageName, DocSettings))
+		{
+			OnExtracted(Job, MoveTemp(StoredSnapshot));
+			continue;
+		}
+
+		Job->Capture = MakeShared<FBlueprintSnapshotTask>(Job->Blueprint.Get(), DocSettings, Options.ExtractBudgetMs);
+		Job->Capture->Start(FBlueprintSnapshotTask::FOnComplete::CreateSPLambda(
+			this, [this, Job](TSharedPtr<const FBlueprintIR> Snapshot)
+			{
+				OnExtracted(Job, MoveTemp(Snapshot));
+			}));
+	}
+}
+
+void FBlueprintDocumentationBatch::OnExtracted(const TSharedRef<FJob>& Job, TSharedPtr<const FBlueprintIR> Snapshot)
+{
+	LeaveStage(*Job, EBlueprintDocumentationStage::Extract);
+	Job->Capture.Reset();
+
+	if (!Snapshot.IsValid() || !Snapshot->IsValid())
+	{
+		--NumQueued;
+		Release(*Job);
+		Fail(*Job, EBlueprintDocumentationStage::Extract, TEXT("The Blueprint could not be captured"));
+		return;
+	}
+
+	// Keep it for later runs and project-wide scans, like the tab does
+	const UPackage* Package = Job->Blueprint->GetPackage();
+	if (!Package->IsDirty())
+	{
+		FBlueprintGraphDatabase::Get().Store(Job->PackageName, *Snapshot, DocSettings);
+	}
+
+	// Only saving into the package needs the Blueprint again
+	if (!SavesPackages())
+	{
+		Release(*Job);
+	}
+
+	Job->Snapshot = MoveTemp(Snapshot);
+	Extracted.Add(Job);
+}
+
+void FBlueprintDocumentationBatch::StartRenders()
+{
+	while (!Extracted.IsEmpty() &&
+	       InFlight[static_cast<int32>(EBlueprintDocumentationStage::Render)] < Options.MaxRendering)
+	{
+		const TSharedRef<FJob> Job = Extracted[0];
+		Extracted.RemoveAt(0, 1, EAllowShrinking::No);
+		EnterStage(*Job, EBlueprintDocumentationStage::Render);
+
+		// Only the snapshot is read from here on; the game thread leaves the job alone until it is queued back
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+		          [WeakThis = TWeakPtr<FBlueprintDocumentationBatch>(AsShared()), Job, DocSettings = DocSettings,
+			          TokenBudget = TokenBudget, bSplitLargeBlueprints = bSplitLargeBlueprints,
+			          CustomPrompt = Options.CustomPrompt, bOverwrite = Options.bOverwrite,
+			          bListStale = Options.bListStale]()
+		{
+			// Documentation generated from the same content with the same settings would say the same
+			Job->SourceHash = UBlueprintDocumentation::ComputeSourceHash(*Job->Snapshot, DocSettings, CustomPrompt);
+			Job->bUpToDate = !bOverwrite && Job->SourceHash == Job->SavedSourceHash;
+			if (Job->bUpToDate || bListStale)
+			{
+				Job->StageEndTime = FPlatformTime::Seconds();
+				if (const TSharedPtr<FBlueprintDocumentationBatch> Batch = WeakThis.Pin())
+				{
+					Batch->RenderedQueue.Enqueue(Job);
+				}
+				return;
+			}
+
+			FPromptWriter& Writer = FPromptWriter::GetThreadLocal();
+			const FBlueprintPromptBudgetReport Report = FBlueprintPromptBudget::Render(
+				FBlueprintIRRendererRegistry::Text, *Job->Snapshot, DocSettings, TokenBudget, Writer);
+
+			// What the whole Blueprint would take decides the order of requests, not what was cut to fit
+			Job->Weight = Report.InitialTokens;
+			Job->PromptTokens = Report.FinalTokens;
+			Job->NumParts = Report.WasReduced() && bSplitLargeBlueprints
+				                ? FBlueprintDocumentationMapReduce::CountParts(*Job->Snapshot)
+				                : 1;
+
+			// Copied, not moved: the writer keeps its capacity for the next Blueprint this thread renders
+			const FUtf8StringView RenderedText = Writer.ToView();
+			Job->BlueprintInfo.Append(RenderedText.GetData(), RenderedText.Len());
+			Job->StageEndTime = FPlatformTime::Seconds();
+
+			if (const TSharedPtr<FBlueprintDocumentationBatch> Batch = WeakThis.Pin())
+			{
+				Batch->RenderedQueue.Enqueue(Job);
+			}
+		});
+	}
+}
+
+void FBlueprintDocumentationBatch::StartRequests()
+{
+	while (!Rendered.IsEmpty() &&
+	       InFlight[static_cast<int32>(EBlueprintDocumentationStage::Request)] < Options.MaxRequests)
+	{
+		TSharedRef<FJob> Job = Rendered[0];
+		Rendered.HeapPop(Job, &FBlueprintDocumentationBatch::IsHeavier, EAllowShrinking::No);
+		EnterStage(*Job, EBlueprintDocumentationStage::Request);
+		--NumQueued;
+
+		// Map-reduce renders every part before it returns, so the requests are made from a worker thread
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+		          [WeakThis = TWeakPtr<FBlueprintDocumentationBatch>(AsShared()), Job, DocSettings = DocSettings,
+			          CustomPrompt = Options.CustomPrompt, TokenBudget = TokenBudget,
+			          MaxPartRequests = MaxPartRequests]()
+		{
+			// Whoever sits at the editor goes first
+			FLLMRequestOptions RequestOptions;
+			RequestOptions.Priority = ELLMRequestPriority::Background;
+
+			TFuture<FString> Documentation;
+			if (Job->NumParts > 1)
+			{
+				Documentation = FBlueprintDocumentationMapReduce::Generate(
+					*Job->Snapshot, DocSettings, CustomPrompt, TokenBudget, MaxPartRequests,
+					[](int32, int32)
+					{
+					},
+					RequestOptions);
+			}
+			else
+			{
+				Documentation = ULLMConnector::GenerateDocumentation(
+					FUtf8StringView(Job->BlueprintInfo.GetData(), Job->BlueprintInfo.Num()), CustomPrompt,
+					RequestOptions);
+			}
+
+			Documentation.Next([WeakThis, Job](FString Result)
+			{
+				Job->Documentation = MoveTemp(Result);
+				Job->StageEndTime = FPlatformTime::Seconds();
+
+				if (const TSharedPtr<FBlueprintDocumentationBatch> Batch = WeakThis.Pin())
+				{
+					Batch->CompletedQueue.Enqueue(Job);
+				}
+			});
+		});
+	}
+}
+
+void FBlueprintDocumentationBatch::SaveCompleted()
+{
+	TSharedPtr<FJob> Job;
+	while (CompletedQueue.Dequeue(Job))
+	{
+		LeaveStage(*Job, EBlueprintDocumentationStage::Request);
+
+		// Not needed any more, and a large Blueprint's text is not small
+		Job->Snapshot.Reset();
+		Job->BlueprintInfo.Empty();
+
+		if (Job->Documentation.StartsWith(TEXT("Error:")))
+		{
+			Release(*Job);
+			Fail(*Job, EBlueprintDocumentationStage::Request, FirstLine(Job->Documentation));
+			continue;
+		}
+		Journal.Record(Job->PackageName, EBlueprintDocumentationJournalStage::Generated, Job->Documentation);
+
+		if (Options.bDryRun)
+		{
+			++Stats.NumDocumented;
+			continue;
+		}
+
+		EnterStage(*Job, EBlueprintDocumentationStage::Save);
+		bool bSaved = true;
+		if (SavesPackages())
+		{
+			// Not loaded when the registry and the graph database were enough to tell it is stale
+			if (!Job->Blueprint.IsValid())
+			{
+				Job->Blueprint.Reset(Cast<UBlueprint>(Job->AssetPath.TryLoad()));
+			}
+			bSaved = Job->Blueprint.IsValid() &&
+				UBlueprintDocumentation::SaveDocumentation(Job->Blueprint.Get(), Job->Documentation, Job->SourceHash);
+		}
+		else
+		{
+			Output.Write({Job->PackageName, Job->AssetPath, Job->Documentation, Job->SourceHash});
+		}
+		LeaveStage(*Job, EBlueprintDocumentationStage::Save);
+
+		Release(*Job);
+
+		if (!bSaved)
+		{
+			Fail(*Job, EBlueprintDocumentationStage::Save, TEXT("The package could not be saved"));
+			continue;
+		}
+
+		Journal.Record(Job->PackageName, EBlueprintDocumentationJournalStage::Saved, Job->Documentation);
+		++Stats.NumDocumented;
+	}
+}
+
+void FBlueprintDocumentationBatch::Release(FJob& Job)
+{
+	if (!Job.Blueprint.IsValid())
+		return;
+
+	// The package is unloaded by the next garbage collection
+	Job.Blueprint.Reset();
+	if (++ReleasedSinceGarbageCollection >= Options.BlueprintsPerGarbageCollection)
+	{
+		bGarbageCollectionPending = true;
+	}
+}
+
+void FBlueprintDocumentationBatch::CollectGarbageWhenIdle()
+{
+	// Packages still loading can't be collected safely, so new loads wait until these are done
+	if (!bGarbageCollectionPending || InFlight[static_cast<int32>(EBlueprintDocumentationStage::Load)] > 0)
+		return;
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	ReleasedSinceGarbageCollection = 0;
+	bGarbageCollectionPending = false;
+}
+
+bool FBlueprintDocumentationBatch::IsHeavier(const TSharedRef<FJob>& A, const TSharedRef<FJob>& B)
+{
+	return A->Weight > B->Weight;
+}
+
+void FBlueprintDocumentationBatch::EnterStage(FJob& Job, EBlueprintDocumentationStage Stage)
+{
+	const int32 Index = static_cast<int32>(Stage);
+	++InFlight[Index];
+	Stats.Stages[Index].MaxInFlight = FMath::Max(Stats.Stages[Index].MaxInFlight, InFlight[Index]);
+
+	Job.StageStartTime = FPlatformTime::Seconds();
+	Job.StageEndTime = 0.0;
+}
+
+void FBlueprintDocumentationBatch::LeaveStage(FJob& Job, EBlueprintDocumentationStage Stage)
+{
+	const int32 Index = static_cast<int32>(Stage);
+	--InFlight[Index];
+
+	const double EndTime = Job.StageEndTime > 0.0 ? Job.StageEndTime : FPlatformTime::Seconds();
+	const double Seconds = EndTime - Job.StageStartTime;
+
+	FBlueprintDocumentationBatchStats::FStage& StageStats = Stats.Stages[Index];
+	++StageStats.NumJobs;
+	StageStats.BusySeconds += Seconds;
+	StageStats.MaxSeconds = FMath::Max(StageStats.MaxSeconds, Seconds);
+}
+
+void FBlueprintDocumentationBatch::Fail(const FJob& Job, EBlueprintDocumentationStage Stage, const FString& Reason)
+{
+	++Stats.NumFailed;
+	Journal.Record(Job.PackageName, EBlueprintDocumentationJournalStage::Failed, Reason);
+	UE_LOG(LogUnrealMastermindBatch, Warning, TEXT("%s: %s failed: %s"), *Job.PackageName.ToString(),
+	       GetStageName(Stage), *Reason);
+}
@@ -0,0 +1,128 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintDocumentationCommandlet.h"
+#include "BlueprintDocumentationBatch.h"
+#include "BlueprintDocumentationJournal.h"
+#include "BlueprintDocumentationShard.h"
+#include "BlueprintDocumentationTags.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UnrealMastermindSettings.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUnrealMastermindCommandlet, Log, All);
+
+UBlueprintDocumentationCommandlet::UBlueprintDocumentationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBlueprintDocumentationCommandlet::Main(const FString& Params)
+{
+	FString MergePaths;
+	if (FParse::Value(*Params, TEXT("Merge="), MergePaths, false))
+		return Merge(MergePaths);
+	if (FParse::Param(*Params, TEXT("Merge")))
+		return Merge(FPaths::GetPath(FBlueprintDocumentationShard::GetDefaultPath(0, 1)));
+
+	FBlueprintDocumentationBatchOptions Options;
+	Options.MaxRequests = GetDefault<UUnrealMastermindSettings>()->MaxConcurrentRequests;
+
+	FString Paths;
+	if (FParse::Value(*Params, TEXT("Paths="), Paths, false))
+	{
+		Paths.ParseIntoArray(Options.PackagePaths, TEXT("+"));
+	}
+
+	if (FParse::Param(*Params, TEXT("Coverage")))
+	{
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().SearchAllAssets(true);
+		UE_LOG(LogUnrealMastermindCommandlet, Display, TEXT("%s"),
+		       *FBlueprintDocumentationTags::GetCoverage(Options.PackagePaths).ToString());
+		return 0;
+	}
+	FParse::Value(*Params, TEXT("Prompt="), Options.CustomPrompt);
+	Options.bOverwrite = FParse::Param(*Params, TEXT("Overwrite"));
+	Options.bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+	Options.bListStale = FParse::Param(*Params, TEXT("ListStale"));
+	FParse::Value(*Params, TEXT("Limit="), Options.Limit);
+	FParse::Value(*Params, TEXT("Load="), Options.MaxLoading);
+	FParse::Value(*Params, TEXT("Extract="), Options.MaxExtracting);
+	FParse::Value(*Params, TEXT("Render="), Options.MaxRendering);
+	FParse::Value(*Params, TEXT("Requests="), Options.MaxRequests);
+	FParse::Value(*Params, TEXT("Queue="), Options.MaxQueued);
+
+	// A shard leaves the packages alone; its results are merged once every shard is done
+	FParse::Value(*Params, TEXT("Shard="), Options.ShardIndex);
+	FParse::Value(*Params, TEXT("NumShards="), Options.NumShards);
+	if (!FParse::Value(*Params, TEXT("Output="), Options.OutputFile) && Options.NumShards > 1)
+	{
+		Options.OutputFile = FBlueprintDocumentationShard::GetDefaultPath(Options.ShardIndex, Options.NumShards);
+	}
+	if (Options.NumShards < 1 || Options.ShardIndex < 0 || Options.ShardIndex >= Options.NumShards)
+	{
+		UE_LOG(LogUnrealMastermindCommandlet, Error, TEXT("-Shard must be at least 0 and less than -NumShards"));
+		return 1;
+	}
+
+	// Always kept, so a run that dies can be picked up with -Resume
+	if (!FParse::Value(*Params, TEXT("Journal="), Options.JournalFile))
+	{
+		Options.JournalFile = FBlueprintDocumentationJournal::GetDefaultPath(Options.ShardIndex, Options.NumShards);
+	}
+	Options.bResume = FParse::Param(*Params, TEXT("Resume"));
+
+	const TSharedRef<FBlueprintDocumentationBatch> Batch = MakeShared<FBlueprintDocumentationBatch>(Options);
+	if (!Batch->Start())
+		return 1;
+
+	// No engine loop runs commandlets, so pump what it would: game thread tasks, tickers (HTTP and captures)
+	// and async loading
+	double LastTime = FPlatformTime::Seconds();
+	while (!Batch->IsComplete() && !IsEngineExitRequested())
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		const double Now = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTime));
+		LastTime = Now;
+
+		ProcessAsyncLoading(true, false, 0.005f);
+		Batch->Tick();
+
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	const FBlueprintDocumentationBatchStats& Stats = Batch->GetStats();
+	UE_LOG(LogUnrealMastermindCommandlet, Display, TEXT("%s"), *Stats.ToString());
+
+	if (!Options.OutputFile.IsEmpty() && !Options.bDryRun)
+	{
+		UE_LOG(LogUnrealMastermindCommandlet, Display, TEXT("Documentation written to %s"), *Options.OutputFile);
+	}
+
+	return Stats.NumFailed > 0 ? 1 : 0;
+}
+
+int32 UBlueprintDocumentationCommandlet::Merge(const FString& Paths)
+{
+	TArray<FString> PathList;
+	Paths.ParseIntoArray(PathList, TEXT("+"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumSaved = 0;
+	int32 NumFailed = 0;
+	if (!FBlueprintDocumentationShard::Merge(PathList, NumSaved, NumFailed))
+		return 1;
+
+	UE_LOG(LogUnrealMastermindCommandlet, Display, TEXT("Merged the documentation of %d Blueprints, %d failed, in %.1f s"),
+	       NumSaved, NumFailed, FPlatformTime::Seconds() - StartTime);
+	return NumFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintDocumentationJournal.h"
+#include "HAL/FileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUnrealMastermindJournal, Log, All);
+
+namespace
+{
+	const TCHAR* GetStageName(EBlueprintDocumentationJournalStage Stage)
+	{
+		switch (Stage)
+		{
+		case EBlueprintDocumentationJournalStage::Generated: return TEXT("generated");
+		case EBlueprintDocumentationJournalStage::Saved: return TEXT("saved");
+		default: return TEXT("failed");
+		}
+	}
+
+	EBlueprintDocumentationJournalStage ParseStage(const FString& Name)
+	{
+		if (Name == TEXT("generated"))
+			return EBlueprintDocumentationJournalStage::Generated;
+		if (Name == TEXT("saved"))
+			return EBlueprintDocumentationJournalStage::Saved;
+		return EBlueprintDocumentationJournalStage::Failed;
+	}
+}
+
+FBlueprintDocumentationJournal::FBlueprintDocumentationJournal() = default;
+FBlueprintDocumentationJournal::~FBlueprintDocumentationJournal() = default;
+
+FString FBlueprintDocumentationJournal::GetDefaultPath(int32 ShardIndex, int32 NumShards)
+{
+	const FString Name = NumShards > 1
+		                     ? FString::Printf(TEXT("Journal-%d-of-%d.jsonl"), ShardIndex, NumShards)
+		                     : FString(TEXT("Journal.jsonl"));
+	return FPaths::ProjectSavedDir() / TEXT("UnrealMastermind") / TEXT("Documentation") / Name;
+}
+
+bool FBlueprintDocumentationJournal::Open(const FString& Filename, bool bResume)
+{
+	Entries.Reset();
+	if (bResume && IFileManager::Get().FileExists(*Filename) && !Read(Filename))
+	{
+		UE_LOG(LogUnrealMastermindJournal, Error, TEXT("Could not read %s"), *Filename);
+		return false;
+	}
+
+	if (!File.Open(Filename, bResume))
+	{
+		UE_LOG(LogUnrealMastermindJournal, Error, TEXT("Could not open %s"), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogUnrealMastermindJournal, Display, TEXT("Journal %s: %d Blueprints from an earlier run"), *Filename,
+	       Entries.Num());
+	return true;
+}
+
+bool FBlueprintDocumentationJournal::Read(const FString& Filename)
+{
+	return FLLMJsonLinesFile::Read(Filename, [this](FUtf8StringView Line)
+	{
+		FName PackageName;
+		FEntry Entry;
+		const bool bValid = FLLMJsonScanner::Scan(
+			Line, [&PackageName, &Entry](const FLLMJsonScanner::FPath& Path, const FLLMJsonScanner::FValue& Value)
+			{
+				if (Path.Matches("package"))
+				{
+					PackageName = FName(Value.GetString());
+				}
+				else if (Path.Matches("stage"))
+				{
+					Entry.Stage = ParseStage(Value.GetString());
+				}
+				else if (Path.Matches("hash"))
+				{
+					Entry.ResultHash = FParse::HexNumber64(*Value.GetString());
+				}
+			});
+
+		if (bValid && !PackageName.IsNone())
+		{
+			Entries.Add(PackageName, Entry);
+		}
+	});
+}
+
+bool FBlueprintDocumentationJournal::GetSavedHash(FName PackageName, uint64& OutHash) const
+{
+	const FEntry* Entry = Entries.Find(PackageName);
+	if (!Entry || Entry->Stage != EBlueprintDocumentationJournalStage::Saved)
+		return false;
+
+	OutHash = Entry->ResultHash;
+	return true;
+}
+
+void FBlueprintDocumentationJournal::GetSavedHashes(TMap<FName, uint64>& OutHashes) const
+{
+	for (const TPair<FName, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.Stage == EBlueprintDocumentationJournalStage::Saved)
+		{
+			OutHashes.Add(Pair.Key, Pair.Value.ResultHash);
+		}
+	}
+}
+
+void FBlueprintDocumentationJournal::Record(FName PackageName, EBlueprintDocumentationJournalStage Stage,
+                                            const FString& Documentation)
+{
+	FEntry& Entry = Entries.Add(PackageName);
+	Entry.Stage = Stage;
+	Entry.ResultHash = Stage != EBlueprintDocumentationJournalStage::Failed ? HashDocumentation(Documentation) : 0;
+
+	if (!File.IsOpen())
+		return;
+
+	FLLMJsonWriter Json(256);
+	Json.BeginObject();
+	Json.Key("package").String(PackageName.ToString());
+	Json.Key("stage").String(GetStageName(Stage));
+	Json.Key("hash").String(FString::Printf(TEXT("%016llx"), Entry.ResultHash));
+	Json.Key("time").String(FDateTime::UtcNow().ToIso8601());
+	Json.EndObject();
+
+	// On disk before the run goes on, so a crash loses at most the entry being written
+	File.Write(Json);
+}
+
+uint64 FBlueprintDocumentationJournal::HashDocumentation(const FString& Documentation)
+{
+	const FTCHARToUTF8 Utf8(*Documentation);
+	return FXxHash64::HashBuffer(Utf8.Get(), Utf8.Length()).Hash;
+}
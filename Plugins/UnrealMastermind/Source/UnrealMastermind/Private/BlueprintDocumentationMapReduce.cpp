@@ -0,0 +1,229 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintDocumentationMapReduce.h"
+#include "BlueprintIRRenderer.h"
+#include "BlueprintPromptBudget.h"
+#include "LLMConnector.h"
+#include "Misc/ScopeLock.h"
+
+int32 FBlueprintDocumentationMapReduce::CountParts(const FBlueprintIR& IR)
+{
+	return CollectParts(IR).Num();
+}
+
+TArray<FBlueprintDocumentationMapReduce::FPart> FBlueprintDocumentationMapReduce::CollectParts(const FBlueprintIR& IR)
+{
+	TArray<FPart> Parts;
+	for (int32 GraphIndex = 0; GraphIndex < IR.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintIRGraph& Graph = IR.Graphs[GraphIndex];
+		if (Graph.Kind == EBlueprintIRGraphKind::EventGraph)
+		{
+			// One part per event; events of the same graph rarely depend on each other's details
+			for (const int32 EntryIndex : Graph.EntryNodes)
+			{
+				if (Graph.Nodes[EntryIndex].Kind == EBlueprintIRNodeKind::Event)
+				{
+					Parts.Add({GraphIndex, EntryIndex, FString::Printf(TEXT("Event %s (%s)"),
+						*Graph.Nodes[EntryIndex].FullTitle, *Graph.Name)});
+				}
+			}
+		}
+		else if (Graph.Kind == EBlueprintIRGraphKind::Function)
+		{
+			Parts.Add({GraphIndex, INDEX_NONE, FString::Printf(TEXT("Function %s"), *Graph.Name)});
+		}
+	}
+	return Parts;
+}
+
+FBlueprintIR FBlueprintDocumentationMapReduce::MakePartIR(const FBlueprintIR& IR, const FPart& Part)
+{
+	FBlueprintIR PartIR;
+	PartIR.BlueprintName = IR.BlueprintName;
+	PartIR.ParentClassName = IR.ParentClassName;
+	PartIR.CapturedDetailLevel = IR.CapturedDetailLevel;
+
+	// Comments go into the outline once instead of into every part
+	FBlueprintIRGraph& Graph = PartIR.Graphs.Add_GetRef(IR.Graphs[Part.Graph]);
+	Graph.Comments.Empty();
+	if (Part.EntryNode != INDEX_NONE)
+	{
+		Graph.EntryNodes = {Part.EntryNode};
+	}
+	return PartIR;
+}
+
+FBlueprintIR FBlueprintDocumentationMapReduce::MakeOutlineIR(const FBlueprintIR& IR)
+{
+	// Everything but the node graphs, which the parts already cover
+	FBlueprintIR OutlineIR;
+	OutlineIR.BlueprintName = IR.BlueprintName;
+	OutlineIR.ParentClassName = IR.ParentClassName;
+	OutlineIR.CapturedDetailLevel = IR.CapturedDetailLevel;
+	OutlineIR.Variables = IR.Variables;
+	OutlineIR.VariableUsages = IR.VariableUsages;
+	OutlineIR.Components = IR.Components;
+	OutlineIR.Properties = IR.Properties;
+
+	OutlineIR.Graphs.Reserve(IR.Graphs.Num());
+	for (const FBlueprintIRGraph& Graph : IR.Graphs)
+	{
+		FBlueprintIRGraph& GraphIR = OutlineIR.Graphs.AddDefaulted_GetRef();
+		GraphIR.Name = Graph.Name;
+		GraphIR.Kind = Graph.Kind;
+		GraphIR.ContentHash = Graph.ContentHash;
+		GraphIR.Comments = Graph.Comments;
+	}
+	return OutlineIR;
+}
+
+// State shared by the requests of one Generate call; each finished part starts the next one
+struct FBlueprintDocumentationMapReduce::FRun
+{
+	FString BlueprintName;
+	FString CustomPrompt;
+	FLLMPrompt Outline;
+	TArray<FPart> Parts;
+	TArray<FLLMPrompt> PartPrompts;
+	TArray<FString> PartResults;
+	FOnPartComplete OnPartComplete;
+	FLLMRequestOptions Options;
+	TPromise<FString> Promise;
+
+	FCriticalSection Lock;
+	int32 NextPart = 0;
+	int32 NumInFlight = 0;
+	int32 NumComplete = 0;
+	int32 FailedPart = INDEX_NONE;
+};
+
+TFuture<FString> FBlueprintDocumentationMapReduce::Generate(const FBlueprintIR& IR,
+                                                            const FBlueprintDocumentationSettings& Settings,
+                                                            const FString& CustomPrompt, int32 TokenBudget,
+                                                            int32 MaxConcurrentRequests,
+                                                            const FOnPartComplete& OnPartComplete,
+                                                            const FLLMRequestOptions& Options)
+{
+	const TSharedRef<FRun> Run = MakeShared<FRun>();
+	Run->BlueprintName = IR.BlueprintName;
+	Run->CustomPrompt = CustomPrompt;
+	Run->Parts = CollectParts(IR);
+	Run->PartResults.SetNum(Run->Parts.Num());
+	Run->OnPartComplete = OnPartComplete;
+	Run->Options = Options;
+
+	// Variables go into the outline once instead of into every part
+	FBlueprintDocumentationSettings PartSettings = Settings;
+	PartSettings.bIncludeVariables = false;
+
+	// Render everything up front, so completions only have to send requests
+	FPromptWriter& Writer = FPromptWriter::GetThreadLocal();
+	Run->PartPrompts.Reserve(Run->Parts.Num());
+	for (const FPart& Part : Run->Parts)
+	{
+		FBlueprintPromptBudget::Render(FBlueprintIRRendererRegistry::Text, MakePartIR(IR, Part), PartSettings,
+		                               TokenBudget, Writer);
+		Run->PartPrompts.Emplace(Writer.ToView());
+	}
+	FBlueprintPromptBudget::Render(FBlueprintIRRendererRegistry::Text, MakeOutlineIR(IR), Settings, TokenBudget, Writer);
+	Run->Outline = FLLMPrompt(Writer.ToView());
+
+	TFuture<FString> Documentation = Run->Promise.GetFuture();
+	if (Run->Parts.IsEmpty())
+	{
+		Combine(Run);
+		return Documentation;
+	}
+
+	TArray<int32, TInlineAllocator<16>> PartsToStart;
+	{
+		FScopeLock ScopeLock(&Run->Lock);
+		const int32 NumRequests = FMath::Clamp(MaxConcurrentRequests, 1, Run->Parts.Num());
+		for (; Run->NextPart < NumRequests; ++Run->NextPart)
+		{
+			PartsToStart.Add(Run->NextPart);
+		}
+		Run->NumInFlight = PartsToStart.Num();
+	}
+	for (const int32 PartIndex : PartsToStart)
+	{
+		StartPart(Run, PartIndex);
+	}
+
+	return Documentation;
+}
+
+void FBlueprintDocumentationMapReduce::StartPart(const TSharedRef<FRun>& Run, int32 PartIndex)
+{
+	FLLMRequestOptions PartOptions = Run->Options;
+	PartOptions.OnTextReceived = nullptr;
+
+	ULLMConnector::GenerateDocumentationPart(Run->BlueprintName, Run->Parts[PartIndex].Name,
+	                                         Run->PartPrompts[PartIndex].GetView(), Run->CustomPrompt, PartOptions)
+		.Next([Run, PartIndex](FString PartDocumentation)
+		{
+			int32 NextPartIndex = INDEX_NONE;
+			int32 NumComplete = 0;
+			bool bFinished = false;
+			{
+				FScopeLock ScopeLock(&Run->Lock);
+				Run->PartResults[PartIndex] = MoveTemp(PartDocumentation);
+				NumComplete = ++Run->NumComplete;
+
+				// After a failure, let the parts in flight finish but don't start any more
+				if (Run->FailedPart == INDEX_NONE && Run->PartResults[PartIndex].StartsWith(TEXT("Error:")))
+				{
+					Run->FailedPart = PartIndex;
+				}
+
+				if (Run->FailedPart == INDEX_NONE && Run->NextPart < Run->Parts.Num())
+				{
+					NextPartIndex = Run->NextPart++;
+				}
+				else
+				{
+					bFinished = --Run->NumInFlight == 0;
+				}
+			}
+
+			if (Run->OnPartComplete)
+			{
+				Run->OnPartComplete(NumComplete, Run->Parts.Num());
+			}
+
+			if (NextPartIndex != INDEX_NONE)
+			{
+				StartPart(Run, NextPartIndex);
+			}
+			else if (bFinished)
+			{
+				Combine(Run);
+			}
+		});
+}
+
+void FBlueprintDocumentationMapReduce::Combine(const TSharedRef<FRun>& Run)
+{
+	// A missing part would make the combined documentation silently incomplete
+	if (Run->FailedPart != INDEX_NONE)
+	{
+		Run->Promise.SetValue(FString::Printf(TEXT("%s\n(while documenting %s)"),
+		                                      *Run->PartResults[Run->FailedPart], *Run->Parts[Run->FailedPart].Name));
+		return;
+	}
+
+	TArray<FString> PartDocumentation;
+	PartDocumentation.Reserve(Run->Parts.Num());
+	for (int32 PartIndex = 0; PartIndex < Run->Parts.Num(); ++PartIndex)
+	{
+		PartDocumentation.Add(FString::Printf(TEXT("## %s\n\n%s"), *Run->Parts[PartIndex].Name,
+		                                      *Run->PartResults[PartIndex]));
+	}
+
+	ULLMConnector::CombineDocumentationParts(Run->Outline.GetView(), PartDocumentation, Run->CustomPrompt, Run->Options)
+		.Next([Run](FString Documentation)
+		{
+			Run->Promise.SetValue(MoveTemp(Documentation));
+		});
+}
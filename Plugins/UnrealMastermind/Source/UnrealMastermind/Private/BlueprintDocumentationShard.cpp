@@ -0,0 +1,162 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintDocumentationShard.h"
+#include "BlueprintDocumentation.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUnrealMastermindShard, Log, All);
+
+namespace
+{
+	// Packages loaded by a merge before garbage is collected to unload them
+	constexpr int32 PackagesPerGarbageCollection = 64;
+}
+
+int32 FBlueprintDocumentationShard::GetShardIndex(FName PackageName, int32 NumShards)
+{
+	if (NumShards <= 1)
+		return 0;
+
+	// Package names compare without case, and TCHAR differs in size between platforms, so hash lowercase UTF-8
+	const FTCHARToUTF8 Utf8(*PackageName.ToString().ToLower());
+	const uint64 Hash = FXxHash64::HashBuffer(Utf8.Get(), Utf8.Length()).Hash;
+	return static_cast<int32>(Hash % static_cast<uint64>(NumShards));
+}
+
+FString FBlueprintDocumentationShard::GetDefaultPath(int32 ShardIndex, int32 NumShards)
+{
+	return FPaths::ProjectSavedDir() / TEXT("UnrealMastermind") / TEXT("Documentation") /
+		FString::Printf(TEXT("Shard-%d-of-%d.jsonl"), ShardIndex, NumShards);
+}
+
+bool FBlueprintDocumentationShard::Open(const FString& Filename, bool bAppend)
+{
+	if (!File.Open(Filename, bAppend))
+	{
+		UE_LOG(LogUnrealMastermindShard, Error, TEXT("Could not create %s"), *Filename);
+		return false;
+	}
+	return true;
+}
+
+void FBlueprintDocumentationShard::Write(const FBlueprintDocumentationRecord& Record)
+{
+	if (!File.IsOpen())
+		return;
+
+	FLLMJsonWriter Json(Record.Documentation.Len() + 256);
+	Json.BeginObject();
+	Json.Key("package").String(Record.PackageName.ToString());
+	Json.Key("asset").String(Record.AssetPath.ToString());
+	Json.Key("documentation").String(Record.Documentation);
+	Json.Key("source_hash").String(Record.SourceHash);
+	Json.EndObject();
+	File.Write(Json);
+}
+
+bool FBlueprintDocumentationShard::Read(const FString& Filename, TArray<FBlueprintDocumentationRecord>& OutRecords)
+{
+	return FLLMJsonLinesFile::Read(Filename, [&OutRecords](FUtf8StringView Line)
+	{
+		FBlueprintDocumentationRecord Record;
+		const bool bValid = FLLMJsonScanner::Scan(
+			Line, [&Record](const FLLMJsonScanner::FPath& Path, const FLLMJsonScanner::FValue& Value)
+			{
+				if (Path.Matches("package"))
+				{
+					Record.PackageName = FName(Value.GetString());
+				}
+				else if (Path.Matches("asset"))
+				{
+					Record.AssetPath = FSoftObjectPath(Value.GetString());
+				}
+				else if (Path.Matches("documentation"))
+				{
+					Value.AppendString(Record.Documentation);
+				}
+				else if (Path.Matches("source_hash"))
+				{
+					Record.SourceHash = Value.GetString();
+				}
+			});
+
+		if (bValid && !Record.PackageName.IsNone() && Record.AssetPath.IsValid())
+		{
+			OutRecords.Add(MoveTemp(Record));
+		}
+	});
+}
+
+bool FBlueprintDocumentationShard::Merge(const TArray<FString>& Paths, int32& OutNumSaved, int32& OutNumFailed)
+{
+	OutNumSaved = 0;
+	OutNumFailed = 0;
+
+	TArray<FString> Filenames;
+	for (const FString& Path : Paths)
+	{
+		if (IFileManager::Get().DirectoryExists(*Path))
+		{
+			TArray<FString> Found;
+			IFileManager::Get().FindFiles(Found, *(Path / TEXT("*.jsonl")), true, false);
+			Found.Sort();
+			for (const FString& Name : Found)
+			{
+				Filenames.Add(Path / Name);
+			}
+		}
+		else
+		{
+			Filenames.Add(Path);
+		}
+	}
+
+	// A package that shows up in several files, from a shard that was run twice, is saved once
+	TMap<FName, FBlueprintDocumentationRecord> Records;
+	for (const FString& Filename : Filenames)
+	{
+		TArray<FBlueprintDocumentationRecord> FileRecords;
+		if (!Read(Filename, FileRecords))
+		{
+			UE_LOG(LogUnrealMastermindShard, Error, TEXT("Could not read %s"), *Filename);
+			return false;
+		}
+
+		UE_LOG(LogUnrealMastermindShard, Display, TEXT("%s: %d Blueprints"), *Filename, FileRecords.Num());
+		for (FBlueprintDocumentationRecord& Record : FileRecords)
+		{
+			const FName PackageName = Record.PackageName;
+			Records.Add(PackageName, MoveTemp(Record));
+		}
+	}
+
+	Records.KeySort(FNameLexicalLess());
+
+	int32 NumLoaded = 0;
+	for (const TPair<FName, FBlueprintDocumentationRecord>& Pair : Records)
+	{
+		const FBlueprintDocumentationRecord& Record = Pair.Value;
+
+		UBlueprint* Blueprint = Cast<UBlueprint>(Record.AssetPath.TryLoad());
+		if (Blueprint && UBlueprintDocumentation::SaveDocumentation(Blueprint, Record.Documentation, Record.SourceHash))
+		{
+			++OutNumSaved;
+		}
+		else
+		{
+			++OutNumFailed;
+			UE_LOG(LogUnrealMastermindShard, Warning, TEXT("%s: the documentation could not be saved"),
+			       *Record.PackageName.ToString());
+		}
+
+		if (++NumLoaded % PackagesPerGarbageCollection == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+	return true;
+}
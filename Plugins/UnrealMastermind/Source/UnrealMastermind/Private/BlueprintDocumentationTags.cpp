@@ -0,0 +1,169 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintDocumentationTags.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintDocumentation.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "UnrealMastermindSettings.h"
+#include "UObject/AssetRegistryTagsContext.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUnrealMastermindTags, Log, All);
+
+const FName FBlueprintDocumentationTags::DocumentedTag = FName("UnrealMastermindDocumented");
+const FName FBlueprintDocumentationTags::SourceHashTag = FName("UnrealMastermindSourceHash");
+const FName FBlueprintDocumentationTags::LengthTag = FName("UnrealMastermindDocumentationLength");
+const FName FBlueprintDocumentationTags::PreviewTag = FName("UnrealMastermindDocumentationPreview");
+
+FDelegateHandle FBlueprintDocumentationTags::TagsHandle;
+
+namespace
+{
+	// Whitespace runs, line breaks included, become one space so the preview fits a tooltip line
+	FString MakePreview(const FString& Documentation, int32 MaxChars)
+	{
+		FString Preview;
+		Preview.Reserve(FMath::Min(Documentation.Len(), MaxChars) + 3);
+
+		bool bSpace = false;
+		for (const TCHAR Char : Documentation)
+		{
+			if (Preview.Len() >= MaxChars)
+			{
+				Preview += TEXT("...");
+				break;
+			}
+
+			if (FChar::IsWhitespace(Char))
+			{
+				bSpace = !Preview.IsEmpty();
+				continue;
+			}
+			if (bSpace)
+			{
+				Preview += TEXT(' ');
+				bSpace = false;
+			}
+			Preview += Char;
+		}
+		return Preview;
+	}
+
+	void LogCoverage(const TArray<FString>& Args)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const FBlueprintDocumentationCoverage Coverage = FBlueprintDocumentationTags::GetCoverage(Args);
+		UE_LOG(LogUnrealMastermindTags, Display, TEXT("%s in %.1f ms"), *Coverage.ToString(),
+		       (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+
+	FAutoConsoleCommand CoverageCommand(
+		TEXT("UnrealMastermind.Coverage"),
+		TEXT("Counts the documented Blueprints from the asset registry, without loading any. "
+			"Usage: UnrealMastermind.Coverage [/Game/Path ...]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&LogCoverage));
+}
+
+FString FBlueprintDocumentationCoverage::ToString() const
+{
+	return FString::Printf(TEXT("%d of %d Blueprints documented (%.1f%%), %d with a source hash, %d unknown until resaved"),
+	                       NumDocumented, NumBlueprints,
+	                       NumBlueprints > 0 ? 100.0 * NumDocumented / NumBlueprints : 0.0, NumStamped, NumUnknown);
+}
+
+void FBlueprintDocumentationTags::Register()
+{
+	TagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(
+		&FBlueprintDocumentationTags::AddTags);
+}
+
+void FBlueprintDocumentationTags::Unregister()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(TagsHandle);
+	TagsHandle.Reset();
+}
+
+void FBlueprintDocumentationTags::AddTags(FAssetRegistryTagsContext Context)
+{
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Context.GetObject());
+	if (!Blueprint)
+		return;
+
+	// Also written for undocumented Blueprints, which tells them apart from ones saved before these tags
+	FString Documentation;
+	FString SourceHash;
+	const bool bDocumented = UBlueprintDocumentation::FindDocumentation(Blueprint, Documentation, SourceHash);
+	Context.AddTag(UObject::FAssetRegistryTag(DocumentedTag, bDocumented ? TEXT("True") : TEXT("False"),
+	                                          UObject::FAssetRegistryTag::TT_Alphabetical));
+	if (!bDocumented)
+		return;
+
+	const int32 PreviewChars = GetDefault<UUnrealMastermindSettings>()->DocumentationPreviewChars;
+	Context.AddTag(UObject::FAssetRegistryTag(SourceHashTag, SourceHash, UObject::FAssetRegistryTag::TT_Hidden));
+	Context.AddTag(UObject::FAssetRegistryTag(LengthTag, LexToString(Documentation.Len()),
+	                                          UObject::FAssetRegistryTag::TT_Numerical));
+	Context.AddTag(UObject::FAssetRegistryTag(PreviewTag, MakePreview(Documentation, PreviewChars),
+	                                          UObject::FAssetRegistryTag::TT_Alphabetical));
+}
+
+bool FBlueprintDocumentationTags::GetState(const FAssetData& Asset, FBlueprintDocumentationState& OutState)
+{
+	FString Documented;
+	if (!Asset.GetTagValue(DocumentedTag, Documented))
+		return false;
+
+	OutState = FBlueprintDocumentationState();
+	OutState.bDocumented = Documented == TEXT("True");
+	if (OutState.bDocumented)
+	{
+		Asset.GetTagValue(SourceHashTag, OutState.SourceHash);
+		Asset.GetTagValue(LengthTag, OutState.Length);
+		Asset.GetTagValue(PreviewTag, OutState.Preview);
+	}
+	return true;
+}
+
+bool FBlueprintDocumentationTags::FindAsset(const FSoftObjectPath& AssetPath, FAssetData& OutAsset)
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	OutAsset = AssetRegistry.GetAssetByObjectPath(AssetPath);
+	return OutAsset.IsValid();
+}
+
+FBlueprintDocumentationCoverage FBlueprintDocumentationTags::GetCoverage(const TArray<FString>& PackagePaths)
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(Path));
+	}
+	if (Filter.PackagePaths.IsEmpty())
+	{
+		Filter.PackagePaths.Add(TEXT("/Game"));
+	}
+
+	TArray<FAssetData> BlueprintAssets;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+	FBlueprintDocumentationCoverage Coverage;
+	Coverage.NumBlueprints = BlueprintAssets.Num();
+	for (const FAssetData& Asset : BlueprintAssets)
+	{
+		FBlueprintDocumentationState State;
+		if (!GetState(Asset, State))
+		{
+			++Coverage.NumUnknown;
+		}
+		else if (State.bDocumented)
+		{
+			++Coverage.NumDocumented;
+			Coverage.NumStamped += State.SourceHash.IsEmpty() ? 0 : 1;
+		}
+	}
+	return Coverage;
+}
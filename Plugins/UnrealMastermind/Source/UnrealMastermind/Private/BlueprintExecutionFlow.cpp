@@ -0,0 +1,33 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintExecutionFlow.h"
+
+FBlueprintExecutionFlowWalker::FBlueprintExecutionFlowWalker(const FBlueprintIRGraph& InGraph)
+	: Graph(InGraph)
+	, Visited(false, InGraph.Nodes.Num())
+{
+	IncomingExecLinks.SetNumZeroed(Graph.Nodes.Num());
+	for (const FBlueprintIREdge& Edge : Graph.Edges)
+	{
+		const FBlueprintIRPin& FromPin = Graph.Pins[Edge.FromPin];
+		if (FromPin.bIsExec && !FromPin.bIsInput)
+		{
+			++IncomingExecLinks[Graph.Pins[Edge.ToPin].Node];
+		}
+	}
+}
+
+void FBlueprintExecutionFlowWalker::GetExecOutputs(int32 NodeIndex, TArray<int32, TInlineAllocator<4>>& OutPins) const
+{
+	OutPins.Reset();
+
+	const FBlueprintIRNode& Node = Graph.Nodes[NodeIndex];
+	for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+	{
+		const FBlueprintIRPin& Pin = Graph.Pins[PinIndex];
+		if (Pin.bIsExec && !Pin.bIsInput)
+		{
+			OutPins.Add(PinIndex);
+		}
+	}
+}
@@ -0,0 +1,152 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintGraphCache.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphNode_Comment.h"
+#include "Hash/xxhash.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Composite.h"
+#include "K2Node_Event.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Variable.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	void HashString(FXxHash64Builder& Builder, const FString& Value)
+	{
+		const int32 Len = Value.Len();
+		Builder.Update(&Len, sizeof(Len));
+		Builder.Update(*Value, Len * sizeof(TCHAR));
+	}
+
+	// By string rather than by name index, so the hash is the same in every editor session
+	void HashName(FXxHash64Builder& Builder, FName Value)
+	{
+		TCHAR NameBuffer[NAME_SIZE];
+		const int32 Len = Value.ToString(NameBuffer);
+		Builder.Update(&Len, sizeof(Len));
+		Builder.Update(NameBuffer, Len * sizeof(TCHAR));
+	}
+
+	void HashMemberReference(FXxHash64Builder& Builder, const FMemberReference& Reference)
+	{
+		HashName(Builder, Reference.GetMemberName());
+		const FGuid MemberGuid = Reference.GetMemberGuid();
+		Builder.Update(&MemberGuid, sizeof(FGuid));
+		if (const UClass* ParentClass = Reference.GetMemberParentClass())
+		{
+			HashName(Builder, ParentClass->GetFName());
+		}
+	}
+
+	// What a node's title is made from, for the nodes that name another member or graph
+	void HashTitleSource(FXxHash64Builder& Builder, const UEdGraphNode* Node)
+	{
+		if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			HashMemberReference(Builder, CallNode->FunctionReference);
+		}
+		else if (const UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node))
+		{
+			HashMemberReference(Builder, VariableNode->VariableReference);
+		}
+		else if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		{
+			HashMemberReference(Builder, EventNode->EventReference);
+			HashName(Builder, EventNode->CustomFunctionName);
+		}
+		else if (const UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
+		{
+			const UEdGraph* MacroGraph = MacroNode->GetMacroGraph();
+			HashName(Builder, MacroGraph ? MacroGraph->GetFName() : NAME_None);
+		}
+		else if (const UK2Node_Composite* CompositeNode = Cast<UK2Node_Composite>(Node))
+		{
+			HashName(Builder, CompositeNode->BoundGraph ? CompositeNode->BoundGraph->GetFName() : NAME_None);
+		}
+	}
+}
+
+uint64 FBlueprintGraphHash::Compute(const UEdGraph* Graph)
+{
+	FXxHash64Builder Builder;
+	HashName(Builder, Graph->GetFName());
+
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node)
+			continue;
+
+		Builder.Update(&Node->NodeGuid, sizeof(FGuid));
+		HashName(Builder, Node->GetClass()->GetFName());
+
+		if (const UEdGraphNode_Comment* CommentNode = Cast<UEdGraphNode_Comment>(Node))
+		{
+			HashString(Builder, CommentNode->NodeComment);
+			continue;
+		}
+		HashTitleSource(Builder, Node);
+
+		const int32 NumPins = Node->Pins.Num();
+		Builder.Update(&NumPins, sizeof(NumPins));
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			Builder.Update(&Pin->PinId, sizeof(FGuid));
+			HashName(Builder, Pin->PinName);
+			HashName(Builder, Pin->PinType.PinCategory);
+			Builder.Update(&Pin->Direction, sizeof(Pin->Direction));
+			HashString(Builder, Pin->DefaultValue);
+
+			// Titles such as "SpawnActor BP_Enemy" or "Create W_Hud Widget" come from the class on a pin
+			HashString(Builder, Pin->DefaultObject ? Pin->DefaultObject->GetPathName() : FString());
+			HashString(Builder, Pin->DefaultTextValue.ToString());
+
+			const int32 NumLinks = Pin->LinkedTo.Num();
+			Builder.Update(&NumLinks, sizeof(NumLinks));
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				Builder.Update(&LinkedPin->PinId, sizeof(FGuid));
+			}
+		}
+	}
+
+	return Builder.Finalize().Hash;
+}
+
+FBlueprintIRGraphCache& FBlueprintIRGraphCache::Get()
+{
+	static FBlueprintIRGraphCache Cache;
+	return Cache;
+}
+
+TSharedPtr<const FBlueprintIRGraph> FBlueprintIRGraphCache::Find(const UEdGraph* Graph, uint64 Hash,
+                                                                 EBlueprintIRGraphKind Kind)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FEntry* Entry = Entries.Find(FObjectKey(Graph));
+	if (Entry && Entry->Hash == Hash && Entry->Graph->Kind == Kind)
+	{
+		return Entry->Graph;
+	}
+	return nullptr;
+}
+
+void FBlueprintIRGraphCache::Add(const UEdGraph* Graph, const FBlueprintIRGraph& GraphIR)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (Entries.Num() >= MaxEntries)
+	{
+		Entries.Reset();
+	}
+	Entries.Add(FObjectKey(Graph), FEntry{GraphIR.ContentHash, MakeShared<const FBlueprintIRGraph>(GraphIR)});
+}
+
+void FBlueprintIRGraphCache::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Reset();
+}
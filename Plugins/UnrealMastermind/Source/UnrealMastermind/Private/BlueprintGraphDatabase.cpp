@@ -0,0 +1,409 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintGraphDatabase.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintSnapshot.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UnrealMastermindSettings.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr uint32 DatabaseMagic = 0x44474D55; // "UMGD"
+	constexpr uint32 DatabaseVersion = 1;
+
+	// Wait for a burst of saves (e.g. Save All) to settle before rewriting the file
+	constexpr double FlushDelaySeconds = 2.0;
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIRPin& Pin)
+	{
+		return Ar << Pin.Name << Pin.Category << Pin.DefaultValue << Pin.Node << Pin.FirstEdge << Pin.NumEdges
+			<< Pin.bIsInput << Pin.bIsExec;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIREdge& Edge)
+	{
+		return Ar << Edge.FromPin << Edge.ToPin;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIRNode& Node)
+	{
+		return Ar << Node.Guid << Node.Title << Node.FullTitle << Node.VariableName << Node.Kind << Node.FirstPin
+			<< Node.NumPins;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIRGraph& Graph)
+	{
+		return Ar << Graph.Name << Graph.Kind << Graph.ContentHash << Graph.Nodes << Graph.Pins << Graph.Edges
+			<< Graph.Comments << Graph.EntryNodes;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIRVariableUsage& Usage)
+	{
+		return Ar << Usage.Graph << Usage.Node << Usage.bIsWrite << Usage.ExecContext;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIRVariable& Variable)
+	{
+		return Ar << Variable.Name << Variable.Category << Variable.FirstUsage << Variable.NumUsages;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIRProperty& Property)
+	{
+		return Ar << Property.Name << Property.Value;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIRComponent& Component)
+	{
+		return Ar << Component.Name << Component.ClassName << Component.FirstImportantProperty
+			<< Component.NumImportantProperties << Component.FirstProperty << Component.NumProperties;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FBlueprintIR& IR)
+	{
+		uint8 DetailLevel = static_cast<uint8>(IR.CapturedDetailLevel);
+		Ar << IR.BlueprintName << IR.ParentClassName << IR.Graphs << IR.Variables << IR.VariableUsages
+			<< IR.Components << IR.Properties << DetailLevel;
+		IR.CapturedDetailLevel = static_cast<FBlueprintDocumentationSettings::EComponentDetailLevel>(DetailLevel);
+		return Ar;
+	}
+}
+
+FBlueprintGraphDatabase& FBlueprintGraphDatabase::Get()
+{
+	static FBlueprintGraphDatabase Database;
+	return Database;
+}
+
+void FBlueprintGraphDatabase::Initialize()
+{
+	MapFile();
+
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(
+		this, &FBlueprintGraphDatabase::OnPackageSaved);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FBlueprintGraphDatabase::Tick), 0.5f);
+}
+
+void FBlueprintGraphDatabase::Shutdown()
+{
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	ActiveCapture.Reset();
+	SavedPackages.Reset();
+
+	Flush();
+	UnmapFile();
+}
+
+FString FBlueprintGraphDatabase::GetDatabasePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("UnrealMastermind") / TEXT("BlueprintGraphs.umdb");
+}
+
+uint32 FBlueprintGraphDatabase::HashCaptureSettings(const FBlueprintDocumentationSettings& Settings)
+{
+	// Only settings that change what is captured; everything else is applied when rendering
+	uint32 Hash = GetTypeHash(static_cast<uint8>(Settings.ComponentDetailLevel));
+	for (const FString& Prefix : Settings.IgnoredPropertyPrefixes)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Prefix));
+	}
+	return Hash;
+}
+
+bool FBlueprintGraphDatabase::GetSavedHash(FName PackageName, FIoHash& OutHash)
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+	if (!PackageData.IsSet())
+		return false;
+
+	OutHash = PackageData->GetPackageSavedHash();
+	return !OutHash.IsZero();
+}
+
+void FBlueprintGraphDatabase::MapFile()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FString Path = GetDatabasePath();
+	if (!IFileManager::Get().FileExists(*Path))
+		return;
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+	if (!MappedFile.IsValid())
+		return;
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	if (!MappedRegion.IsValid())
+	{
+		MappedFile.Reset();
+		return;
+	}
+
+	// Only the index is read up front; records are decoded when asked for
+	const TConstArrayView<uint8> FileData(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	FMemoryReaderView Reader(MakeMemoryView(FileData));
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumRecords = 0;
+	Reader << Magic << Version << NumRecords;
+	if (Reader.IsError() || Magic != DatabaseMagic || Version != DatabaseVersion || NumRecords < 0)
+	{
+		UnmapFile();
+		return;
+	}
+
+	Records.Reserve(NumRecords);
+	for (int32 Index = 0; Index < NumRecords && !Reader.IsError(); ++Index)
+	{
+		FString PackageName;
+		FRecord Record;
+		Reader << PackageName << Record.SavedHash << Record.SettingsHash << Record.Offset << Record.Size;
+
+		// Records already in memory are newer, or the same ones when the file is mapped again after a failed flush
+		const FName Key(*PackageName);
+		if (Record.Offset >= 0 && Record.Size >= 0 && Record.Offset + Record.Size <= FileData.Num() &&
+			!Records.Contains(Key))
+		{
+			Records.Add(Key, MoveTemp(Record));
+		}
+	}
+}
+
+void FBlueprintGraphDatabase::UnmapFile()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+TConstArrayView<uint8> FBlueprintGraphDatabase::GetRecordData(const FRecord& Record) const
+{
+	if (Record.Pending.IsValid())
+		return *Record.Pending;
+
+	return TConstArrayView<uint8>(MappedRegion->GetMappedPtr() + Record.Offset, Record.Size);
+}
+
+TSharedPtr<const FBlueprintIR> FBlueprintGraphDatabase::FindFresh(FName PackageName,
+                                                                  const FBlueprintDocumentationSettings& Settings)
+{
+	FIoHash SavedHash;
+	if (!GetSavedHash(PackageName, SavedHash))
+		return nullptr;
+
+	FScopeLock ScopeLock(&Lock);
+
+	const FRecord* Record = Records.Find(PackageName);
+	if (!Record || Record->SavedHash != SavedHash || Record->SettingsHash != HashCaptureSettings(Settings))
+		return nullptr;
+
+	const TSharedRef<FBlueprintIR> Snapshot = MakeShared<FBlueprintIR>();
+	FMemoryReaderView Reader(MakeMemoryView(GetRecordData(*Record)));
+	Reader << *Snapshot;
+
+	if (Reader.IsError() || !Snapshot->IsValid())
+		return nullptr;
+
+	return Snapshot;
+}
+
+bool FBlueprintGraphDatabase::IsFresh(FName PackageName, const FBlueprintDocumentationSettings& Settings) const
+{
+	FIoHash SavedHash;
+	if (!GetSavedHash(PackageName, SavedHash))
+		return false;
+
+	FScopeLock ScopeLock(&Lock);
+
+	const FRecord* Record = Records.Find(PackageName);
+	return Record && Record->SavedHash == SavedHash && Record->SettingsHash == HashCaptureSettings(Settings);
+}
+
+uint64 FBlueprintGraphDatabase::HashSnapshot(const FBlueprintIR& Snapshot)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Writer << const_cast<FBlueprintIR&>(Snapshot);
+	return FXxHash64::HashBuffer(Data.GetData(), Data.Num()).Hash;
+}
+
+void FBlueprintGraphDatabase::Store(FName PackageName, const FBlueprintIR& Snapshot,
+                                    const FBlueprintDocumentationSettings& Settings)
+{
+	FRecord Record;
+	if (!Snapshot.IsValid() || !GetSavedHash(PackageName, Record.SavedHash))
+		return;
+
+	const TSharedRef<TArray<uint8>> Data = MakeShared<TArray<uint8>>();
+	FMemoryWriter Writer(*Data);
+	// Saving archives only read from the value
+	Writer << const_cast<FBlueprintIR&>(Snapshot);
+
+	Record.SettingsHash = HashCaptureSettings(Settings);
+	Record.Size = Data->Num();
+	Record.Pending = Data;
+
+	FScopeLock ScopeLock(&Lock);
+	Records.Add(PackageName, MoveTemp(Record));
+	bDirty = true;
+	FlushTime = FPlatformTime::Seconds() + FlushDelaySeconds;
+}
+
+TArray<FName> FBlueprintGraphDatabase::GetPackageNames() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TArray<FName> PackageNames;
+	Records.GenerateKeyArray(PackageNames);
+	return PackageNames;
+}
+
+void FBlueprintGraphDatabase::Flush()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (!bDirty)
+		return;
+
+	// Index size is only known once the package names are written, so write the index twice
+	TArray<FName> PackageNames;
+	Records.GenerateKeyArray(PackageNames);
+	PackageNames.Sort(FNameLexicalLess());
+
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	auto WriteIndex = [&](int64 DataStart)
+	{
+		uint32 Magic = DatabaseMagic;
+		uint32 Version = DatabaseVersion;
+		int32 NumRecords = PackageNames.Num();
+		Writer << Magic << Version << NumRecords;
+
+		int64 Offset = DataStart;
+		for (const FName PackageName : PackageNames)
+		{
+			FRecord& Record = Records[PackageName];
+			FString PackageNameString = PackageName.ToString();
+			Writer << PackageNameString << Record.SavedHash << Record.SettingsHash << Offset << Record.Size;
+			Offset += Record.Size;
+		}
+	};
+
+	WriteIndex(0);
+	const int64 DataStart = Writer.Tell();
+	Writer.Seek(0);
+	WriteIndex(DataStart);
+
+	for (const FName PackageName : PackageNames)
+	{
+		const TConstArrayView<uint8> RecordData = GetRecordData(Records[PackageName]);
+		Writer.Serialize(const_cast<uint8*>(RecordData.GetData()), RecordData.Num());
+	}
+
+	const FString Path = GetDatabasePath();
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempPath))
+	{
+		// Keep the records in memory and try again later
+		FlushTime = FPlatformTime::Seconds() + FlushDelaySeconds;
+		return;
+	}
+
+	// The mapped file can't be replaced while it is mapped; the index is read again from the new file
+	UnmapFile();
+	if (!IFileManager::Get().Move(*Path, *TempPath, true, true))
+	{
+		// Locked by another process, say; the old file is mapped again under the records, and they are kept
+		MapFile();
+		if (!MappedRegion.IsValid())
+		{
+			for (auto It = Records.CreateIterator(); It; ++It)
+			{
+				if (!It->Value.Pending.IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+		FlushTime = FPlatformTime::Seconds() + FlushDelaySeconds;
+		return;
+	}
+
+	Records.Reset();
+	bDirty = false;
+	MapFile();
+}
+
+void FBlueprintGraphDatabase::OnPackageSaved(const FString& PackageFilename, UPackage* Package,
+                                             FObjectPostSaveContext SaveContext)
+{
+	if (SaveContext.IsProceduralSave() || !Package)
+		return;
+
+	if (Cast<UBlueprint>(Package->FindAssetInPackage()))
+	{
+		SavedPackages.AddUnique(Package->GetFName());
+	}
+}
+
+bool FBlueprintGraphDatabase::Tick(float DeltaTime)
+{
+	// Captured on a later tick so the asset registry has picked up the new saved-package hash
+	if (!ActiveCapture.IsValid() && SavedPackages.Num() > 0)
+	{
+		CaptureNextSavedPackage();
+	}
+
+	if (bDirty && !ActiveCapture.IsValid() && FPlatformTime::Seconds() >= FlushTime)
+	{
+		Flush();
+	}
+
+	return true;
+}
+
+void FBlueprintGraphDatabase::CaptureNextSavedPackage()
+{
+	while (SavedPackages.Num() > 0)
+	{
+		const FName PackageName = SavedPackages[0];
+		SavedPackages.RemoveAt(0, 1, EAllowShrinking::No);
+
+		const UPackage* Package = FindPackage(nullptr, *PackageName.ToString());
+		UBlueprint* Blueprint = Package ? Cast<UBlueprint>(Package->FindAssetInPackage()) : nullptr;
+		if (!Blueprint || Package->IsDirty())
+			continue;
+
+		const UUnrealMastermindSettings* PersistentSettings = GetDefault<UUnrealMastermindSettings>();
+		const FBlueprintDocumentationSettings DocSettings = PersistentSettings->MakeDocumentationSettings();
+
+		TWeakObjectPtr<const UPackage> WeakPackage(Package);
+		ActiveCapture = MakeShared<FBlueprintSnapshotTask>(Blueprint, DocSettings,
+		                                                   PersistentSettings->SnapshotFrameBudgetMs);
+		ActiveCapture->Start(FBlueprintSnapshotTask::FOnComplete::CreateLambda(
+			[this, PackageName, WeakPackage, DocSettings](TSharedPtr<const FBlueprintIR> Snapshot)
+			{
+				// Edited again while being captured: the next save will queue it again
+				if (Snapshot.IsValid() && WeakPackage.IsValid() && !WeakPackage->IsDirty())
+				{
+					Store(PackageName, *Snapshot, DocSettings);
+				}
+				ActiveCapture.Reset();
+			}));
+		return;
+	}
+}
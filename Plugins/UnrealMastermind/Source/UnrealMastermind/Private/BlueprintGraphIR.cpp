@@ -0,0 +1,420 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintGraphIR.h"
+#include "BlueprintGraphCache.h"
+#include "ComponentPropertyPlan.h"
+#include "EdGraphNode_Comment.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphPin.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_Tunnel.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+
+FBlueprintIR FBlueprintIRBuilder::Build(const UBlueprint* Blueprint, const FBlueprintDocumentationSettings& Settings)
+{
+	FBlueprintIRBuilder Builder(Blueprint, Settings);
+	while (!Builder.Step(TNumericLimits<double>::Max()))
+	{
+	}
+	return Builder.Finish();
+}
+
+FBlueprintIRBuilder::FBlueprintIRBuilder(const UBlueprint* InBlueprint,
+                                         const FBlueprintDocumentationSettings& InSettings)
+	: Blueprint(InBlueprint)
+	, Settings(InSettings)
+{
+	if (!Blueprint)
+		return;
+
+	IR.BlueprintName = Blueprint->GetName();
+	IR.ParentClassName = Blueprint->ParentClass ? Blueprint->ParentClass->GetName() : FString(TEXT("None"));
+	IR.CapturedDetailLevel = Settings.ComponentDetailLevel;
+
+	TSet<const UEdGraph*> AddedGraphs;
+	auto AddGraphs = [&](const TArray<TObjectPtr<UEdGraph>>& Graphs, EBlueprintIRGraphKind Kind)
+	{
+		for (const UEdGraph* Graph : Graphs)
+		{
+			bool bAlreadyAdded = false;
+			AddedGraphs.Add(Graph, &bAlreadyAdded);
+			if (Graph && !bAlreadyAdded)
+			{
+				PendingGraphs.Emplace(Graph, Kind);
+			}
+		}
+	};
+
+	AddGraphs(Blueprint->UbergraphPages, EBlueprintIRGraphKind::EventGraph);
+	AddGraphs(Blueprint->FunctionGraphs, EBlueprintIRGraphKind::Function);
+	AddGraphs(Blueprint->MacroGraphs, EBlueprintIRGraphKind::Macro);
+
+	// Collapsed graphs and anything else nested in the graphs above
+	TArray<UEdGraph*> AllGraphs;
+	Blueprint->GetAllGraphs(AllGraphs);
+	for (const UEdGraph* Graph : AllGraphs)
+	{
+		bool bAlreadyAdded = false;
+		AddedGraphs.Add(Graph, &bAlreadyAdded);
+		if (Graph && !bAlreadyAdded)
+		{
+			PendingGraphs.Emplace(Graph, EBlueprintIRGraphKind::Other);
+		}
+	}
+
+	if (Blueprint->SimpleConstructionScript)
+	{
+		PendingComponents.Append(Blueprint->SimpleConstructionScript->GetAllNodes());
+	}
+
+	IR.Graphs.Reserve(PendingGraphs.Num());
+	IR.Components.Reserve(PendingComponents.Num());
+	NumSteps = PendingGraphs.Num() + 1 + PendingComponents.Num();
+}
+
+bool FBlueprintIRBuilder::Step(double BudgetSeconds)
+{
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+	while (!IsComplete())
+	{
+		RunStep(NextStep++);
+		if (FPlatformTime::Seconds() >= EndTime)
+			break;
+	}
+	return IsComplete();
+}
+
+FBlueprintIR FBlueprintIRBuilder::Finish()
+{
+	check(IsComplete());
+	VariableUsages.Empty();
+	return MoveTemp(IR);
+}
+
+void FBlueprintIRBuilder::RunStep(int32 StepIndex)
+{
+	if (StepIndex < PendingGraphs.Num())
+	{
+		AddGraph(IR, PendingGraphs[StepIndex].Key, PendingGraphs[StepIndex].Value);
+		AddVariableUsages(IR.Graphs.Last(), IR.Graphs.Num() - 1, VariableUsages);
+		return;
+	}
+	StepIndex -= PendingGraphs.Num();
+
+	if (StepIndex == 0)
+	{
+		AddVariables(IR, Blueprint, VariableUsages);
+		return;
+	}
+
+	AddComponent(IR, PendingComponents[StepIndex - 1], Settings);
+}
+
+void FBlueprintIRBuilder::AddGraph(FBlueprintIR& IR, const UEdGraph* Graph, EBlueprintIRGraphKind Kind)
+{
+	const uint64 ContentHash = FBlueprintGraphHash::Compute(Graph);
+
+	// Unchanged since the last extraction: reuse the captured graph
+	if (const TSharedPtr<const FBlueprintIRGraph> CachedGraph =
+		FBlueprintIRGraphCache::Get().Find(Graph, ContentHash, Kind))
+	{
+		IR.Graphs.Add(*CachedGraph);
+		return;
+	}
+
+	FBlueprintIRGraph& GraphIR = IR.Graphs.AddDefaulted_GetRef();
+	GraphIR.Name = Graph->GetName();
+	GraphIR.Kind = Kind;
+	GraphIR.ContentHash = ContentHash;
+	GraphIR.Nodes.Reserve(Graph->Nodes.Num());
+
+	// First pass: nodes and pins, so links can be resolved to pin indices
+	TMap<const UEdGraphPin*, int32> PinLookup;
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node)
+			continue;
+
+		if (const UEdGraphNode_Comment* CommentNode = Cast<UEdGraphNode_Comment>(Node))
+		{
+			GraphIR.Comments.Add(CommentNode->NodeComment);
+			continue;
+		}
+
+		const int32 NodeIndex = GraphIR.Nodes.Num();
+		FBlueprintIRNode& NodeIR = GraphIR.Nodes.AddDefaulted_GetRef();
+		NodeIR.Guid = Node->NodeGuid;
+		NodeIR.Title = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+		NodeIR.FullTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+		NodeIR.FirstPin = GraphIR.Pins.Num();
+		NodeIR.NumPins = Node->Pins.Num();
+
+		if (Node->IsA<UK2Node_Event>())
+		{
+			NodeIR.Kind = EBlueprintIRNodeKind::Event;
+		}
+		else if (Node->IsA<UK2Node_FunctionEntry>())
+		{
+			NodeIR.Kind = EBlueprintIRNodeKind::FunctionEntry;
+		}
+		else if (const UK2Node_Tunnel* Tunnel = Cast<UK2Node_Tunnel>(Node);
+			Tunnel && Tunnel->bCanHaveOutputs && !Tunnel->bCanHaveInputs)
+		{
+			NodeIR.Kind = EBlueprintIRNodeKind::MacroEntry;
+		}
+		else if (const UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
+		{
+			NodeIR.Kind = EBlueprintIRNodeKind::VariableGet;
+			NodeIR.VariableName = GetNode->VariableReference.GetMemberName();
+		}
+		else if (const UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
+		{
+			NodeIR.Kind = EBlueprintIRNodeKind::VariableSet;
+			NodeIR.VariableName = SetNode->VariableReference.GetMemberName();
+		}
+
+		if (NodeIR.Kind == EBlueprintIRNodeKind::Event || NodeIR.Kind == EBlueprintIRNodeKind::FunctionEntry ||
+			NodeIR.Kind == EBlueprintIRNodeKind::MacroEntry)
+		{
+			GraphIR.EntryNodes.Add(NodeIndex);
+		}
+
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			PinLookup.Add(Pin, GraphIR.Pins.Num());
+
+			FBlueprintIRPin& PinIR = GraphIR.Pins.AddDefaulted_GetRef();
+			PinIR.Name = Pin->PinName;
+			PinIR.Category = Pin->PinType.PinCategory;
+			PinIR.DefaultValue = Pin->DefaultValue;
+			PinIR.Node = NodeIndex;
+			PinIR.bIsInput = Pin->Direction == EGPD_Input;
+			PinIR.bIsExec = Pin->PinType.PinCategory == "exec";
+		}
+	}
+
+	// Second pass: links, in the same order as UEdGraphPin::LinkedTo
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node || Node->IsA<UEdGraphNode_Comment>())
+			continue;
+
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			const int32 PinIndex = PinLookup.FindChecked(Pin);
+			FBlueprintIRPin& PinIR = GraphIR.Pins[PinIndex];
+			PinIR.FirstEdge = GraphIR.Edges.Num();
+
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (const int32* LinkedIndex = PinLookup.Find(LinkedPin))
+				{
+					GraphIR.Edges.Add({PinIndex, *LinkedIndex});
+				}
+			}
+
+			PinIR.NumEdges = GraphIR.Edges.Num() - PinIR.FirstEdge;
+		}
+	}
+	FBlueprintIRGraphCache::Get().Add(Graph, GraphIR);
+}
+
+void FBlueprintIRBuilder::AddVariableUsages(const FBlueprintIRGraph& GraphIR, int32 GraphIndex,
+                                            TMap<FName, TArray<FBlueprintIRVariableUsage>>& OutUsages)
+{
+	// Entry node whose execution chain reaches each node; earlier entries keep the nodes they reach first
+	TArray<int32> Contexts;
+	Contexts.Init(INDEX_NONE, GraphIR.Nodes.Num());
+
+	TArray<int32> Stack;
+	for (const int32 EntryIndex : GraphIR.EntryNodes)
+	{
+		if (Contexts[EntryIndex] != INDEX_NONE)
+			continue;
+
+		Contexts[EntryIndex] = EntryIndex;
+		Stack.Reset();
+		Stack.Add(EntryIndex);
+		while (Stack.Num() > 0)
+		{
+			const FBlueprintIRNode& Node = GraphIR.Nodes[Stack.Pop(EAllowShrinking::No)];
+			for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintIRPin& Pin = GraphIR.Pins[PinIndex];
+				if (Pin.bIsInput || !Pin.bIsExec)
+					continue;
+
+				for (int32 EdgeIndex = Pin.FirstEdge; EdgeIndex < Pin.FirstEdge + Pin.NumEdges; ++EdgeIndex)
+				{
+					const int32 NextNode = GraphIR.Pins[GraphIR.Edges[EdgeIndex].ToPin].Node;
+					if (Contexts[NextNode] == INDEX_NONE)
+					{
+						Contexts[NextNode] = EntryIndex;
+						Stack.Add(NextNode);
+					}
+				}
+			}
+		}
+	}
+
+	// Pure nodes have no exec pins, so take the context of the first impure node consuming their output
+	auto ResolvePureContext = [&GraphIR, &Contexts, &Stack](int32 NodeIndex)
+	{
+		TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<8>> Visited;
+		Stack.Reset();
+		Stack.Add(NodeIndex);
+		Visited.Add(NodeIndex);
+		while (Stack.Num() > 0)
+		{
+			const FBlueprintIRNode& Node = GraphIR.Nodes[Stack.Pop(EAllowShrinking::No)];
+			for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintIRPin& Pin = GraphIR.Pins[PinIndex];
+				if (Pin.bIsInput)
+					continue;
+
+				for (int32 EdgeIndex = Pin.FirstEdge; EdgeIndex < Pin.FirstEdge + Pin.NumEdges; ++EdgeIndex)
+				{
+					const int32 Consumer = GraphIR.Pins[GraphIR.Edges[EdgeIndex].ToPin].Node;
+					if (Contexts[Consumer] != INDEX_NONE)
+						return Contexts[Consumer];
+
+					bool bAlreadyVisited = false;
+					Visited.Add(Consumer, &bAlreadyVisited);
+					if (!bAlreadyVisited)
+					{
+						Stack.Add(Consumer);
+					}
+				}
+			}
+		}
+		return static_cast<int32>(INDEX_NONE);
+	};
+
+	for (int32 NodeIndex = 0; NodeIndex < GraphIR.Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintIRNode& Node = GraphIR.Nodes[NodeIndex];
+		if (Node.Kind != EBlueprintIRNodeKind::VariableGet && Node.Kind != EBlueprintIRNodeKind::VariableSet)
+			continue;
+
+		int32 Context = Contexts[NodeIndex];
+		if (Context == INDEX_NONE && Node.Kind == EBlueprintIRNodeKind::VariableGet)
+		{
+			bool bHasExecPins = false;
+			for (int32 PinIndex = 0; PinIndex < Node.NumPins && !bHasExecPins; ++PinIndex)
+			{
+				bHasExecPins = GraphIR.GetPin(Node, PinIndex).bIsExec;
+			}
+			if (!bHasExecPins)
+			{
+				Context = ResolvePureContext(NodeIndex);
+			}
+		}
+
+		FBlueprintIRVariableUsage& Usage = OutUsages.FindOrAdd(Node.VariableName).AddDefaulted_GetRef();
+		Usage.Graph = GraphIndex;
+		Usage.Node = NodeIndex;
+		Usage.bIsWrite = Node.Kind == EBlueprintIRNodeKind::VariableSet;
+		if (Context != INDEX_NONE)
+		{
+			Usage.ExecContext = GraphIR.Nodes[Context].Title;
+		}
+	}
+}
+
+void FBlueprintIRBuilder::AddVariables(FBlueprintIR& IR, const UBlueprint* Blueprint,
+                                       TMap<FName, TArray<FBlueprintIRVariableUsage>>& Usages)
+{
+	// The usages were collected with each graph, so this step only lays them out per variable
+	IR.Variables.Reserve(Blueprint->NewVariables.Num());
+	for (const FBPVariableDescription& Variable : Blueprint->NewVariables)
+	{
+		FBlueprintIRVariable& VariableIR = IR.Variables.AddDefaulted_GetRef();
+		VariableIR.Name = Variable.VarName;
+		VariableIR.Category = Variable.VarType.PinCategory;
+		VariableIR.FirstUsage = IR.VariableUsages.Num();
+
+		if (TArray<FBlueprintIRVariableUsage>* VariableUsages = Usages.Find(Variable.VarName))
+		{
+			IR.VariableUsages.Append(MoveTemp(*VariableUsages));
+		}
+
+		VariableIR.NumUsages = IR.VariableUsages.Num() - VariableIR.FirstUsage;
+	}
+}
+
+void FBlueprintIRBuilder::AddComponent(FBlueprintIR& IR, const USCS_Node* Node,
+                                       const FBlueprintDocumentationSettings& Settings)
+{
+	FBlueprintIRComponent& ComponentIR = IR.Components.AddDefaulted_GetRef();
+	ComponentIR.Name = Node->GetVariableName().ToString();
+	ComponentIR.ClassName = Node->ComponentClass ? Node->ComponentClass->GetName() : FString(TEXT("None"));
+
+	const UActorComponent* TemplateComponent = Node->ComponentTemplate;
+	if (!TemplateComponent ||
+		Settings.ComponentDetailLevel == FBlueprintDocumentationSettings::EComponentDetailLevel::Minimal)
+	{
+		return;
+	}
+
+	const TSharedRef<const FComponentPropertyPlan> Plan =
+		FComponentPropertyPlanCache::Get().GetPlan(TemplateComponent->GetClass(), Settings.IgnoredPropertyPrefixes);
+
+	// Add important properties for Basic level
+	ComponentIR.FirstImportantProperty = IR.Properties.Num();
+	AddImportantComponentProperties(IR, TemplateComponent, *Plan);
+	ComponentIR.NumImportantProperties = IR.Properties.Num() - ComponentIR.FirstImportantProperty;
+
+	// Add all non-default properties for Full level
+	if (Settings.ComponentDetailLevel == FBlueprintDocumentationSettings::EComponentDetailLevel::Full)
+	{
+		ComponentIR.FirstProperty = IR.Properties.Num();
+		AddAllComponentProperties(IR, TemplateComponent, *Plan);
+		ComponentIR.NumProperties = IR.Properties.Num() - ComponentIR.FirstProperty;
+	}
+}
+
+// Helper method for important properties
+void FBlueprintIRBuilder::AddImportantComponentProperties(FBlueprintIR& IR, const UActorComponent* Component,
+                                                          const FComponentPropertyPlan& Plan)
+{
+	for (const FProperty* Property : Plan.ImportantProperties)
+	{
+		const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Component);
+		FString ValueStr;
+		Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, nullptr, PPF_None);
+
+		if (!ValueStr.IsEmpty() && ValueStr != TEXT("()"))
+		{
+			IR.Properties.Add({Property->GetName(), MoveTemp(ValueStr)});
+		}
+	}
+}
+
+// Helper method for all non-default properties
+void FBlueprintIRBuilder::AddAllComponentProperties(FBlueprintIR& IR, const UActorComponent* Component,
+                                                    const FComponentPropertyPlan& Plan)
+{
+	// The template's archetype holds the values the component would have if left untouched
+	const UObject* Archetype = Component->GetArchetype();
+
+	for (const FProperty* Property : Plan.Properties)
+	{
+		if (Archetype && Property->Identical_InContainer(Component, Archetype))
+			continue;
+
+		const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Component);
+		FString ValueStr;
+		Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, nullptr, PPF_None);
+
+		if (!ValueStr.IsEmpty() && ValueStr != TEXT("()"))
+		{
+			IR.Properties.Add({Property->GetName(), MoveTemp(ValueStr)});
+		}
+	}
+}
@@ -0,0 +1,853 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintIRRenderer.h"
+#include "BlueprintExecutionFlow.h"
+#include "Misc/ScopeRWLock.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	struct FRendererTable
+	{
+		FRWLock Lock;
+		TMap<FName, TSharedRef<const IBlueprintIRRenderer>> Renderers;
+
+		FRendererTable()
+		{
+			Renderers.Add(FBlueprintIRRendererRegistry::Text, MakeShared<FBlueprintIRTextRenderer>());
+			Renderers.Add(FBlueprintIRRendererRegistry::Compact, MakeShared<FBlueprintIRCompactRenderer>());
+			Renderers.Add(FBlueprintIRRendererRegistry::Json, MakeShared<FBlueprintIRJsonRenderer>());
+		}
+	};
+
+	FRendererTable& GetRendererTable()
+	{
+		static FRendererTable Table;
+		return Table;
+	}
+
+	const TCHAR* LexGraphKind(EBlueprintIRGraphKind Kind)
+	{
+		switch (Kind)
+		{
+		case EBlueprintIRGraphKind::EventGraph:
+			return TEXT("EventGraph");
+		case EBlueprintIRGraphKind::Function:
+			return TEXT("Function");
+		case EBlueprintIRGraphKind::Macro:
+			return TEXT("Macro");
+		default:
+			return TEXT("Other");
+		}
+	}
+
+	const TCHAR* LexNodeKind(EBlueprintIRNodeKind Kind)
+	{
+		switch (Kind)
+		{
+		case EBlueprintIRNodeKind::Event:
+			return TEXT("Event");
+		case EBlueprintIRNodeKind::FunctionEntry:
+			return TEXT("FunctionEntry");
+		case EBlueprintIRNodeKind::MacroEntry:
+			return TEXT("MacroEntry");
+		case EBlueprintIRNodeKind::VariableGet:
+			return TEXT("VariableGet");
+		case EBlueprintIRNodeKind::VariableSet:
+			return TEXT("VariableSet");
+		default:
+			return TEXT("Generic");
+		}
+	}
+}
+
+const FName FBlueprintIRRendererRegistry::Text = FName("Text");
+const FName FBlueprintIRRendererRegistry::Compact = FName("Compact");
+const FName FBlueprintIRRendererRegistry::Json = FName("Json");
+
+void FBlueprintIRRendererRegistry::Register(FName Format, const TSharedRef<const IBlueprintIRRenderer>& Renderer)
+{
+	FRendererTable& Table = GetRendererTable();
+	FWriteScopeLock WriteLock(Table.Lock);
+	Table.Renderers.Add(Format, Renderer);
+}
+
+void FBlueprintIRRendererRegistry::Unregister(FName Format)
+{
+	FRendererTable& Table = GetRendererTable();
+	FWriteScopeLock WriteLock(Table.Lock);
+	Table.Renderers.Remove(Format);
+}
+
+TSharedPtr<const IBlueprintIRRenderer> FBlueprintIRRendererRegistry::Find(FName Format)
+{
+	FRendererTable& Table = GetRendererTable();
+	FReadScopeLock ReadLock(Table.Lock);
+	if (const TSharedRef<const IBlueprintIRRenderer>* Renderer = Table.Renderers.Find(Format))
+	{
+		return *Renderer;
+	}
+	return nullptr;
+}
+
+FString FBlueprintIRRendererRegistry::Render(FName Format, const FBlueprintIR& IR,
+                                             const FBlueprintDocumentationSettings& Settings)
+{
+	FPromptWriter& Writer = FPromptWriter::GetThreadLocal();
+	Render(Format, IR, Settings, Writer);
+	return Writer.ToString();
+}
+
+void FBlueprintIRRendererRegistry::Render(FName Format, const FBlueprintIR& IR,
+                                          const FBlueprintDocumentationSettings& Settings, FPromptWriter& Writer)
+{
+	if (const TSharedPtr<const IBlueprintIRRenderer> Renderer = Find(Format))
+	{
+		Renderer->Render(IR, Settings, Writer);
+	}
+}
+
+// Text renderer
+
+void FBlueprintIRTextRenderer::Render(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+                                      FPromptWriter& Out) const
+{
+	if (!IR.IsValid())
+	{
+		Out << TEXT("Invalid Blueprint");
+		return;
+	}
+
+	// Basic Blueprint Info
+	if (Settings.bIncludeBasicInfo)
+	{
+		Out << TEXT("Blueprint Name: ") << IR.BlueprintName << TEXT('\n');
+		Out << TEXT("Parent Class: ") << IR.ParentClassName << TEXT("\n\n");
+	}
+
+	// Variables
+	if (Settings.bIncludeVariables)
+	{
+		RenderVariableInfo(IR, Settings, Out);
+	}
+
+	RenderEventGraphInfo(IR, Settings, Out);
+	RenderFunctionGraphInfo(IR, Settings, Out);
+	RenderComponentInfo(IR, Settings, Out);
+	RenderComments(IR, Out);
+}
+
+void FBlueprintIRTextRenderer::RenderVariableInfo(const FBlueprintIR& IR,
+                                                  const FBlueprintDocumentationSettings& Settings,
+                                                  FPromptWriter& Out)
+{
+	Out << TEXT("\nVariable Usages:\n");
+	int32 NumUnused = 0;
+	for (const FBlueprintIRVariable& Variable : IR.Variables)
+	{
+		if (Variable.NumUsages == 0 && Settings.bSummarizeUnusedVariables)
+		{
+			++NumUnused;
+			continue;
+		}
+
+		Out << TEXT("- ") << Variable.Name << TEXT(" is used in:\n");
+
+		if (Variable.NumUsages == 0)
+		{
+			Out << TEXT("    Not used in any graph\n");
+			continue;
+		}
+
+		for (int32 UsageIndex = Variable.FirstUsage; UsageIndex < Variable.FirstUsage + Variable.NumUsages; ++UsageIndex)
+		{
+			const FBlueprintIRVariableUsage& Usage = IR.VariableUsages[UsageIndex];
+			Out << TEXT("    ") << IR.Graphs[Usage.Graph].Name
+				<< (Usage.bIsWrite ? TEXT(" (Write)") : TEXT(" (Read)"));
+			if (!Usage.ExecContext.IsEmpty())
+			{
+				Out << TEXT(" in ") << Usage.ExecContext;
+			}
+			Out << TEXT('\n');
+		}
+	}
+
+	if (NumUnused > 0)
+	{
+		Out << TEXT("- Not used in any graph: ");
+		bool bFirst = true;
+		for (const FBlueprintIRVariable& Variable : IR.Variables)
+		{
+			if (Variable.NumUsages == 0)
+			{
+				Out << (bFirst ? TEXT("") : TEXT(", ")) << Variable.Name;
+				bFirst = false;
+			}
+		}
+		Out << TEXT('\n');
+	}
+}
+
+void FBlueprintIRTextRenderer::RenderEventGraphInfo(const FBlueprintIR& IR,
+                                                    const FBlueprintDocumentationSettings& Settings,
+                                                    FPromptWriter& Out)
+{
+	Out << TEXT("\nEvent Graphs:\n");
+	for (const FBlueprintIRGraph& Graph : IR.Graphs)
+	{
+		if (Graph.Kind != EBlueprintIRGraphKind::EventGraph)
+			continue;
+
+		Out << TEXT("- ") << Graph.Name << TEXT('\n');
+
+		// Shared by all events of the graph, so logic they have in common is only described once
+		FBlueprintExecutionFlowWalker Walker(Graph);
+		TArray<int32, TInlineAllocator<4>> ExecPins;
+
+		// Process each event
+		for (const int32 EntryIndex : Graph.EntryNodes)
+		{
+			const FBlueprintIRNode& EventNode = Graph.Nodes[EntryIndex];
+			if (EventNode.Kind != EBlueprintIRNodeKind::Event)
+				continue;
+
+			Out << TEXT("  Event: ") << EventNode.FullTitle << TEXT('\n');
+
+			// Follow execution flow from this event
+			Walker.GetExecOutputs(EntryIndex, ExecPins);
+			for (const int32 ExecPin : ExecPins)
+			{
+				TraceExecutionFlow(Walker, Graph, ExecPin, Out, 2, Settings);
+			}
+			Out << TEXT('\n');
+		}
+	}
+}
+
+void FBlueprintIRTextRenderer::RenderFunctionGraphInfo(const FBlueprintIR& IR,
+                                                       const FBlueprintDocumentationSettings& Settings,
+                                                       FPromptWriter& Out)
+{
+	Out << TEXT("\nFunctions:\n");
+	for (const FBlueprintIRGraph& Graph : IR.Graphs)
+	{
+		if (Graph.Kind != EBlueprintIRGraphKind::Function)
+			continue;
+
+		Out << TEXT("- ") << Graph.Name << TEXT('\n');
+
+		// Find function entry node to get parameters
+		int32 EntryIndex = INDEX_NONE;
+		for (const int32 NodeIndex : Graph.EntryNodes)
+		{
+			if (Graph.Nodes[NodeIndex].Kind == EBlueprintIRNodeKind::FunctionEntry)
+			{
+				EntryIndex = NodeIndex;
+				break;
+			}
+		}
+
+		if (EntryIndex != INDEX_NONE)
+		{
+			const FBlueprintIRNode& EntryNode = Graph.Nodes[EntryIndex];
+
+			// Parameters
+			Out << TEXT("  Parameters:\n");
+			for (int32 PinIndex = 0; PinIndex < EntryNode.NumPins; ++PinIndex)
+			{
+				const FBlueprintIRPin& Pin = Graph.GetPin(EntryNode, PinIndex);
+				if (!Pin.bIsInput && !Pin.bIsExec)
+				{
+					Out << TEXT("    - ") << Pin.Name << TEXT(" (") << Pin.Category << TEXT(")\n");
+				}
+			}
+
+			// Node execution flow - follow the exec lines
+			Out << TEXT("  Execution Flow:\n");
+			FBlueprintExecutionFlowWalker Walker(Graph);
+			TArray<int32, TInlineAllocator<4>> ExecPins;
+			Walker.GetExecOutputs(EntryIndex, ExecPins);
+			for (const int32 ExecPin : ExecPins)
+			{
+				TraceExecutionFlow(Walker, Graph, ExecPin, Out, 1, Settings);
+			}
+		}
+	}
+}
+
+void FBlueprintIRTextRenderer::RenderComponentInfo(const FBlueprintIR& IR,
+                                                   const FBlueprintDocumentationSettings& Settings,
+                                                   FPromptWriter& Out)
+{
+	if (IR.Components.Num() == 0)
+		return;
+
+	Out << TEXT("\nComponents:\n");
+	for (const FBlueprintIRComponent& Component : IR.Components)
+	{
+		// Basic component info
+		Out << TEXT("- ") << Component.Name << TEXT(" (") << Component.ClassName << TEXT(")\n");
+
+		if (Settings.ComponentDetailLevel == FBlueprintDocumentationSettings::EComponentDetailLevel::Minimal)
+			continue;
+
+		// Important properties for Basic level
+		for (int32 PropIndex = Component.FirstImportantProperty;
+		     PropIndex < Component.FirstImportantProperty + Component.NumImportantProperties; ++PropIndex)
+		{
+			const FBlueprintIRProperty& Property = IR.Properties[PropIndex];
+			Out << TEXT("    ") << Property.Name << TEXT(": ") << Property.Value << TEXT('\n');
+		}
+
+		// All non-default properties for Full level
+		if (Settings.ComponentDetailLevel == FBlueprintDocumentationSettings::EComponentDetailLevel::Full)
+		{
+			for (int32 PropIndex = Component.FirstProperty;
+			     PropIndex < Component.FirstProperty + Component.NumProperties; ++PropIndex)
+			{
+				const FBlueprintIRProperty& Property = IR.Properties[PropIndex];
+				Out << TEXT("    ") << Property.Name << TEXT(": ") << Property.Value << TEXT('\n');
+			}
+		}
+	}
+}
+
+void FBlueprintIRTextRenderer::RenderComments(const FBlueprintIR& IR, FPromptWriter& Out)
+{
+	Out << TEXT("\nDocumentation Comments:\n");
+	for (const FBlueprintIRGraph& Graph : IR.Graphs)
+	{
+		if (Graph.Kind != EBlueprintIRGraphKind::EventGraph)
+			continue;
+
+		for (const FString& Comment : Graph.Comments)
+		{
+			Out << TEXT("- [") << Graph.Name << TEXT("] ") << Comment << TEXT('\n');
+		}
+	}
+}
+
+void FBlueprintIRTextRenderer::TraceExecutionFlow(FBlueprintExecutionFlowWalker& Walker,
+                                                  const FBlueprintIRGraph& Graph, int32 ExecPin,
+                                                  FPromptWriter& Out, int32 Depth,
+                                                  const FBlueprintDocumentationSettings& Settings)
+{
+	struct FTextVisitor
+	{
+		const FBlueprintExecutionFlowWalker& Walker;
+		const FBlueprintIRGraph& Graph;
+		FPromptWriter& Out;
+		const bool bIncludePinValues;
+
+		void Node(int32 NodeIndex, int32 Depth)
+		{
+			const FBlueprintIRNode& Node = Graph.Nodes[NodeIndex];
+
+			// Add node title/type; nodes reachable from several paths get an id to refer back to
+			Out.Indent(Depth * 2) << TEXT("→ ") << Node.Title;
+			if (Walker.IsReconvergent(NodeIndex))
+			{
+				Out << TEXT(" #") << NodeIndex;
+			}
+			Out << TEXT('\n');
+
+			// Add input values
+			for (int32 PinIndex = 0; PinIndex < Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintIRPin& Pin = Graph.GetPin(Node, PinIndex);
+				if (!Pin.bIsInput || Pin.bIsExec)
+					continue;
+
+				// Literals can be left out to save space; what a pin is connected to is always kept
+				if (!bIncludePinValues && Pin.NumEdges == 0)
+					continue;
+
+				Out.Indent(Depth * 2) << TEXT("  Input: ") << Pin.Name << TEXT(" (") << Pin.Category << TEXT(") = ");
+				AppendPinValue(Graph, Pin, Out);
+				Out << TEXT('\n');
+			}
+		}
+
+		void BackReference(int32 NodeIndex, int32 Depth)
+		{
+			Out.Indent(Depth * 2) << TEXT("→ (continues at #") << NodeIndex << TEXT(' ')
+				<< Graph.Nodes[NodeIndex].Title << TEXT(")\n");
+		}
+
+		void BranchLabel(int32 PinIndex, int32 Depth)
+		{
+			Out.Indent(Depth * 2) << TEXT('[') << Graph.Pins[PinIndex].Name << TEXT("]\n");
+		}
+
+		void DepthLimit(int32 Depth)
+		{
+			Out.Indent((Depth - 1) * 2) << TEXT("→ ... (Max depth reached) ...\n");
+		}
+	};
+
+	FTextVisitor Visitor{Walker, Graph, Out, Settings.bIncludePinValues};
+	Walker.Walk(ExecPin, Depth, Settings.MaxExecutionFlowDepth, Visitor);
+}
+
+void FBlueprintIRTextRenderer::AppendPinValue(const FBlueprintIRGraph& Graph, const FBlueprintIRPin& Pin,
+                                              FPromptWriter& Out)
+{
+	// For connected pins, show what they connect to
+	const int32 ConnectedNode = Graph.GetFirstLinkedNode(Pin);
+	if (ConnectedNode != INDEX_NONE)
+	{
+		Out << TEXT("Connected to ") << Graph.Nodes[ConnectedNode].Title;
+		return;
+	}
+
+	// For literal values
+	Out << Pin.DefaultValue;
+}
+
+// Compact renderer
+
+void FBlueprintIRCompactRenderer::Render(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+                                         FPromptWriter& Out) const
+{
+	if (!IR.IsValid())
+		return;
+
+	if (Settings.bIncludeBasicInfo)
+	{
+		Out << TEXT("BP ") << IR.BlueprintName << TEXT(" : ") << IR.ParentClassName << TEXT('\n');
+	}
+
+	// V Name:Type R@Graph/Context W@Graph
+	if (Settings.bIncludeVariables)
+	{
+		for (const FBlueprintIRVariable& Variable : IR.Variables)
+		{
+			Out << TEXT("V ") << Variable.Name << TEXT(':') << Variable.Category;
+			for (int32 UsageIndex = Variable.FirstUsage; UsageIndex < Variable.FirstUsage + Variable.NumUsages; ++UsageIndex)
+			{
+				const FBlueprintIRVariableUsage& Usage = IR.VariableUsages[UsageIndex];
+				Out << (Usage.bIsWrite ? TEXT(" W@") : TEXT(" R@")) << IR.Graphs[Usage.Graph].Name;
+				if (!Usage.ExecContext.IsEmpty())
+				{
+					Out << TEXT('/') << Usage.ExecContext;
+				}
+			}
+			Out << TEXT('\n');
+		}
+	}
+
+	// G Graph
+	// E Entry -> 3
+	// 3 Node(Pin=Value,Pin=@Source) True->4 False->5
+	// Every reachable node is listed once, so shared paths are referenced by index instead of repeated
+	struct FCompactVisitor
+	{
+		const FBlueprintExecutionFlowWalker& Walker;
+		const FBlueprintIRGraph& Graph;
+		FPromptWriter& Out;
+		const bool bIncludePinValues;
+		TArray<int32, TInlineAllocator<4>> ExecPins;
+
+		void Node(int32 NodeIndex, int32 Depth)
+		{
+			const FBlueprintIRNode& Node = Graph.Nodes[NodeIndex];
+			Out << NodeIndex << TEXT(' ') << Node.Title;
+
+			bool bFirstArg = true;
+			for (int32 PinIndex = 0; PinIndex < Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintIRPin& Pin = Graph.GetPin(Node, PinIndex);
+				if (!Pin.bIsInput || Pin.bIsExec)
+					continue;
+
+				const int32 SourceNode = Graph.GetFirstLinkedNode(Pin);
+				if (SourceNode == INDEX_NONE && (Pin.DefaultValue.IsEmpty() || !bIncludePinValues))
+					continue;
+
+				Out << (bFirstArg ? TEXT('(') : TEXT(',')) << Pin.Name << TEXT('=');
+				if (SourceNode != INDEX_NONE)
+				{
+					Out << TEXT('@') << Graph.Nodes[SourceNode].Title;
+				}
+				else
+				{
+					Out << Pin.DefaultValue;
+				}
+				bFirstArg = false;
+			}
+			if (!bFirstArg)
+			{
+				Out << TEXT(')');
+			}
+
+			AppendSuccessors(NodeIndex);
+		}
+
+		void AppendSuccessors(int32 NodeIndex)
+		{
+			Walker.GetExecOutputs(NodeIndex, ExecPins);
+			for (const int32 ExecPin : ExecPins)
+			{
+				const int32 NextNode = Graph.GetFirstLinkedNode(Graph.Pins[ExecPin]);
+				if (NextNode == INDEX_NONE)
+					continue;
+
+				if (ExecPins.Num() > 1)
+				{
+					Out << TEXT(' ') << Graph.Pins[ExecPin].Name << TEXT("->") << NextNode;
+				}
+				else
+				{
+					Out << TEXT(" -> ") << NextNode;
+				}
+			}
+			Out << TEXT('\n');
+		}
+
+		void BackReference(int32 NodeIndex, int32 Depth) {}
+		void BranchLabel(int32 PinIndex, int32 Depth) {}
+
+		void DepthLimit(int32 Depth)
+		{
+			Out << TEXT("...\n");
+		}
+	};
+
+	TArray<int32, TInlineAllocator<4>> ExecPins;
+	for (const FBlueprintIRGraph& Graph : IR.Graphs)
+	{
+		if (Graph.Kind != EBlueprintIRGraphKind::EventGraph && Graph.Kind != EBlueprintIRGraphKind::Function)
+			continue;
+
+		Out << TEXT("G ") << Graph.Name << TEXT('\n');
+
+		FBlueprintExecutionFlowWalker Walker(Graph);
+		FCompactVisitor Visitor{Walker, Graph, Out, Settings.bIncludePinValues};
+		for (const int32 EntryIndex : Graph.EntryNodes)
+		{
+			Out << TEXT("E ") << Graph.Nodes[EntryIndex].Title;
+			Visitor.AppendSuccessors(EntryIndex);
+
+			Walker.GetExecOutputs(EntryIndex, ExecPins);
+			for (const int32 ExecPin : ExecPins)
+			{
+				Walker.Walk(ExecPin, 1, Settings.MaxExecutionFlowDepth, Visitor);
+			}
+		}
+	}
+
+	// C Name:Class Prop=Value Prop=Value
+	for (const FBlueprintIRComponent& Component : IR.Components)
+	{
+		Out << TEXT("C ") << Component.Name << TEXT(':') << Component.ClassName;
+		if (Settings.ComponentDetailLevel != FBlueprintDocumentationSettings::EComponentDetailLevel::Minimal)
+		{
+			const bool bFull = Settings.ComponentDetailLevel ==
+				FBlueprintDocumentationSettings::EComponentDetailLevel::Full;
+			const int32 First = bFull ? Component.FirstProperty : Component.FirstImportantProperty;
+			const int32 Num = bFull ? Component.NumProperties : Component.NumImportantProperties;
+			for (int32 PropIndex = First; PropIndex < First + Num; ++PropIndex)
+			{
+				const FBlueprintIRProperty& Property = IR.Properties[PropIndex];
+				Out << TEXT(' ') << Property.Name << TEXT('=') << Property.Value;
+			}
+		}
+		Out << TEXT('\n');
+	}
+
+	for (const FBlueprintIRGraph& Graph : IR.Graphs)
+	{
+		for (const FString& Comment : Graph.Comments)
+		{
+			Out << TEXT("# [") << Graph.Name << TEXT("] ") << Comment << TEXT('\n');
+		}
+	}
+}
+
+// JSON renderer
+
+void FBlueprintIRJsonRenderer::Render(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+                                      FPromptWriter& Out) const
+{
+	// TJsonWriter can only target an FString or an archive; export is not on the prompt path
+	FString OutText;
+	const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutText);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("name"), IR.BlueprintName);
+	Writer->WriteValue(TEXT("parentClass"), IR.ParentClassName);
+
+	Writer->WriteArrayStart(TEXT("variables"));
+	for (const FBlueprintIRVariable& Variable : IR.Variables)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Variable.Name.ToString());
+		Writer->WriteValue(TEXT("type"), Variable.Category.ToString());
+		Writer->WriteArrayStart(TEXT("usages"));
+		for (int32 UsageIndex = Variable.FirstUsage; UsageIndex < Variable.FirstUsage + Variable.NumUsages; ++UsageIndex)
+		{
+			const FBlueprintIRVariableUsage& Usage = IR.VariableUsages[UsageIndex];
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("graph"), Usage.Graph);
+			Writer->WriteValue(TEXT("node"), Usage.Node);
+			Writer->WriteValue(TEXT("write"), Usage.bIsWrite);
+			Writer->WriteValue(TEXT("context"), Usage.ExecContext);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteArrayStart(TEXT("graphs"));
+	for (const FBlueprintIRGraph& Graph : IR.Graphs)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Graph.Name);
+		Writer->WriteValue(TEXT("kind"), LexGraphKind(Graph.Kind));
+
+		Writer->WriteArrayStart(TEXT("nodes"));
+		for (const FBlueprintIRNode& Node : Graph.Nodes)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("guid"), Node.Guid.ToString());
+			Writer->WriteValue(TEXT("title"), Node.Title);
+			Writer->WriteValue(TEXT("kind"), LexNodeKind(Node.Kind));
+			if (!Node.VariableName.IsNone())
+			{
+				Writer->WriteValue(TEXT("variable"), Node.VariableName.ToString());
+			}
+			Writer->WriteValue(TEXT("firstPin"), Node.FirstPin);
+			Writer->WriteValue(TEXT("numPins"), Node.NumPins);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("pins"));
+		for (const FBlueprintIRPin& Pin : Graph.Pins)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("name"), Pin.Name.ToString());
+			Writer->WriteValue(TEXT("category"), Pin.Category.ToString());
+			Writer->WriteValue(TEXT("node"), Pin.Node);
+			Writer->WriteValue(TEXT("input"), Pin.bIsInput);
+			if (!Pin.DefaultValue.IsEmpty())
+			{
+				Writer->WriteValue(TEXT("default"), Pin.DefaultValue);
+			}
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		// Only emit each link once, from its output side
+		Writer->WriteArrayStart(TEXT("edges"));
+		for (const FBlueprintIREdge& Edge : Graph.Edges)
+		{
+			if (Graph.Pins[Edge.FromPin].bIsInput)
+				continue;
+
+			Writer->WriteArrayStart();
+			Writer->WriteValue(Edge.FromPin);
+			Writer->WriteValue(Edge.ToPin);
+			Writer->WriteArrayEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("comments"));
+		for (const FString& Comment : Graph.Comments)
+		{
+			Writer->WriteValue(Comment);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteArrayStart(TEXT("components"));
+	for (const FBlueprintIRComponent& Component : IR.Components)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Component.Name);
+		Writer->WriteValue(TEXT("class"), Component.ClassName);
+		Writer->WriteObjectStart(TEXT("properties"));
+		for (int32 PropIndex = Component.FirstImportantProperty;
+		     PropIndex < Component.FirstImportantProperty + Component.NumImportantProperties; ++PropIndex)
+		{
+			Writer->WriteValue(IR.Properties[PropIndex].Name, IR.Properties[PropIndex].Value);
+		}
+		for (int32 PropIndex = Component.FirstProperty;
+		     PropIndex < Component.FirstProperty + Component.NumProperties; ++PropIndex)
+		{
+			Writer->WriteValue(IR.Properties[PropIndex].Name, IR.Properties[PropIndex].Value);
+		}
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	Out << OutText;
+}
+
+// Diff
+
+void FBlueprintIRDiff::Render(const FBlueprintIR& OldIR, const FBlueprintIR& NewIR, FString& OutText)
+{
+	if (OldIR.ParentClassName != NewIR.ParentClassName)
+	{
+		OutText += FString::Printf(TEXT("~ Parent Class: %s -> %s\n"), *OldIR.ParentClassName, *NewIR.ParentClassName);
+	}
+
+	// Variables
+	TSet<FName> OldVariables;
+	for (const FBlueprintIRVariable& Variable : OldIR.Variables)
+	{
+		OldVariables.Add(Variable.Name);
+	}
+	for (const FBlueprintIRVariable& Variable : NewIR.Variables)
+	{
+		if (OldVariables.Remove(Variable.Name) == 0)
+		{
+			OutText += FString::Printf(TEXT("+ Variable %s (%s)\n"), *Variable.Name.ToString(),
+			                           *Variable.Category.ToString());
+		}
+	}
+	for (const FName& Removed : OldVariables)
+	{
+		OutText += FString::Printf(TEXT("- Variable %s\n"), *Removed.ToString());
+	}
+
+	// Graphs
+	TMap<FString, const FBlueprintIRGraph*> OldGraphs;
+	for (const FBlueprintIRGraph& Graph : OldIR.Graphs)
+	{
+		OldGraphs.Add(Graph.Name, &Graph);
+	}
+	for (const FBlueprintIRGraph& Graph : NewIR.Graphs)
+	{
+		const FBlueprintIRGraph* OldGraph = nullptr;
+		if (OldGraphs.RemoveAndCopyValue(Graph.Name, OldGraph))
+		{
+			DiffGraph(*OldGraph, Graph, OutText);
+		}
+		else
+		{
+			OutText += FString::Printf(TEXT("+ Graph %s (%d nodes)\n"), *Graph.Name, Graph.Nodes.Num());
+		}
+	}
+	for (const TPair<FString, const FBlueprintIRGraph*>& Removed : OldGraphs)
+	{
+		OutText += FString::Printf(TEXT("- Graph %s\n"), *Removed.Key);
+	}
+
+	// Components
+	TMap<FString, const FBlueprintIRComponent*> OldComponents;
+	for (const FBlueprintIRComponent& Component : OldIR.Components)
+	{
+		OldComponents.Add(Component.Name, &Component);
+	}
+	for (const FBlueprintIRComponent& Component : NewIR.Components)
+	{
+		const FBlueprintIRComponent* OldComponent = nullptr;
+		if (!OldComponents.RemoveAndCopyValue(Component.Name, OldComponent))
+		{
+			OutText += FString::Printf(TEXT("+ Component %s (%s)\n"), *Component.Name, *Component.ClassName);
+			continue;
+		}
+
+		auto CollectProperties = [](const FBlueprintIR& IR, const FBlueprintIRComponent& Comp)
+		{
+			TMap<FString, FString> Properties;
+			for (int32 Index = Comp.FirstImportantProperty; Index < Comp.FirstImportantProperty + Comp.NumImportantProperties; ++Index)
+			{
+				Properties.Add(IR.Properties[Index].Name, IR.Properties[Index].Value);
+			}
+			for (int32 Index = Comp.FirstProperty; Index < Comp.FirstProperty + Comp.NumProperties; ++Index)
+			{
+				Properties.Add(IR.Properties[Index].Name, IR.Properties[Index].Value);
+			}
+			return Properties;
+		};
+
+		const TMap<FString, FString> OldProperties = CollectProperties(OldIR, *OldComponent);
+		const TMap<FString, FString> NewProperties = CollectProperties(NewIR, Component);
+		for (const TPair<FString, FString>& Property : NewProperties)
+		{
+			const FString* OldValue = OldProperties.Find(Property.Key);
+			if (!OldValue || *OldValue != Property.Value)
+			{
+				OutText += FString::Printf(TEXT("~ Component %s.%s = %s\n"), *Component.Name, *Property.Key,
+				                           *Property.Value);
+			}
+		}
+	}
+	for (const TPair<FString, const FBlueprintIRComponent*>& Removed : OldComponents)
+	{
+		OutText += FString::Printf(TEXT("- Component %s\n"), *Removed.Key);
+	}
+}
+
+void FBlueprintIRDiff::DiffGraph(const FBlueprintIRGraph& OldGraph, const FBlueprintIRGraph& NewGraph,
+                                 FString& OutText)
+{
+	TMap<FGuid, int32> OldNodes;
+	for (int32 NodeIndex = 0; NodeIndex < OldGraph.Nodes.Num(); ++NodeIndex)
+	{
+		OldNodes.Add(OldGraph.Nodes[NodeIndex].Guid, NodeIndex);
+	}
+
+	for (const FBlueprintIRNode& Node : NewGraph.Nodes)
+	{
+		int32 OldNodeIndex = INDEX_NONE;
+		if (!OldNodes.RemoveAndCopyValue(Node.Guid, OldNodeIndex))
+		{
+			OutText += FString::Printf(TEXT("+ [%s] %s\n"), *NewGraph.Name, *Node.Title);
+		}
+		else if (NodesDiffer(OldGraph, OldGraph.Nodes[OldNodeIndex], NewGraph, Node))
+		{
+			OutText += FString::Printf(TEXT("~ [%s] %s\n"), *NewGraph.Name, *Node.Title);
+		}
+	}
+
+	for (const TPair<FGuid, int32>& Removed : OldNodes)
+	{
+		OutText += FString::Printf(TEXT("- [%s] %s\n"), *OldGraph.Name, *OldGraph.Nodes[Removed.Value].Title);
+	}
+}
+
+bool FBlueprintIRDiff::NodesDiffer(const FBlueprintIRGraph& OldGraph, const FBlueprintIRNode& OldNode,
+                                   const FBlueprintIRGraph& NewGraph, const FBlueprintIRNode& NewNode)
+{
+	if (OldNode.Title != NewNode.Title || OldNode.NumPins != NewNode.NumPins)
+		return true;
+
+	for (int32 PinIndex = 0; PinIndex < NewNode.NumPins; ++PinIndex)
+	{
+		const FBlueprintIRPin& OldPin = OldGraph.GetPin(OldNode, PinIndex);
+		const FBlueprintIRPin& NewPin = NewGraph.GetPin(NewNode, PinIndex);
+		if (OldPin.Name != NewPin.Name || OldPin.DefaultValue != NewPin.DefaultValue ||
+			OldPin.NumEdges != NewPin.NumEdges)
+		{
+			return true;
+		}
+
+		// Links are compared by the GUID and pin name on the other end, since indices shift between captures
+		for (int32 EdgeOffset = 0; EdgeOffset < NewPin.NumEdges; ++EdgeOffset)
+		{
+			const FBlueprintIRPin& OldTarget = OldGraph.Pins[OldGraph.Edges[OldPin.FirstEdge + EdgeOffset].ToPin];
+			const FBlueprintIRPin& NewTarget = NewGraph.Pins[NewGraph.Edges[NewPin.FirstEdge + EdgeOffset].ToPin];
+			if (OldTarget.Name != NewTarget.Name ||
+				OldGraph.Nodes[OldTarget.Node].Guid != NewGraph.Nodes[NewTarget.Node].Guid)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
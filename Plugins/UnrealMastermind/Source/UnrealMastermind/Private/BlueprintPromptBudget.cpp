@@ -0,0 +1,124 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintPromptBudget.h"
+#include "BlueprintIRRenderer.h"
+#include "LLMTokenizer.h"
+
+namespace
+{
+	constexpr int32 BytesPerToken = 4;
+	const UTF8CHAR* TruncationMarker = UTF8TEXT("\n... (truncated to fit the prompt budget)\n");
+}
+
+FString FBlueprintPromptBudgetReport::ToString() const
+{
+	FString Text = FString::Printf(TEXT("Blueprint info reduced from ~%d to ~%d tokens (budget %d)"),
+	                               InitialTokens, FinalTokens, TokenBudget);
+	for (const FString& Reduction : Reductions)
+	{
+		Text += TEXT("\n- ") + Reduction;
+	}
+	if (bTruncated)
+	{
+		Text += TEXT("\n- Truncated the remainder");
+	}
+	return Text;
+}
+
+int32 FBlueprintPromptBudget::EstimateTokens(FUtf8StringView Text)
+{
+	if (const TSharedPtr<const FLLMTokenizer> Tokenizer = FLLMTokenizer::GetConfigured())
+		return Tokenizer->CountTokens(Text);
+	return (Text.Len() + BytesPerToken - 1) / BytesPerToken;
+}
+
+int32 FBlueprintPromptBudget::EstimateTokens(FStringView Text)
+{
+	const FTCHARToUTF8 Utf8(Text.GetData(), Text.Len());
+	return EstimateTokens(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.Get()), Utf8.Length()));
+}
+
+bool FBlueprintPromptBudget::HasTokenizer()
+{
+	return FLLMTokenizer::GetConfigured().IsValid();
+}
+
+FBlueprintPromptBudgetReport FBlueprintPromptBudget::Render(FName Format, const FBlueprintIR& IR,
+                                                            const FBlueprintDocumentationSettings& Settings,
+                                                            int32 TokenBudget, FPromptWriter& Out)
+{
+	FBlueprintPromptBudgetReport Report;
+	Report.TokenBudget = TokenBudget;
+
+	FBlueprintDocumentationSettings Reduced = Settings;
+	const int32 Start = Out.Len();
+
+	auto RenderTokens = [&]()
+	{
+		Out.Truncate(Start);
+		FBlueprintIRRendererRegistry::Render(Format, IR, Reduced, Out);
+		return EstimateTokens(Out.ToView().RightChop(Start));
+	};
+
+	int32 Tokens = RenderTokens();
+	Report.InitialTokens = Tokens;
+
+	// 1. Literal pin values
+	if (Tokens > TokenBudget && Reduced.bIncludePinValues)
+	{
+		Reduced.bIncludePinValues = false;
+		Tokens = RenderTokens();
+		Report.Reductions.Add(TEXT("Removed literal input values"));
+	}
+
+	// 2. Deep execution flows, halving the depth each time
+	if (Tokens > TokenBudget && Reduced.MaxExecutionFlowDepth > 1)
+	{
+		while (Tokens > TokenBudget && Reduced.MaxExecutionFlowDepth > 1)
+		{
+			Reduced.MaxExecutionFlowDepth /= 2;
+			Tokens = RenderTokens();
+		}
+		Report.Reductions.Add(FString::Printf(TEXT("Limited execution flows to depth %d (was %d)"),
+		                                      Reduced.MaxExecutionFlowDepth, Settings.MaxExecutionFlowDepth));
+	}
+
+	// 3. Component properties beyond the key ones
+	if (Tokens > TokenBudget &&
+		Reduced.ComponentDetailLevel == FBlueprintDocumentationSettings::EComponentDetailLevel::Full)
+	{
+		Reduced.ComponentDetailLevel = FBlueprintDocumentationSettings::EComponentDetailLevel::Basic;
+		Tokens = RenderTokens();
+		Report.Reductions.Add(TEXT("Reduced component detail to Basic"));
+	}
+
+	// 4. Unused variables
+	if (Tokens > TokenBudget && !Reduced.bSummarizeUnusedVariables)
+	{
+		Reduced.bSummarizeUnusedVariables = true;
+		Tokens = RenderTokens();
+		Report.Reductions.Add(TEXT("Listed unused variables by name only"));
+	}
+
+	// Last resort: keep the prompt bounded no matter what
+	if (Tokens > TokenBudget)
+	{
+		const FUtf8StringView Marker(TruncationMarker);
+		const int32 MaxTextTokens = FMath::Max(TokenBudget - EstimateTokens(Marker), 0);
+
+		// Text isn't equally dense throughout, so cutting in proportion to the excess can take a few rounds
+		int32 KeptBytes = Out.Len() - Start;
+		while (Tokens > MaxTextTokens && KeptBytes > 0)
+		{
+			Out.Truncate(Start + static_cast<int32>(static_cast<int64>(KeptBytes) * MaxTextTokens / Tokens));
+			KeptBytes = Out.Len() - Start;
+			Tokens = EstimateTokens(Out.ToView().RightChop(Start));
+		}
+		Out << Marker;
+		Tokens = EstimateTokens(Out.ToView().RightChop(Start));
+		Report.bTruncated = true;
+	}
+
+	Report.FinalTokens = Tokens;
+	return Report;
+}
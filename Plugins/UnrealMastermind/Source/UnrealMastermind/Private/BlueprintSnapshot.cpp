@@ -0,0 +1,97 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "BlueprintSnapshot.h"
+#include "Engine/Blueprint.h"
+#include "UObject/UObjectGlobals.h"
+
+FBlueprintSnapshotTask::FBlueprintSnapshotTask(UBlueprint* InBlueprint,
+                                               const FBlueprintDocumentationSettings& InSettings,
+                                               float InFrameBudgetMs)
+	: Blueprint(InBlueprint)
+	, Settings(InSettings)
+	, FrameBudgetSeconds(FMath::Max(InFrameBudgetMs, 0.1f) / 1000.0)
+{
+}
+
+FBlueprintSnapshotTask::~FBlueprintSnapshotTask()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+}
+
+void FBlueprintSnapshotTask::Start(FOnComplete InOnComplete, FOnProgress InOnProgress)
+{
+	check(IsInGameThread());
+	check(!IsRunning());
+
+	OnComplete = MoveTemp(InOnComplete);
+	OnProgress = MoveTemp(InOnProgress);
+	Builder.Reset();
+	bRestartRequested = false;
+
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddSP(
+		this, &FBlueprintSnapshotTask::OnObjectModified);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &FBlueprintSnapshotTask::Tick));
+}
+
+void FBlueprintSnapshotTask::Cancel()
+{
+	if (IsRunning())
+	{
+		Complete(nullptr);
+	}
+}
+
+bool FBlueprintSnapshotTask::Tick(float DeltaTime)
+{
+	UBlueprint* BlueprintPtr = Blueprint.Get();
+	if (!BlueprintPtr)
+	{
+		Complete(nullptr);
+		return false;
+	}
+
+	// Steps captured before an edit may reference nodes that no longer exist, so begin again
+	if (!Builder.IsValid() || bRestartRequested)
+	{
+		Builder = MakeUnique<FBlueprintIRBuilder>(BlueprintPtr, Settings);
+		bRestartRequested = false;
+	}
+
+	if (!Builder->Step(FrameBudgetSeconds))
+	{
+		OnProgress.ExecuteIfBound(Builder->GetProgress());
+		return true;
+	}
+
+	Complete(MakeShared<const FBlueprintIR>(Builder->Finish()));
+	return false;
+}
+
+void FBlueprintSnapshotTask::OnObjectModified(UObject* Object)
+{
+	const UBlueprint* BlueprintPtr = Blueprint.Get();
+	if (Builder.IsValid() && BlueprintPtr && (Object == BlueprintPtr || Object->IsIn(BlueprintPtr)))
+	{
+		bRestartRequested = true;
+	}
+}
+
+void FBlueprintSnapshotTask::Complete(TSharedPtr<const FBlueprintIR> Snapshot)
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	ObjectModifiedHandle.Reset();
+	Builder.Reset();
+
+	// The callback may release the last reference to this task
+	const TSharedRef<FBlueprintSnapshotTask> KeepAlive = AsShared();
+	FOnComplete Callback = MoveTemp(OnComplete);
+	OnProgress.Unbind();
+	Callback.ExecuteIfBound(MoveTemp(Snapshot));
+}
@@ -0,0 +1,151 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "ComponentPropertyPlan.h"
+#include "Components/ActorComponent.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+
+FPropertyPrefixTrie::FPropertyPrefixTrie()
+{
+	Nodes.AddDefaulted();
+}
+
+FPropertyPrefixTrie::FPropertyPrefixTrie(const TArray<FString>& Prefixes)
+	: FPropertyPrefixTrie()
+{
+	for (const FString& Prefix : Prefixes)
+	{
+		if (Prefix.IsEmpty())
+			continue;
+
+		int32 NodeIndex = 0;
+		for (const TCHAR Char : Prefix)
+		{
+			// Case-insensitive, like FString::StartsWith
+			const TCHAR Lower = FChar::ToLower(Char);
+			int32 ChildIndex = FindChild(NodeIndex, Lower);
+			if (ChildIndex == INDEX_NONE)
+			{
+				ChildIndex = Nodes.AddDefaulted();
+				Nodes[NodeIndex].Children.Emplace(Lower, ChildIndex);
+			}
+			NodeIndex = ChildIndex;
+		}
+
+		Nodes[NodeIndex].bIsTerminal = true;
+	}
+}
+
+int32 FPropertyPrefixTrie::FindChild(int32 NodeIndex, TCHAR Char) const
+{
+	for (const TPair<TCHAR, int32>& Child : Nodes[NodeIndex].Children)
+	{
+		if (Child.Key == Char)
+			return Child.Value;
+	}
+	return INDEX_NONE;
+}
+
+bool FPropertyPrefixTrie::MatchesAnyPrefix(FStringView Name) const
+{
+	int32 NodeIndex = 0;
+	for (const TCHAR Char : Name)
+	{
+		NodeIndex = FindChild(NodeIndex, FChar::ToLower(Char));
+		if (NodeIndex == INDEX_NONE)
+			return false;
+
+		if (Nodes[NodeIndex].bIsTerminal)
+			return true;
+	}
+	return false;
+}
+
+FComponentPropertyPlanCache& FComponentPropertyPlanCache::Get()
+{
+	static FComponentPropertyPlanCache Cache;
+	return Cache;
+}
+
+void FComponentPropertyPlanCache::Initialize()
+{
+	ReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(
+		this, &FComponentPropertyPlanCache::OnObjectsReinstanced);
+}
+
+void FComponentPropertyPlanCache::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ReinstancedHandle);
+	ReinstancedHandle.Reset();
+	Reset();
+}
+
+void FComponentPropertyPlanCache::OnObjectsReinstanced(const FCoreUObjectDelegates::FReplacementObjectMap&)
+{
+	// Recompiled component classes get new property layouts
+	Reset();
+}
+
+void FComponentPropertyPlanCache::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Plans.Reset();
+}
+
+TSharedRef<const FComponentPropertyPlan> FComponentPropertyPlanCache::GetPlan(const UClass* ComponentClass,
+                                                                             const TArray<FString>& IgnoredPrefixes)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (IgnoredPrefixes != CachedPrefixes)
+	{
+		CachedPrefixes = IgnoredPrefixes;
+		PrefixTrie = FPropertyPrefixTrie(IgnoredPrefixes);
+		Plans.Reset();
+	}
+
+	if (const TSharedRef<const FComponentPropertyPlan>* Plan = Plans.Find(FObjectKey(ComponentClass)))
+	{
+		return *Plan;
+	}
+
+	return Plans.Add(FObjectKey(ComponentClass), BuildPlan(ComponentClass));
+}
+
+TSharedRef<const FComponentPropertyPlan> FComponentPropertyPlanCache::BuildPlan(const UClass* ComponentClass) const
+{
+	const TSharedRef<FComponentPropertyPlan> Plan = MakeShared<FComponentPropertyPlan>();
+
+	// Only add the most important properties
+	static const FName ImportantProps[] = {
+		"RelativeLocation",
+		"RelativeRotation",
+		"RelativeScale3D",
+		"AttachParent",
+		"Mobility"
+	};
+
+	for (const FName PropName : ImportantProps)
+	{
+		if (const FProperty* Property = ComponentClass->FindPropertyByName(PropName))
+		{
+			Plan->ImportantProperties.Add(Property);
+		}
+	}
+
+	TCHAR NameBuffer[NAME_SIZE];
+	for (TFieldIterator<FProperty> PropIt(ComponentClass); PropIt; ++PropIt)
+	{
+		const FProperty* Property = *PropIt;
+		if (Property->HasAnyPropertyFlags(CPF_Deprecated | CPF_Transient))
+			continue;
+
+		const uint32 NameLen = Property->GetFName().ToString(NameBuffer);
+		if (PrefixTrie.MatchesAnyPrefix(FStringView(NameBuffer, NameLen)))
+			continue;
+
+		Plan->Properties.Add(Property);
+	}
+
+	return Plan;
+}
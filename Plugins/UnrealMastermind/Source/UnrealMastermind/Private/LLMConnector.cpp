@@ -1,446 +1,831 @@
 // Copyright 2025 © Froströk. All Rights Reserved.
 
 #include "LLMConnector.h"
-#include "HttpModule.h"
+#include "UnrealMastermind.h"
 #include "UnrealMastermindSettings.h"
+#include "BlueprintPromptBudget.h"
+#include "PromptWriter.h"
+#include "Async/Async.h"
 #include "Interfaces/IHttpResponse.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
-#include "Dom/JsonObject.h"
+#include "Misc/ScopeLock.h"
 
-ULLMConnector::ULLMConnector()
+DEFINE_LOG_CATEGORY(LogUnrealMastermindLLM);
+
+namespace
 {
-	RequestTimeout = 60.0f;
-	bRequestComplete = false;
-	Result = TEXT("");
+	// How long recent requests took to start answering, per provider and for streamed and complete
+	// responses apart, so a request can be hedged once it is slower than most
+	class FFirstByteLatencies
+	{
+	public:
+		static FFirstByteLatencies& Get()
+		{
+			static FFirstByteLatencies Latencies;
+			return Latencies;
+		}
+
+		void Add(ELLMProvider Provider, bool bStream, double Seconds)
+		{
+			FScopeLock ScopeLock(&Lock);
+			FSamples& ProviderSamples = Samples.FindOrAdd(MakeTuple(Provider, bStream));
+			if (ProviderSamples.Seconds.Num() < MaxSamples)
+			{
+				ProviderSamples.Seconds.Add(Seconds);
+			}
+			else
+			{
+				ProviderSamples.Seconds[ProviderSamples.Next] = Seconds;
+			}
+			ProviderSamples.Next = (ProviderSamples.Next + 1) % MaxSamples;
+		}
+
+		// DefaultSeconds until enough requests were timed for the percentile to mean anything
+		double GetPercentile(ELLMProvider Provider, bool bStream, float Percentile, double DefaultSeconds) const
+		{
+			TArray<double, TInlineAllocator<MaxSamples>> Sorted;
+			{
+				FScopeLock ScopeLock(&Lock);
+				if (const FSamples* ProviderSamples = Samples.Find(MakeTuple(Provider, bStream)))
+				{
+					Sorted.Append(ProviderSamples->Seconds);
+				}
+			}
+
+			if (Sorted.Num() < MinSamples)
+				return DefaultSeconds;
+
+			Sorted.Sort();
+			const int32 Index = FMath::CeilToInt(Percentile / 100.0f * Sorted.Num()) - 1;
+			return Sorted[FMath::Clamp(Index, 0, Sorted.Num() - 1)];
+		}
+
+	private:
+		static constexpr int32 MaxSamples = 64;
+		static constexpr int32 MinSamples = 20;
+
+		struct FSamples
+		{
+			TArray<double> Seconds;
+			int32 Next = 0;
+		};
+
+		mutable FCriticalSection Lock;
+		TMap<TTuple<ELLMProvider, bool>, FSamples> Samples;
+	};
+
+	// How long recent responses took in total, how long they were and how much of their prompts the provider
+	// read from its prompt cache, per provider, to estimate the next one
+	class FResponseHistory
+	{
+	public:
+		struct FAverages
+		{
+			double Seconds = 0.0;
+			int32 OutputTokens = 0;
+
+			// Share of the prompt tokens read from the cache
+			double CachedInputShare = 0.0;
+		};
+
+		static FResponseHistory& Get()
+		{
+			static FResponseHistory History;
+			return History;
+		}
+
+		void Add(ELLMProvider Provider, double Seconds, const FLLMResponseFields& Fields)
+		{
+			FScopeLock ScopeLock(&Lock);
+			TArray<FResponse>& Responses = ProviderResponses.FindOrAdd(Provider);
+			if (Responses.Num() == MaxResponses)
+			{
+				Responses.RemoveAt(0, 1, EAllowShrinking::No);
+			}
+			Responses.Add({Seconds, Fields.OutputTokens, Fields.InputTokens, Fields.CachedInputTokens});
+		}
+
+		// False until the provider has answered
+		bool GetAverages(ELLMProvider Provider, FAverages& OutAverages) const
+		{
+			FScopeLock ScopeLock(&Lock);
+			const TArray<FResponse>* Responses = ProviderResponses.Find(Provider);
+			if (!Responses || Responses->Num() == 0)
+				return false;
+
+			double Seconds = 0.0;
+			int64 OutputTokens = 0;
+			int64 InputTokens = 0;
+			int64 CachedInputTokens = 0;
+			for (const FResponse& Response : *Responses)
+			{
+				Seconds += Response.Seconds;
+				OutputTokens += Response.OutputTokens;
+				InputTokens += Response.InputTokens;
+				CachedInputTokens += Response.CachedInputTokens;
+			}
+			OutAverages.Seconds = Seconds / Responses->Num();
+			OutAverages.OutputTokens = static_cast<int32>(OutputTokens / Responses->Num());
+			OutAverages.CachedInputShare = InputTokens > 0
+				                               ? FMath::Min(static_cast<double>(CachedInputTokens) / InputTokens, 1.0)
+				                               : 0.0;
+			return true;
+		}
+
+	private:
+		static constexpr int32 MaxResponses = 16;
+
+		struct FResponse
+		{
+			double Seconds;
+			int32 OutputTokens;
+			int32 InputTokens;
+			int32 CachedInputTokens;
+		};
+
+		mutable FCriticalSection Lock;
+		TMap<ELLMProvider, TArray<FResponse>> ProviderResponses;
+	};
+}
+
+FString FLLMRequestEstimate::ToString() const
+{
+	FString Text = FString::Printf(TEXT("%s%s of %s prompt tokens"), bExactTokenCount ? TEXT("") : TEXT("~"),
+	                               *FString::FormatAsNumber(InputTokens), *FString::FormatAsNumber(MaxInputTokens));
+	if (CachedInputTokens > 0)
+	{
+		Text += FString::Printf(TEXT(" (~%s cached)"), *FString::FormatAsNumber(CachedInputTokens));
+	}
+	if (Cost >= 0.0)
+	{
+		Text += FString::Printf(TEXT(" · ~$%.4f%s"), Cost, bOutputTokensMeasured ? TEXT("") : TEXT(" at most"));
+	}
+	if (Seconds >= 0.0)
+	{
+		Text += FString::Printf(TEXT(" · ~%.0f s"), Seconds);
+	}
+	return Text;
 }
 
-FString ULLMConnector::GenerateDocumentation(const FString& BlueprintInfo, const FString& CustomPrompt)
+TFuture<FString> ULLMConnector::GenerateDocumentation(FUtf8StringView BlueprintInfo, const FString& CustomPrompt,
+                                                      const FLLMRequestOptions& Options)
 {
 	// Create the prompt for the AI
-	const FString Prompt = CreatePrompt(BlueprintInfo, CustomPrompt);
+	return SendPrompt(CreatePrompt(BlueprintInfo, CustomPrompt), Options);
+}
 
-	// Get the settings
-	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+TFuture<FString> ULLMConnector::GenerateDocumentationPart(const FString& BlueprintName, const FString& PartName,
+                                                          FUtf8StringView PartInfo, const FString& CustomPrompt,
+                                                          const FLLMRequestOptions& Options)
+{
+	FPromptWriter Prompt(PartInfo.Len() + CustomPrompt.Len() + 1024);
+	Prompt << TEXT("I need you to document one part, a function or an event, of an Unreal Engine Blueprint. Explain "
+		"what it does and how it works. Be concise, this will be combined with the documentation of the other parts "
+		"of the Blueprint, so don't add an introduction or an overall summary. ");
 
-	// Call the appropriate provider
-	switch (Settings->SelectedProvider)
-	{
-	case ELLMProvider::OpenAI:
-		return GenerateWithOpenAI(Prompt);
-	case ELLMProvider::Anthropic:
-		return GenerateWithAnthropic(Prompt);
-	case ELLMProvider::Other:
-		return GenerateWithOtherProvider(Prompt);
-	default:
-		return TEXT("Error: Unknown provider selected.");
-	}
+	// Every part prompt starts the same; the names come after the shared prefix
+	const int32 PrefixLen = AppendGlossary(Prompt);
+	AppendCustomPrompt(Prompt, CustomPrompt);
+
+	Prompt << TEXT("\nThis part is ") << PartName << TEXT(" of the Blueprint ") << BlueprintName
+		<< TEXT(". Here is its information:\n\n");
+	Prompt << PartInfo;
+
+	return SendPrompt(FLLMPrompt(Prompt.MoveText(), PrefixLen), Options);
 }
 
-FString ULLMConnector::CreatePrompt(const FString& BlueprintInfo, const FString& CustomPrompt)
+TFuture<FString> ULLMConnector::CombineDocumentationParts(FUtf8StringView BlueprintOutline,
+                                                          const TArray<FString>& PartDocumentation,
+                                                          const FString& CustomPrompt,
+                                                          const FLLMRequestOptions& Options)
 {
 	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
 
-	FString Prompt = TEXT(
-		"I need you to analyze this Unreal Engine Blueprint and provide professional documentation for it. ");
+	int32 PromptSize = BlueprintOutline.Len() + CustomPrompt.Len() + 1024;
+	for (const FString& Part : PartDocumentation)
+	{
+		PromptSize += Part.Len() + 5;
+	}
+
+	FPromptWriter Prompt(PromptSize);
+	Prompt << TEXT(
+		"I need you to write the professional documentation of an Unreal Engine Blueprint. Each of its functions "
+		"and events has already been documented separately; combine these parts into one consistent document. ");
 
-	// Add settings-based instructions
 	if (Settings->bIncludeOverallSummary)
 	{
-		Prompt += TEXT("Include an overall summary of what this Blueprint does. ");
+		Prompt << TEXT("Include an overall summary of what this Blueprint does. ");
 	}
 
 	if (Settings->bIncludeVariableDescriptions)
 	{
-		Prompt += TEXT("Provide descriptions for each variable and its purpose. ");
+		Prompt << TEXT("Provide descriptions for each variable and its purpose. ");
 	}
 
 	if (Settings->bIncludeFunctionBreakdowns)
 	{
-		Prompt += TEXT("Break down each function and explain what it does. ");
+		Prompt << TEXT("Break down each function and explain what it does. ");
 	}
 
-	// Add custom prompt if provided
-	if (!CustomPrompt.IsEmpty())
+	const int32 PrefixLen = AppendGlossary(Prompt);
+	AppendCustomPrompt(Prompt, CustomPrompt);
+
+	Prompt << TEXT("\nHere is the outline of the Blueprint:\n\n");
+	Prompt << BlueprintOutline;
+
+	Prompt << TEXT("\n\nHere is the documentation of each part:\n");
+	for (const FString& Part : PartDocumentation)
 	{
-		Prompt += TEXT("\nAdditional instructions: ") + CustomPrompt + TEXT("\n\n");
+		Prompt << TEXT("\n---\n");
+		Prompt << Part;
 	}
 
-	// Add the Blueprint info
-	Prompt += TEXT("\nHere is the Blueprint information:\n\n");
-	Prompt += BlueprintInfo;
+	return SendPrompt(FLLMPrompt(Prompt.MoveText(), PrefixLen), Options);
+}
 
-	return Prompt;
+TFuture<FString> ULLMConnector::SendPrompt(const FLLMPrompt& Prompt, const FLLMRequestOptions& Options)
+{
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	if (!Settings->bUseResponseCache)
+	{
+		return SendPromptToProvider(Prompt, Options).Next([](FProviderResult Answer)
+		{
+			return MoveTemp(Answer.Result);
+		});
+	}
+
+	// Checked before anything is sent, so unchanged Blueprints cost no round trip at all
+	const FString CacheKey = MakeCacheKey(Prompt, Settings->SelectedProvider, FString());
+	FString CachedResponse;
+	if (Options.CachePolicy == ELLMCachePolicy::Use && FLLMResponseCache::Get().Find(CacheKey, CachedResponse))
+	{
+		return MakeFulfilledPromise<FString>(MoveTemp(CachedResponse)).GetFuture();
+	}
+
+	// An answer from the hedge provider is kept under its own key, never passed off as the primary's
+	const int64 MaxCacheSize = static_cast<int64>(Settings->ResponseCacheSizeMB) * 1024 * 1024;
+	return SendPromptToProvider(Prompt, Options).Next(
+		[Prompt, CacheKey, SelectedProvider = Settings->SelectedProvider, MaxCacheSize](FProviderResult Answer)
+		{
+			if (!Answer.Result.StartsWith(TEXT("Error:")))
+			{
+				const bool bSelected = Answer.Provider == SelectedProvider && Answer.Model.IsEmpty();
+				FLLMResponseCache::Get().Store(
+					bSelected ? CacheKey : MakeCacheKey(Prompt, Answer.Provider, Answer.Model), Answer.Result,
+					MaxCacheSize);
+			}
+			return MoveTemp(Answer.Result);
+		});
 }
 
-FString ULLMConnector::GenerateWithOpenAI(const FString& Prompt)
+FString ULLMConnector::MakeCacheKey(const FLLMPrompt& Prompt, ELLMProvider ProviderId, const FString& Model)
 {
 	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
-	const FString ApiKey = Settings->OpenAIApiKey;
-	const FString Model = Settings->OpenAIModel;
 
-	if (ApiKey.IsEmpty())
+	FString Endpoint;
+	FString KeyModel = Model;
+	if (const TSharedPtr<const ILLMProvider> Provider = FLLMProviderRegistry::Get().Find(ProviderId))
 	{
-		return TEXT("Error: OpenAI API key not provided. Please enter your API key in the plugin settings.");
+		Endpoint = Provider->GetEndpoint();
+		if (KeyModel.IsEmpty())
+		{
+			KeyModel = Provider->GetDefaultModel();
+		}
 	}
 
-	// Create the JSON request
-	const TSharedPtr<FJsonObject> RequestJsonObject = MakeShareable(new FJsonObject);
-	RequestJsonObject->SetStringField(TEXT("model"), Model);
+	return FLLMResponseCache::MakeKey(ProviderId, Endpoint, KeyModel, Settings->SystemPrompt, Settings->Temperature,
+	                                  Settings->MaxTokens, Prompt.GetView());
+}
 
-	TArray<TSharedPtr<FJsonValue>> MessagesArray;
+TFuture<ULLMConnector::FProviderResult> ULLMConnector::SendPromptToProvider(const FLLMPrompt& Prompt,
+                                                                            const FLLMRequestOptions& Options)
+{
+	// Get the settings
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
 
-	// System message
-	const TSharedPtr<FJsonObject> SystemMessageObject = MakeShareable(new FJsonObject);
-	SystemMessageObject->SetStringField(TEXT("role"), TEXT("system"));
-	SystemMessageObject->SetStringField(TEXT("content"), Settings->SystemPrompt);
-	MessagesArray.Add(MakeShareable(new FJsonValueObject(SystemMessageObject)));
+	FLLMRequestOptions ProviderOptions = Options;
+	if (!Settings->bStreamResponses)
+	{
+		ProviderOptions.OnTextReceived = nullptr;
+	}
 
-	// User message with the prompt
-	const TSharedPtr<FJsonObject> UserMessageObject = MakeShareable(new FJsonObject);
-	UserMessageObject->SetStringField(TEXT("role"), TEXT("user"));
-	UserMessageObject->SetStringField(TEXT("content"), Prompt);
+	if (Settings->bHedgeRequests)
+	{
+		return SendHedged(Prompt, ProviderOptions);
+	}
+	return SendToSelectedProvider(Prompt, ProviderOptions);
+}
 
-	MessagesArray.Add(MakeShareable(new FJsonValueObject(UserMessageObject)));
+TFuture<ULLMConnector::FProviderResult> ULLMConnector::SendToSelectedProvider(const FLLMPrompt& Prompt,
+                                                                              const FLLMRequestOptions& Options)
+{
+	const ELLMProvider ProviderId = GetDefault<UUnrealMastermindSettings>()->SelectedProvider;
+	return SendToProvider(ProviderId, FString(), Prompt, Options).Next([ProviderId](FString Result)
+	{
+		return FProviderResult{MoveTemp(Result), ProviderId, FString()};
+	});
+}
 
-	RequestJsonObject->SetArrayField(TEXT("messages"), MessagesArray);
-	RequestJsonObject->SetNumberField(TEXT("max_tokens"), Settings->MaxTokens);
-	RequestJsonObject->SetNumberField(TEXT("temperature"), Settings->Temperature);
+TFuture<FString> ULLMConnector::SendToProvider(
+	ELLMProvider ProviderId, const FString& Model, const FLLMPrompt& Prompt, const FLLMRequestOptions& Options,
+	TFunction<void(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>&)> OnRequestCreated,
+	FLLMRequestScheduler::FAttemptCallbacks Callbacks)
+{
+	const TSharedPtr<const ILLMProvider> Provider = FLLMProviderRegistry::Get().Find(ProviderId);
+	if (!Provider.IsValid())
+	{
+		return MakeFulfilledPromise<FString>(TEXT("Error: Unknown provider selected.")).GetFuture();
+	}
+
+	const FString ConfigurationError = Provider->GetConfigurationError();
+	if (!ConfigurationError.IsEmpty())
+	{
+		return MakeFulfilledPromise<FString>(ConfigurationError).GetFuture();
+	}
+
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
 
-	// Convert to string
-	FString RequestBody;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(RequestJsonObject.ToSharedRef(), Writer);
+	// A prompt the model can't take would only come back as an error, after a round trip and the wait for a slot
+	const int32 InputTokens = CountInputTokens(Prompt);
+	const int32 MaxInputTokens = Settings->GetMaxInputTokens(ProviderId);
+	if (InputTokens > MaxInputTokens)
+	{
+		return MakeFulfilledPromise<FString>(FString::Printf(
+			TEXT("Error: The prompt is %d tokens, more than the %d allowed for %s. Shorten the custom prompt or the "
+				"system prompt, or raise Max Input Tokens in the plugin settings if the model accepts more."),
+			InputTokens, MaxInputTokens, *UEnum::GetDisplayValueAsText(ProviderId).ToString())).GetFuture();
+	}
 
-	// Create the HTTP request
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Settings->OpenAIEndpoint);
-	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
-	HttpRequest->SetContentAsString(RequestBody);
+	FLLMProviderRequest Request;
+	Request.Model = Model;
+	Request.SystemPrompt = Settings->SystemPrompt;
+	Request.Prompt = Prompt;
+	Request.MaxTokens = Settings->MaxTokens;
+	Request.Temperature = Settings->Temperature;
+	Request.bStream = Options.OnTextReceived && Provider->SupportsStreaming();
 
-	// Set up the response handling
-	Result.Empty();
-	bRequestComplete = false;
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &ULLMConnector::OnResponseReceived);
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = Provider->CreateRequest(Request);
+	if (OnRequestCreated)
+	{
+		OnRequestCreated(HttpRequest);
+	}
 
-	// Send the request
-	HttpRequest->ProcessRequest();
+	// Providers reserve max_tokens for the response up front
+	const int32 RequestTokens = InputTokens + Settings->MaxTokens;
 
-	// Wait for completion or timeout
-	const double StartTime = FPlatformTime::Seconds();
-	while (!bRequestComplete)
+	// Send the request; the response completes the future
+	if (Request.bStream)
 	{
-		FPlatformProcess::Sleep(0.1f);
+		return ProcessStreamingRequest(ProviderId, HttpRequest, RequestTokens, Options, Provider->GetStreamFormat(),
+		                               MoveTemp(Callbacks));
+	}
+	return ProcessRequest(ProviderId, Provider.ToSharedRef(), HttpRequest, RequestTokens, Options.Priority,
+	                      MoveTemp(Callbacks));
+}
+
+int32 ULLMConnector::GetBlueprintInfoTokenBudget(const FString& CustomPrompt)
+{
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+
+	const int32 OverheadTokens = FBlueprintPromptBudget::EstimateTokens(Settings->SystemPrompt) +
+		FBlueprintPromptBudget::EstimateTokens(CreatePrompt(FUtf8StringView(), CustomPrompt).GetView());
+	return FMath::Max(Settings->GetMaxInputTokens() - OverheadTokens, 0);
+}
+
+FLLMRequestEstimate ULLMConnector::EstimateDocumentation(FUtf8StringView BlueprintInfo, const FString& CustomPrompt)
+{
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
 
-		if (FPlatformTime::Seconds() - StartTime > RequestTimeout)
+	// The instructions and the Blueprint info are counted apart, so the info isn't copied just to be counted
+	FLLMRequestEstimate Estimate;
+	Estimate.InputTokens = FBlueprintPromptBudget::EstimateTokens(Settings->SystemPrompt) +
+		FBlueprintPromptBudget::EstimateTokens(CreatePrompt(FUtf8StringView(), CustomPrompt).GetView()) +
+		FBlueprintPromptBudget::EstimateTokens(BlueprintInfo);
+	Estimate.MaxInputTokens = Settings->GetMaxInputTokens();
+	Estimate.bExactTokenCount = FBlueprintPromptBudget::HasTokenizer();
+
+	Estimate.OutputTokens = Settings->MaxTokens;
+	FResponseHistory::FAverages Averages;
+	if (FResponseHistory::Get().GetAverages(Settings->SelectedProvider, Averages))
+	{
+		Estimate.Seconds = Averages.Seconds;
+		Estimate.CachedInputTokens = FMath::RoundToInt(Estimate.InputTokens * Averages.CachedInputShare);
+		if (Averages.OutputTokens > 0)
 		{
-			return TEXT("Error: Request timed out.");
+			Estimate.OutputTokens = FMath::Min(Averages.OutputTokens, Settings->MaxTokens);
+			Estimate.bOutputTokensMeasured = true;
 		}
 	}
 
-	return Result;
+	if (Settings->InputCostPerMillionTokens > 0.0f || Settings->OutputCostPerMillionTokens > 0.0f)
+	{
+		const double CachedInputCost = Settings->CachedInputCostPerMillionTokens > 0.0f
+			                               ? Settings->CachedInputCostPerMillionTokens
+			                               : Settings->InputCostPerMillionTokens;
+		Estimate.Cost = (static_cast<double>(Estimate.InputTokens - Estimate.CachedInputTokens) *
+			Settings->InputCostPerMillionTokens + static_cast<double>(Estimate.CachedInputTokens) * CachedInputCost +
+			static_cast<double>(Estimate.OutputTokens) * Settings->OutputCostPerMillionTokens) / 1000000.0;
+	}
+	return Estimate;
 }
 
-FString ULLMConnector::GenerateWithAnthropic(const FString& Prompt)
+int32 ULLMConnector::CountInputTokens(const FLLMPrompt& Prompt)
 {
-    const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
-    FString ApiKey = Settings->AnthropicApiKey;
-    FString Model = Settings->AnthropicModel;
-    FString Endpoint = Settings->AnthropicApiEndpoint;
-    
-    if (ApiKey.IsEmpty())
-    {
-        return TEXT("Error: Anthropic API key not provided. Please enter your API key in the plugin settings.");
-    }
-    
-    if (Endpoint.IsEmpty())
-    {
-        // Default Anthropic API endpoint
-        Endpoint = TEXT("https://api.anthropic.com/v1/messages");
-    }
-    
-    // Create the JSON request
-    TSharedPtr<FJsonObject> RequestJsonObject = MakeShareable(new FJsonObject);
-    RequestJsonObject->SetStringField(TEXT("model"), Model);
-    
-    // Set system prompt at top level for Anthropic
-    RequestJsonObject->SetStringField(TEXT("system"), Settings->SystemPrompt);
-    
-    // Create messages array (for Anthropic, this should only have user messages)
-    TArray<TSharedPtr<FJsonValue>> MessagesArray;
-    
-    // User message with the prompt
-    TSharedPtr<FJsonObject> UserMessageObject = MakeShareable(new FJsonObject);
-    UserMessageObject->SetStringField(TEXT("role"), TEXT("user"));
-    UserMessageObject->SetStringField(TEXT("content"), Prompt);
-    MessagesArray.Add(MakeShareable(new FJsonValueObject(UserMessageObject)));
-    
-    RequestJsonObject->SetArrayField(TEXT("messages"), MessagesArray);
-    RequestJsonObject->SetNumberField(TEXT("max_tokens"), Settings->MaxTokens);
-    RequestJsonObject->SetNumberField(TEXT("temperature"), Settings->Temperature);
-    
-    // Convert to string
-    FString RequestBody;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-    FJsonSerializer::Serialize(RequestJsonObject.ToSharedRef(), Writer);
-    
-    // Create the HTTP request
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-    HttpRequest->SetURL(Endpoint);
-    HttpRequest->SetVerb(TEXT("POST"));
-    HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-    HttpRequest->SetHeader(TEXT("x-api-key"), ApiKey);
-    HttpRequest->SetHeader(TEXT("anthropic-version"), TEXT("2023-06-01"));  // Important for Anthropic API
-    HttpRequest->SetContentAsString(RequestBody);
-    
-    // Set up the response handling
-    Result.Empty();
-    bRequestComplete = false;
-    HttpRequest->OnProcessRequestComplete().BindUObject(this, &ULLMConnector::OnAnthropicResponseReceived);
-    
-    // Send the request
-    HttpRequest->ProcessRequest();
-    
-    // Wait for completion or timeout
-    double StartTime = FPlatformTime::Seconds();
-    while (!bRequestComplete)
-    {
-        FPlatformProcess::Sleep(0.1f);
-        
-        if (FPlatformTime::Seconds() - StartTime > RequestTimeout)
-        {
-            return TEXT("Error: Request timed out.");
-        }
-    }
-    
-    return Result;
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	return FBlueprintPromptBudget::EstimateTokens(Settings->SystemPrompt) +
+		FBlueprintPromptBudget::EstimateTokens(Prompt.GetView());
 }
 
-FString ULLMConnector::GenerateWithOtherProvider(const FString& Prompt)
+FLLMPrompt ULLMConnector::CreatePrompt(FUtf8StringView BlueprintInfo, const FString& CustomPrompt)
 {
 	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
-	const FString ApiKey = Settings->OtherProviderApiKey;
-	const FString Endpoint = Settings->OtherProviderEndpoint;
 
-	if (ApiKey.IsEmpty() || Endpoint.IsEmpty())
+	// Sized for the instructions as well, so the Blueprint info is copied exactly once
+	FPromptWriter Prompt(BlueprintInfo.Len() + CustomPrompt.Len() + Settings->ProjectGlossary.Len() + 1024);
+	Prompt << TEXT("I need you to analyze this Unreal Engine Blueprint and provide professional documentation for it. ");
+
+	// Add settings-based instructions
+	if (Settings->bIncludeOverallSummary)
 	{
-		return TEXT(
-			"Error: API key or endpoint not provided for the selected provider. Please check the plugin settings.");
+		Prompt << TEXT("Include an overall summary of what this Blueprint does. ");
 	}
 
-	// Create a simple JSON request that most providers would accept
-	const TSharedPtr<FJsonObject> RequestJsonObject = MakeShareable(new FJsonObject);
-	RequestJsonObject->SetStringField(TEXT("prompt"), Prompt);
-	RequestJsonObject->SetNumberField(TEXT("max_tokens"), Settings->MaxTokens);
-	RequestJsonObject->SetNumberField(TEXT("temperature"), Settings->Temperature);
+	if (Settings->bIncludeVariableDescriptions)
+	{
+		Prompt << TEXT("Provide descriptions for each variable and its purpose. ");
+	}
 
-	// Convert to string
-	FString RequestBody;
-	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(RequestJsonObject.ToSharedRef(), Writer);
+	if (Settings->bIncludeFunctionBreakdowns)
+	{
+		Prompt << TEXT("Break down each function and explain what it does. ");
+	}
 
-	// Create the HTTP request
-	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Endpoint);
-	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
-	HttpRequest->SetContentAsString(RequestBody);
+	// Everything so far is the same for every Blueprint; the custom prompt and the Blueprint info follow
+	const int32 PrefixLen = AppendGlossary(Prompt);
+	AppendCustomPrompt(Prompt, CustomPrompt);
 
-	// Set up the response handling
-	Result.Empty();
-	bRequestComplete = false;
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &ULLMConnector::OnResponseReceived);
+	// Add the Blueprint info
+	Prompt << TEXT("\nHere is the Blueprint information:\n\n");
+	Prompt << BlueprintInfo;
 
-	// Send the request
-	HttpRequest->ProcessRequest();
+	return FLLMPrompt(Prompt.MoveText(), PrefixLen);
+}
 
-	// Wait for completion or timeout
-	const double StartTime = FPlatformTime::Seconds();
-	while (!bRequestComplete)
+int32 ULLMConnector::AppendGlossary(FPromptWriter& Prompt)
+{
+	const FString& Glossary = GetDefault<UUnrealMastermindSettings>()->ProjectGlossary;
+	if (!Glossary.IsEmpty())
 	{
-		FPlatformProcess::Sleep(0.1f);
-
-		if (FPlatformTime::Seconds() - StartTime > RequestTimeout)
-		{
-			return TEXT("Error: Request timed out.");
-		}
+		Prompt << TEXT("\nUse the terms of this project glossary:\n") << Glossary << TEXT("\n");
 	}
+	return Prompt.Len();
+}
 
-	return Result;
+void ULLMConnector::AppendCustomPrompt(FPromptWriter& Prompt, const FString& CustomPrompt)
+{
+	// Add custom prompt if provided
+	if (!CustomPrompt.IsEmpty())
+	{
+		Prompt << TEXT("\nAdditional instructions: ") << CustomPrompt << TEXT("\n\n");
+	}
 }
 
-void ULLMConnector::OnResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+FLLMRequestScheduler::FPhaseTimeouts ULLMConnector::GetPhaseTimeouts(bool bStream)
 {
-	if (!bWasSuccessful || !Response.IsValid())
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+
+	// The timeouts apply to each attempt, not to the time spent waiting for the rate limits
+	FLLMRequestScheduler::FPhaseTimeouts Timeouts;
+	Timeouts.Connect = Settings->ConnectTimeoutSeconds;
+	Timeouts.Idle = Settings->IdleTimeoutSeconds;
+	Timeouts.Total = Settings->RequestTimeoutSeconds;
+
+	// A complete response only starts once all of it is generated, so only the total limit applies to it
+	if (bStream)
 	{
-		Result = TEXT("Error: Failed to connect to the API server.");
-		bRequestComplete = true;
-		return;
+		Timeouts.FirstByte = Settings->FirstByteTimeoutSeconds;
 	}
+	return Timeouts;
+}
+
+FString ULLMConnector::MakeResult(ELLMProvider ProviderId, FLLMResponseFields&& Fields, double Seconds)
+{
+	if (!Fields.Error.IsEmpty())
+		return MoveTemp(Fields.Error);
+
+	FResponseHistory::Get().Add(ProviderId, Seconds, Fields);
 
-	if (Response->GetResponseCode() != 200)
+	const FString ProviderName = UEnum::GetDisplayValueAsText(ProviderId).ToString();
+	UE_LOG(LogUnrealMastermindLLM, Log,
+	       TEXT("%s: %d input tokens (%d read from and %d written to the prompt cache), %d output tokens, "
+		       "stop reason: %s"), *ProviderName, Fields.InputTokens, Fields.CachedInputTokens,
+	       Fields.CacheWriteInputTokens, Fields.OutputTokens,
+	       Fields.StopReason.IsEmpty() ? TEXT("none") : *Fields.StopReason);
+
+	if (Fields.IsTruncated())
 	{
-		Result = FString::Printf(TEXT("Error: HTTP %d - %s"), Response->GetResponseCode(),
-		                         *Response->GetContentAsString());
-		bRequestComplete = true;
-		return;
+		UE_LOG(LogUnrealMastermindLLM, Warning,
+		       TEXT("The documentation from %s was cut off at Max Tokens (%d); raise it in the plugin settings"),
+		       *ProviderName, GetDefault<UUnrealMastermindSettings>()->MaxTokens);
 	}
+	return MoveTemp(Fields.Content);
+}
+
+TFuture<FString> ULLMConnector::ProcessRequest(ELLMProvider ProviderId, const TSharedRef<const ILLMProvider>& Provider,
+                                               const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest,
+                                               int32 RequestTokens, ELLMRequestPriority Priority,
+                                               FLLMRequestScheduler::FAttemptCallbacks Callbacks)
+{
+	return FLLMRequestScheduler::Get().Submit(
+		ProviderId, Priority, RequestTokens, HttpRequest, GetPhaseTimeouts(false),
+		[ProviderId, Provider](FHttpResponsePtr Response, bool bWasSuccessful, double Seconds)
+		{
+			return MakeResult(ProviderId, Provider->ParseResponse(Response, bWasSuccessful), Seconds);
+		},
+		MoveTemp(Callbacks));
+}
 
-	// Parse the JSON response
-	TSharedPtr<FJsonObject> JsonObject;
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+TFuture<FString> ULLMConnector::ProcessStreamingRequest(ELLMProvider ProviderId,
+                                                        const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest,
+                                                        int32 RequestTokens, const FLLMRequestOptions& Options,
+                                                        ELLMStreamFormat Format,
+                                                        FLLMRequestScheduler::FAttemptCallbacks Callbacks)
+{
+	// The body goes to the stream as it arrives instead of being collected into the response
+	const TSharedRef<FLLMResponseStream> Stream = MakeShared<FLLMResponseStream>(Format, Options.OnTextReceived);
+	HttpRequest->SetHeader(TEXT("Accept"), TEXT("text/event-stream"));
+	HttpRequest->SetResponseBodyReceiveStreamDelegate(FHttpRequestStreamDelegate::CreateLambda(
+		[Stream](void* Data, int64 Length)
+		{
+			return Stream->Append(Data, Length);
+		}));
 
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	Callbacks.OnStart = [Stream, OnStart = MoveTemp(Callbacks.OnStart)]()
 	{
-		const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+		Stream->Restart();
+		if (OnStart)
+		{
+			OnStart();
+		}
+	};
 
-		// Different providers return responses in different structures
-		if (Settings->SelectedProvider == ELLMProvider::OpenAI)
+	return FLLMRequestScheduler::Get().Submit(
+		ProviderId, Options.Priority, RequestTokens, HttpRequest, GetPhaseTimeouts(true),
+		[ProviderId, Stream](FHttpResponsePtr Response, bool bWasSuccessful, double Seconds)
 		{
-			// Parse OpenAI response
-			TArray<TSharedPtr<FJsonValue>> Choices = JsonObject->GetArrayField(TEXT("choices"));
-			if (Choices.Num() > 0)
-			{
-				const TSharedPtr<FJsonObject> Choice = Choices[0]->AsObject();
-				const TSharedPtr<FJsonObject> Message = Choice->GetObjectField(TEXT("message"));
-				Result = Message->GetStringField(TEXT("content"));
-			}
-			else
+			UE_LOG(LogUnrealMastermindLLM, Log,
+			       TEXT("Streamed response: first token after %.2f s, complete after %.2f s"),
+			       Stream->GetTimeToFirstToken(), Seconds);
+
+			return MakeResult(ProviderId, Stream->Finish(Response, bWasSuccessful), Seconds);
+		},
+		MoveTemp(Callbacks));
+}
+
+// A prompt sent to the primary provider (leg 0) and, if needed, the secondary one (leg 1)
+struct ULLMConnector::FHedgedRequest
+{
+	FLLMPrompt Prompt;
+	FLLMRequestOptions Options;
+	ELLMProvider Providers[2] = {};
+	FString Models[2];
+	TPromise<FProviderResult> Promise;
+
+	FCriticalSection Lock;
+	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequests[2];
+	bool bStarted[2] = {};
+	bool bComplete[2] = {};
+
+	// The leg whose answer is used; a streamed leg wins with its first text
+	int32 Winner = INDEX_NONE;
+	bool bDone = false;
+
+	// Current attempt of the primary
+	bool bFirstByte = false;
+	bool bTimerArmed = false;
+};
+
+TFuture<ULLMConnector::FProviderResult> ULLMConnector::SendHedged(const FLLMPrompt& Prompt,
+                                                                  const FLLMRequestOptions& Options)
+{
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+
+	// Neither hedge nor fail over to a provider that can only answer with its configuration error
+	const TSharedPtr<const ILLMProvider> HedgeProvider = FLLMProviderRegistry::Get().Find(Settings->HedgeProvider);
+	if (!HedgeProvider.IsValid() || !HedgeProvider->GetConfigurationError().IsEmpty())
+	{
+		return SendToSelectedProvider(Prompt, Options);
+	}
+
+	const TSharedRef<FHedgedRequest> Request = MakeShared<FHedgedRequest>();
+	Request->Prompt = Prompt;
+	Request->Options = Options;
+	Request->Providers[0] = Settings->SelectedProvider;
+	Request->Providers[1] = Settings->HedgeProvider;
+	Request->Models[1] = Settings->HedgeModel;
+	Request->bStarted[0] = true;
+	TFuture<FProviderResult> Future = Request->Promise.GetFuture();
+
+	StartHedgeLeg(Request, 0);
+	return Future;
+}
+
+void ULLMConnector::StartHedgeLeg(const TSharedRef<FHedgedRequest>& Request, int32 Leg)
+{
+	// The request keeps its legs, so whatever the legs keep only refers to it
+	const TWeakPtr<FHedgedRequest> WeakRequest = Request;
+
+	FLLMRequestOptions Options = Request->Options;
+	if (Options.OnTextReceived)
+	{
+		// Only the text of the winner is passed on
+		Options.OnTextReceived = [WeakRequest, Leg](const FString& Text)
+		{
+			const TSharedPtr<FHedgedRequest> PinnedRequest = WeakRequest.Pin();
+			if (PinnedRequest.IsValid() && ClaimHedgeWin(PinnedRequest.ToSharedRef(), Leg))
 			{
-				Result = TEXT("Error: Could not parse API response from OpenAI.");
+				PinnedRequest->Options.OnTextReceived(Text);
 			}
+		};
+	}
+
+	const auto OnRequestCreated = [Request, Leg](const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest)
+	{
+		bool bLost;
+		{
+			FScopeLock ScopeLock(&Request->Lock);
+			Request->HttpRequests[Leg] = HttpRequest;
+			bLost = Request->bDone || (Request->Winner != INDEX_NONE && Request->Winner != Leg);
 		}
-		else if (Settings->SelectedProvider == ELLMProvider::Anthropic)
+
+		if (bLost)
 		{
-			// Parse Anthropic response
-			const TSharedPtr<FJsonObject> Content = JsonObject->GetObjectField(TEXT("content"));
-			if (Content.IsValid())
-			{
-				TArray<TSharedPtr<FJsonValue>> Parts = Content->GetArrayField(TEXT("parts"));
-				if (Parts.Num() > 0)
-				{
-					Result = Parts[0]->AsObject()->GetStringField(TEXT("text"));
-				}
-				else
-				{
-					Result = TEXT("Error: Could not parse API response from Anthropic.");
-				}
-			}
-			else
-			{
-				Result = TEXT("Error: Could not parse API response from Anthropic.");
-			}
+			CancelHedgeLeg(Request, Leg);
 		}
-		else
+	};
+
+	// Only the primary is timed
+	FLLMRequestScheduler::FAttemptCallbacks Callbacks;
+	if (Leg == 0)
+	{
+		Callbacks.OnStart = [WeakRequest]()
 		{
-			// Generic parser for other providers - try common response formats
-			if (JsonObject->HasField(TEXT("text")))
-			{
-				Result = JsonObject->GetStringField(TEXT("text"));
-			}
-			else if (JsonObject->HasField(TEXT("output")))
-			{
-				Result = JsonObject->GetStringField(TEXT("output"));
-			}
-			else if (JsonObject->HasField(TEXT("result")))
+			if (const TSharedPtr<FHedgedRequest> PinnedRequest = WeakRequest.Pin())
 			{
-				Result = JsonObject->GetStringField(TEXT("result"));
+				ArmHedgeTimer(PinnedRequest.ToSharedRef());
 			}
-			else if (JsonObject->HasField(TEXT("response")))
+		};
+		Callbacks.OnFirstByte = [WeakRequest](double Seconds)
+		{
+			if (const TSharedPtr<FHedgedRequest> PinnedRequest = WeakRequest.Pin())
 			{
-				Result = JsonObject->GetStringField(TEXT("response"));
+				OnHedgeFirstByte(PinnedRequest.ToSharedRef(), Seconds);
 			}
-			else
+		};
+	}
+
+	SendToProvider(Request->Providers[Leg], Request->Models[Leg], Request->Prompt, Options, OnRequestCreated,
+	               MoveTemp(Callbacks))
+		.Next([Request, Leg](FString Result)
+		{
+			OnHedgeLegComplete(Request, Leg, MoveTemp(Result));
+		});
+}
+
+void ULLMConnector::ArmHedgeTimer(const TSharedRef<FHedgedRequest>& Request)
+{
+	{
+		FScopeLock ScopeLock(&Request->Lock);
+		Request->bFirstByte = false;
+
+		// Counted from the first attempt; a retried primary is exactly the slow case worth hedging
+		if (Request->bDone || Request->bTimerArmed)
+			return;
+		Request->bTimerArmed = true;
+	}
+
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	const double Delay = FFirstByteLatencies::Get().GetPercentile(
+		Request->Providers[0], static_cast<bool>(Request->Options.OnTextReceived), Settings->HedgeLatencyPercentile,
+		Settings->HedgeDelaySeconds);
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[WeakRequest = TWeakPtr<FHedgedRequest>(Request), Delay](float)
+		{
+			const TSharedPtr<FHedgedRequest> PinnedRequest = WeakRequest.Pin();
+			if (!PinnedRequest.IsValid())
+				return false;
+
 			{
-				// Just return the entire JSON as a fallback
-				Result = Response->GetContentAsString();
+				FScopeLock ScopeLock(&PinnedRequest->Lock);
+				if (PinnedRequest->bDone || PinnedRequest->bFirstByte || PinnedRequest->Winner != INDEX_NONE ||
+					PinnedRequest->bStarted[1])
+					return false;
+				PinnedRequest->bStarted[1] = true;
 			}
-		}
+
+			UE_LOG(LogUnrealMastermindLLM, Log, TEXT("No response from %s after %.1f s, asking %s as well"),
+			       *UEnum::GetDisplayValueAsText(PinnedRequest->Providers[0]).ToString(), Delay,
+			       *UEnum::GetDisplayValueAsText(PinnedRequest->Providers[1]).ToString());
+			StartHedgeLeg(PinnedRequest.ToSharedRef(), 1);
+			return false;
+		}), static_cast<float>(Delay));
+}
+
+void ULLMConnector::OnHedgeFirstByte(const TSharedRef<FHedgedRequest>& Request, double Seconds)
+{
+	{
+		FScopeLock ScopeLock(&Request->Lock);
+		Request->bFirstByte = true;
 	}
-	else
+
+	FFirstByteLatencies::Get().Add(Request->Providers[0], static_cast<bool>(Request->Options.OnTextReceived),
+	                               Seconds);
+}
+
+bool ULLMConnector::ClaimHedgeWin(const TSharedRef<FHedgedRequest>& Request, int32 Leg)
+{
 	{
-		Result = TEXT("Error: Could not parse API response.");
+		FScopeLock ScopeLock(&Request->Lock);
+		if (Request->Winner != INDEX_NONE || Request->bDone)
+			return Request->Winner == Leg;
+		Request->Winner = Leg;
 	}
 
-	bRequestComplete = true;
+	CancelHedgeLeg(Request, 1 - Leg);
+	return true;
 }
 
-void ULLMConnector::OnAnthropicResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void ULLMConnector::OnHedgeLegComplete(const TSharedRef<FHedgedRequest>& Request, int32 Leg, FString Result)
 {
-    if (bWasSuccessful && Response.IsValid())
-    {
-        TSharedPtr<FJsonObject> JsonObject;
-        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-        
-        if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-        {
-            // Extract the content from Anthropic's response
-            if (JsonObject->HasField(TEXT("content")))
-            {
-                const TArray<TSharedPtr<FJsonValue>>* ContentArray = nullptr;
-                if (JsonObject->TryGetArrayField(TEXT("content"), ContentArray) && ContentArray != nullptr)
-                {
-                    FString ResultText;
-                    for (const TSharedPtr<FJsonValue>& ContentItem : *ContentArray)
-                    {
-                        const TSharedPtr<FJsonObject>* ContentObject = nullptr;
-                        if (ContentItem->TryGetObject(ContentObject) && ContentObject != nullptr)
-                        {
-                            FString TextValue;
-                            if ((*ContentObject)->TryGetStringField(TEXT("text"), TextValue))
-                            {
-                                ResultText += TextValue;
-                            }
-                        }
-                    }
-                    Result = ResultText;
-                }
-            }
-            else if (JsonObject->HasField(TEXT("error")))
-            {
-                // Handle error
-                const TSharedPtr<FJsonObject>* ErrorObject = nullptr;
-                if (JsonObject->TryGetObjectField(TEXT("error"), ErrorObject) && ErrorObject != nullptr)
-                {
-                    FString ErrorMessage;
-                    if ((*ErrorObject)->TryGetStringField(TEXT("message"), ErrorMessage))
-                    {
-                        Result = FString::Printf(TEXT("Error: %s"), *ErrorMessage);
-                    }
-                    else
-                    {
-                        Result = TEXT("Error: Unknown error occurred");
-                    }
-                }
-                else
-                {
-                    Result = TEXT("Error: Failed to parse error object");
-                }
-            }
-            else
-            {
-                Result = TEXT("Error: Unexpected response format");
-            }
-        }
-        else
-        {
-            Result = TEXT("Error: Failed to parse response JSON");
-        }
-    }
-    else
-    {
-        Result = TEXT("Error: Request failed");
-        
-        if (Response.IsValid())
-        {
-            Result += FString::Printf(TEXT(" (HTTP %d)"), Response->GetResponseCode());
-            Result += TEXT(" - ") + Response->GetContentAsString();
-        }
-    }
-    
-    bRequestComplete = true;
+	const bool bFailed = Result.StartsWith(TEXT("Error:"));
+
+	bool bWon = false;
+	bool bFailover = false;
+	bool bAllFailed = false;
+	{
+		FScopeLock ScopeLock(&Request->Lock);
+		if (Request->bDone)
+			return;
+
+		Request->bComplete[Leg] = true;
+		if (Request->Winner == Leg || (Request->Winner == INDEX_NONE && !bFailed))
+		{
+			bWon = true;
+			Request->Winner = Leg;
+		}
+		else if (Request->Winner == INDEX_NONE && !Request->bStarted[1])
+		{
+			// Fail over without waiting for the hedge delay
+			bFailover = true;
+			Request->bStarted[1] = true;
+		}
+		else if (Request->Winner == INDEX_NONE && Request->bComplete[0] && Request->bComplete[1])
+		{
+			bAllFailed = true;
+		}
+		Request->bDone = bWon || bAllFailed;
+	}
+
+	if (bFailover)
+	{
+		UE_LOG(LogUnrealMastermindLLM, Warning, TEXT("%s failed (%s), asking %s instead"),
+		       *UEnum::GetDisplayValueAsText(Request->Providers[0]).ToString(), *Result,
+		       *UEnum::GetDisplayValueAsText(Request->Providers[1]).ToString());
+		StartHedgeLeg(Request, 1);
+		return;
+	}
+
+	if (bWon)
+	{
+		CancelHedgeLeg(Request, 1 - Leg);
+		if (Leg == 1)
+		{
+			UE_LOG(LogUnrealMastermindLLM, Log, TEXT("Answered by %s"),
+			       *UEnum::GetDisplayValueAsText(Request->Providers[1]).ToString());
+		}
+	}
+
+	// With every leg failed, the last error is as good as any
+	if (bWon || bAllFailed)
+	{
+		Request->Promise.SetValue(FProviderResult{MoveTemp(Result), Request->Providers[Leg], Request->Models[Leg]});
+	}
 }
 
+void ULLMConnector::CancelHedgeLeg(const TSharedRef<FHedgedRequest>& Request, int32 Leg)
+{
+	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+	{
+		FScopeLock ScopeLock(&Request->Lock);
+		HttpRequest = Request->HttpRequests[Leg];
+	}
+
+	// On the game thread, never from within a callback of the other leg's request
+	if (HttpRequest.IsValid())
+	{
+		AsyncTask(ENamedThreads::GameThread, [HttpRequest]()
+		{
+			FLLMRequestScheduler::Get().Cancel(HttpRequest.ToSharedRef());
+		});
+	}
+}
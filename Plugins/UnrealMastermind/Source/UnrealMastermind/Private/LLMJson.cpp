@@ -0,0 +1,686 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "LLMJson.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Deeper documents are rejected rather than risk the stack; responses are a few levels deep
+	constexpr int32 MaxDepth = 128;
+
+	bool IsHighSurrogate(uint32 Char) { return Char >= 0xD800 && Char < 0xDC00; }
+	bool IsLowSurrogate(uint32 Char) { return Char >= 0xDC00 && Char < 0xE000; }
+
+	void AppendCodepoint(FString& Out, uint32 Codepoint)
+	{
+		if constexpr (sizeof(TCHAR) == 2)
+		{
+			if (Codepoint > 0xFFFF)
+			{
+				Codepoint -= 0x10000;
+				Out.AppendChar(static_cast<TCHAR>(0xD800 + (Codepoint >> 10)));
+				Out.AppendChar(static_cast<TCHAR>(0xDC00 + (Codepoint & 0x3FF)));
+				return;
+			}
+		}
+		Out.AppendChar(static_cast<TCHAR>(Codepoint));
+	}
+
+	// Converts UTF-8 straight into the end of the string, without a temporary
+	void AppendUtf8(FString& Out, const UTF8CHAR* Data, int32 Len)
+	{
+		const int32 ConvertedLength = FPlatformString::ConvertedLength<TCHAR>(Data, Len);
+		auto& Chars = Out.GetCharArray();
+		const int32 Start = Out.Len();
+		Chars.SetNumUninitialized(Start + ConvertedLength + 1, EAllowShrinking::No);
+		FPlatformString::Convert(Chars.GetData() + Start, ConvertedLength, Data, Len);
+		Chars[Start + ConvertedLength] = TEXT('\0');
+	}
+
+	bool ParseHex4(const UTF8CHAR* Char, const UTF8CHAR* End, uint32& OutValue)
+	{
+		if (End - Char < 4)
+			return false;
+
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const UTF8CHAR Digit = Char[Index];
+			uint32 Value;
+			if (Digit >= '0' && Digit <= '9')
+				Value = Digit - '0';
+			else if (Digit >= 'a' && Digit <= 'f')
+				Value = Digit - 'a' + 10;
+			else if (Digit >= 'A' && Digit <= 'F')
+				Value = Digit - 'A' + 10;
+			else
+				return false;
+			OutValue = (OutValue << 4) | Value;
+		}
+		return true;
+	}
+
+	bool MatchLiteral(const UTF8CHAR*& Cursor, const UTF8CHAR* End, FAnsiStringView Literal)
+	{
+		if (End - Cursor < Literal.Len() || FMemory::Memcmp(Cursor, Literal.GetData(), Literal.Len()) != 0)
+			return false;
+
+		Cursor += Literal.Len();
+		return true;
+	}
+}
+
+FLLMJsonWriter::FLLMJsonWriter(int32 InitialCapacity)
+{
+	Buffer.Reserve(InitialCapacity);
+}
+
+FLLMJsonWriter& FLLMJsonWriter::BeginObject()
+{
+	BeginValue();
+	Buffer.Add('{');
+	HasValue.Add(false);
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::EndObject()
+{
+	HasValue.Pop(EAllowShrinking::No);
+	Buffer.Add('}');
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::BeginArray()
+{
+	BeginValue();
+	Buffer.Add('[');
+	HasValue.Add(false);
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::EndArray()
+{
+	HasValue.Pop(EAllowShrinking::No);
+	Buffer.Add(']');
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::Key(FAnsiStringView Name)
+{
+	check(!bAfterKey && HasValue.Num() > 0);
+	if (HasValue.Last())
+	{
+		Buffer.Add(',');
+	}
+	HasValue.Last() = true;
+
+	Buffer.Add('"');
+	AppendAscii(Name);
+	Buffer.Add('"');
+	Buffer.Add(':');
+	bAfterKey = true;
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::String(FStringView Text)
+{
+	BeginValue();
+
+	// Prompts are mostly ASCII; anything else grows the buffer as it comes
+	Buffer.Reserve(Buffer.Num() + Text.Len() + 2);
+	Buffer.Add('"');
+
+	const TCHAR* Char = Text.GetData();
+	const TCHAR* const TextEnd = Char + Text.Len();
+	while (Char < TextEnd)
+	{
+		// Characters that need no escaping are copied a run at a time
+		const TCHAR* const RunStart = Char;
+		while (Char < TextEnd)
+		{
+			const uint32 Code = static_cast<uint32>(*Char);
+			if (Code < 0x20 || Code >= 0x80 || Code == '"' || Code == '\\')
+				break;
+			++Char;
+		}
+		if (Char > RunStart)
+		{
+			const int32 RunLength = UE_PTRDIFF_TO_INT32(Char - RunStart);
+			uint8* Dest = Buffer.GetData() + Buffer.AddUninitialized(RunLength);
+			for (int32 Index = 0; Index < RunLength; ++Index)
+			{
+				Dest[Index] = static_cast<uint8>(RunStart[Index]);
+			}
+		}
+		if (Char == TextEnd)
+			break;
+
+		uint32 Code = static_cast<uint32>(*Char++);
+		if (Code < 0x80)
+		{
+			AppendEscape(Code);
+			continue;
+		}
+
+		// UTF-16 builds hand out surrogate pairs; broken ones become U+FFFD rather than invalid UTF-8
+		if (IsHighSurrogate(Code))
+		{
+			if (Char < TextEnd && IsLowSurrogate(static_cast<uint32>(*Char)))
+			{
+				Code = 0x10000 + ((Code - 0xD800) << 10) + (static_cast<uint32>(*Char++) - 0xDC00);
+			}
+			else
+			{
+				Code = 0xFFFD;
+			}
+		}
+		else if (IsLowSurrogate(Code) || Code > 0x10FFFF)
+		{
+			Code = 0xFFFD;
+		}
+
+		if (Code < 0x800)
+		{
+			Buffer.Add(static_cast<uint8>(0xC0 | (Code >> 6)));
+			Buffer.Add(static_cast<uint8>(0x80 | (Code & 0x3F)));
+		}
+		else if (Code < 0x10000)
+		{
+			Buffer.Add(static_cast<uint8>(0xE0 | (Code >> 12)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((Code >> 6) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | (Code & 0x3F)));
+		}
+		else
+		{
+			Buffer.Add(static_cast<uint8>(0xF0 | (Code >> 18)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((Code >> 12) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((Code >> 6) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | (Code & 0x3F)));
+		}
+	}
+
+	Buffer.Add('"');
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::String(FUtf8StringView Text)
+{
+	BeginValue();
+
+	Buffer.Reserve(Buffer.Num() + Text.Len() + 2);
+	Buffer.Add('"');
+
+	const UTF8CHAR* Char = Text.GetData();
+	const UTF8CHAR* const TextEnd = Char + Text.Len();
+	while (Char < TextEnd)
+	{
+		// Multi-byte characters never contain bytes below 0x80, so only ASCII needs looking at
+		const UTF8CHAR* const RunStart = Char;
+		while (Char < TextEnd && *Char >= 0x20 && *Char != '"' && *Char != '\\')
+		{
+			++Char;
+		}
+		Buffer.Append(reinterpret_cast<const uint8*>(RunStart), UE_PTRDIFF_TO_INT32(Char - RunStart));
+
+		if (Char < TextEnd)
+		{
+			AppendEscape(*Char++);
+		}
+	}
+
+	Buffer.Add('"');
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::Int(int64 Value)
+{
+	BeginValue();
+
+	ANSICHAR Text[24];
+	const int32 Len = FCStringAnsi::Snprintf(Text, sizeof(Text), "%lld", static_cast<long long>(Value));
+	AppendAscii(FAnsiStringView(Text, Len));
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::Number(double Value)
+{
+	BeginValue();
+
+	// JSON has no NaN or infinity
+	if (!FMath::IsFinite(Value))
+	{
+		AppendAscii("null");
+		return *this;
+	}
+
+	ANSICHAR Text[32];
+	const int32 Len = FCStringAnsi::Snprintf(Text, sizeof(Text), "%.17g", Value);
+	AppendAscii(FAnsiStringView(Text, Len));
+	return *this;
+}
+
+FLLMJsonWriter& FLLMJsonWriter::Bool(bool bValue)
+{
+	BeginValue();
+	AppendAscii(bValue ? "true" : "false");
+	return *this;
+}
+
+FUtf8StringView FLLMJsonWriter::ToView() const
+{
+	return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Buffer.GetData()), Buffer.Num());
+}
+
+TArray<uint8> FLLMJsonWriter::MoveBytes()
+{
+	HasValue.Reset();
+	bAfterKey = false;
+	return MoveTemp(Buffer);
+}
+
+void FLLMJsonWriter::BeginValue()
+{
+	if (bAfterKey)
+	{
+		bAfterKey = false;
+		return;
+	}
+
+	if (HasValue.Num() > 0)
+	{
+		if (HasValue.Last())
+		{
+			Buffer.Add(',');
+		}
+		HasValue.Last() = true;
+	}
+}
+
+void FLLMJsonWriter::AppendAscii(FAnsiStringView Text)
+{
+	Buffer.Append(reinterpret_cast<const uint8*>(Text.GetData()), Text.Len());
+}
+
+void FLLMJsonWriter::AppendEscape(uint32 Char)
+{
+	switch (Char)
+	{
+	case '"': AppendAscii("\\\""); break;
+	case '\\': AppendAscii("\\\\"); break;
+	case '\n': AppendAscii("\\n"); break;
+	case '\r': AppendAscii("\\r"); break;
+	case '\t': AppendAscii("\\t"); break;
+	case '\b': AppendAscii("\\b"); break;
+	case '\f': AppendAscii("\\f"); break;
+	default:
+		{
+			ANSICHAR Escaped[8];
+			const int32 Len = FCStringAnsi::Snprintf(Escaped, sizeof(Escaped), "\\u%04x", Char);
+			AppendAscii(FAnsiStringView(Escaped, Len));
+		}
+		break;
+	}
+}
+
+bool FLLMJsonScanner::FPath::Matches(FAnsiStringView Pattern) const
+{
+	int32 SegmentIndex = 0;
+	while (!Pattern.IsEmpty())
+	{
+		if (SegmentIndex == Segments.Num())
+			return false;
+
+		int32 PartEnd;
+		if (!Pattern.FindChar('.', PartEnd))
+		{
+			PartEnd = Pattern.Len();
+		}
+		const FAnsiStringView Part = Pattern.Left(PartEnd);
+		Pattern.RightChopInline(PartEnd + 1);
+
+		const FPathSegment& Segment = Segments[SegmentIndex++];
+		if (Part == "*")
+			continue;
+
+		if (Segment.Index != INDEX_NONE)
+		{
+			int32 Index = 0;
+			for (const ANSICHAR Digit : Part)
+			{
+				if (!FChar::IsDigit(Digit))
+					return false;
+				Index = Index * 10 + (Digit - '0');
+			}
+			if (Part.IsEmpty() || Index != Segment.Index)
+				return false;
+		}
+		else if (!Segment.Key.Equals(Part, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+	return SegmentIndex == Segments.Num();
+}
+
+void FLLMJsonScanner::FValue::AppendString(FString& Out) const
+{
+	// Never more characters than bytes
+	Out.Reserve(Out.Len() + Raw.Len());
+
+	const UTF8CHAR* Char = Raw.GetData();
+	const UTF8CHAR* const RawEnd = Char + Raw.Len();
+	while (Char < RawEnd)
+	{
+		const UTF8CHAR* const RunStart = Char;
+		while (Char < RawEnd && *Char != '\\')
+		{
+			++Char;
+		}
+		if (Char > RunStart)
+		{
+			AppendUtf8(Out, RunStart, UE_PTRDIFF_TO_INT32(Char - RunStart));
+		}
+		if (RawEnd - Char < 2)
+			break;
+
+		const UTF8CHAR Escape = Char[1];
+		Char += 2;
+		switch (Escape)
+		{
+		case 'n': Out.AppendChar(TEXT('\n')); break;
+		case 'r': Out.AppendChar(TEXT('\r')); break;
+		case 't': Out.AppendChar(TEXT('\t')); break;
+		case 'b': Out.AppendChar(TEXT('\b')); break;
+		case 'f': Out.AppendChar(TEXT('\f')); break;
+		case 'u':
+			{
+				uint32 Codepoint;
+				if (!ParseHex4(Char, RawEnd, Codepoint))
+					return;
+				Char += 4;
+
+				// Characters outside the BMP are escaped as a surrogate pair
+				uint32 Low;
+				if (IsHighSurrogate(Codepoint) && RawEnd - Char >= 6 && Char[0] == '\\' && Char[1] == 'u' &&
+					ParseHex4(Char + 2, RawEnd, Low) && IsLowSurrogate(Low))
+				{
+					Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00);
+					Char += 6;
+				}
+				else if (IsHighSurrogate(Codepoint) || IsLowSurrogate(Codepoint))
+				{
+					Codepoint = 0xFFFD;
+				}
+				AppendCodepoint(Out, Codepoint);
+			}
+			break;
+		default:
+			// \" \\ and \/
+			Out.AppendChar(static_cast<TCHAR>(Escape));
+			break;
+		}
+	}
+}
+
+FString FLLMJsonScanner::FValue::GetString() const
+{
+	FString Out;
+	AppendString(Out);
+	return Out;
+}
+
+int64 FLLMJsonScanner::FValue::GetInt() const
+{
+	if (Type != EType::Number)
+		return 0;
+
+	ANSICHAR Text[32];
+	const int32 Len = FMath::Min(Raw.Len(), static_cast<int32>(UE_ARRAY_COUNT(Text)) - 1);
+	FMemory::Memcpy(Text, Raw.GetData(), Len);
+	Text[Len] = '\0';
+	return FCStringAnsi::Atoi64(Text);
+}
+
+bool FLLMJsonScanner::FValue::GetBool() const
+{
+	return Type == EType::Bool && Raw.Len() > 0 && Raw[0] == 't';
+}
+
+FLLMJsonScanner::FLLMJsonScanner(FUtf8StringView Json, FVisitor InVisitor)
+	: Cursor(Json.GetData())
+	, End(Json.GetData() + Json.Len())
+	, ValueVisitor(InVisitor)
+{
+}
+
+bool FLLMJsonScanner::Scan(FUtf8StringView Json, FVisitor Visitor)
+{
+	FLLMJsonScanner Scanner(Json, Visitor);
+	Scanner.SkipWhitespace();
+	if (!Scanner.ScanValue(0))
+		return false;
+
+	Scanner.SkipWhitespace();
+	return Scanner.Cursor == Scanner.End;
+}
+
+bool FLLMJsonScanner::ScanValue(int32 Depth)
+{
+	if (Cursor == End || Depth > MaxDepth)
+		return false;
+
+	FValue Value;
+	switch (*Cursor)
+	{
+	case '{':
+		{
+			++Cursor;
+			SkipWhitespace();
+			if (Cursor < End && *Cursor == '}')
+			{
+				++Cursor;
+				return true;
+			}
+
+			// By index, nested values may grow the path
+			const int32 SegmentIndex = Path.Segments.AddDefaulted();
+			while (true)
+			{
+				FUtf8StringView Key;
+				if (Cursor == End || *Cursor != '"' || !ScanString(Key))
+					return false;
+				Path.Segments[SegmentIndex].Key =
+					FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Key.GetData()), Key.Len());
+
+				SkipWhitespace();
+				if (Cursor == End || *Cursor != ':')
+					return false;
+				++Cursor;
+				SkipWhitespace();
+				if (!ScanValue(Depth + 1))
+					return false;
+
+				SkipWhitespace();
+				if (Cursor == End)
+					return false;
+				if (*Cursor == '}')
+					break;
+				if (*Cursor != ',')
+					return false;
+				++Cursor;
+				SkipWhitespace();
+			}
+			++Cursor;
+			Path.Segments.Pop(EAllowShrinking::No);
+			return true;
+		}
+
+	case '[':
+		{
+			++Cursor;
+			SkipWhitespace();
+			if (Cursor < End && *Cursor == ']')
+			{
+				++Cursor;
+				return true;
+			}
+
+			const int32 SegmentIndex = Path.Segments.AddDefaulted();
+			for (int32 Index = 0;; ++Index)
+			{
+				Path.Segments[SegmentIndex].Index = Index;
+				if (!ScanValue(Depth + 1))
+					return false;
+
+				SkipWhitespace();
+				if (Cursor == End)
+					return false;
+				if (*Cursor == ']')
+					break;
+				if (*Cursor != ',')
+					return false;
+				++Cursor;
+				SkipWhitespace();
+			}
+			++Cursor;
+			Path.Segments.Pop(EAllowShrinking::No);
+			return true;
+		}
+
+	case '"':
+		Value.Type = FValue::EType::String;
+		if (!ScanString(Value.Raw))
+			return false;
+		break;
+
+	case 't':
+	case 'f':
+	case 'n':
+		{
+			const UTF8CHAR* const Start = Cursor;
+			if (MatchLiteral(Cursor, End, "true") || MatchLiteral(Cursor, End, "false"))
+			{
+				Value.Type = FValue::EType::Bool;
+			}
+			else if (MatchLiteral(Cursor, End, "null"))
+			{
+				Value.Type = FValue::EType::Null;
+			}
+			else
+			{
+				return false;
+			}
+			Value.Raw = FUtf8StringView(Start, UE_PTRDIFF_TO_INT32(Cursor - Start));
+		}
+		break;
+
+	default:
+		{
+			// Numbers are only checked for their characters; GetInt reads what makes sense of them
+			const UTF8CHAR* const Start = Cursor;
+			while (Cursor < End && ((*Cursor >= '0' && *Cursor <= '9') || *Cursor == '-' || *Cursor == '+' ||
+				*Cursor == '.' || *Cursor == 'e' || *Cursor == 'E'))
+			{
+				++Cursor;
+			}
+			if (Cursor == Start)
+				return false;
+
+			Value.Type = FValue::EType::Number;
+			Value.Raw = FUtf8StringView(Start, UE_PTRDIFF_TO_INT32(Cursor - Start));
+		}
+		break;
+	}
+
+	ValueVisitor(Path, Value);
+	return true;
+}
+
+bool FLLMJsonScanner::ScanString(FUtf8StringView& OutRaw)
+{
+	// Cursor is on the opening quote; escapes are only checked when the string is unescaped
+	const UTF8CHAR* const Start = ++Cursor;
+	while (Cursor < End)
+	{
+		if (*Cursor == '"')
+		{
+			OutRaw = FUtf8StringView(Start, UE_PTRDIFF_TO_INT32(Cursor - Start));
+			++Cursor;
+			return true;
+		}
+
+		if (*Cursor == '\\')
+		{
+			if (End - Cursor < 2)
+				return false;
+			Cursor += 2;
+		}
+		else
+		{
+			++Cursor;
+		}
+	}
+	return false;
+}
+
+void FLLMJsonScanner::SkipWhitespace()
+{
+	while (Cursor < End && (*Cursor == ' ' || *Cursor == '\n' || *Cursor == '\r' || *Cursor == '\t'))
+	{
+		++Cursor;
+	}
+}
+
+FLLMJsonLinesFile::FLLMJsonLinesFile() = default;
+FLLMJsonLinesFile::~FLLMJsonLinesFile() = default;
+
+bool FLLMJsonLinesFile::Open(const FString& Filename, bool bAppend)
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+	File.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Filename, bAppend));
+	if (!File.IsValid())
+		return false;
+
+	// Ends a line cut off by a crash
+	if (File->Size() > 0)
+	{
+		const uint8 Newline = '\n';
+		File->Write(&Newline, 1);
+	}
+	return true;
+}
+
+void FLLMJsonLinesFile::Write(FLLMJsonWriter& Json)
+{
+	if (!File.IsValid())
+		return;
+
+	TArray<uint8> Line = Json.MoveBytes();
+	Line.Add('\n');
+	File->Write(Line.GetData(), Line.Num());
+	File->Flush(true);
+}
+
+bool FLLMJsonLinesFile::Read(const FString& Filename, TFunctionRef<void(FUtf8StringView Line)> Visitor)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename))
+		return false;
+
+	// The part after the last line break is a line the writer never finished
+	const UTF8CHAR* const Text = reinterpret_cast<const UTF8CHAR*>(Data.GetData());
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < Data.Num(); ++Index)
+	{
+		if (Data[Index] == '\n')
+		{
+			Visitor(FUtf8StringView(Text + LineStart, Index - LineStart));
+			LineStart = Index + 1;
+		}
+	}
+	return true;
+}
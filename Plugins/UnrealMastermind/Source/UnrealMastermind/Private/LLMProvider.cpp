@@ -0,0 +1,32 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "LLMProvider.h"
+#include "Misc/ScopeRWLock.h"
+#include "UnrealMastermindSettings.h"
+
+FLLMProviderRegistry& FLLMProviderRegistry::Get()
+{
+	static FLLMProviderRegistry Registry;
+	return Registry;
+}
+
+void FLLMProviderRegistry::Register(ELLMProvider Id, TSharedRef<const ILLMProvider> Provider)
+{
+	FWriteScopeLock ScopeLock(Lock);
+	Providers.Add(Id, MoveTemp(Provider));
+}
+
+void FLLMProviderRegistry::Unregister(ELLMProvider Id)
+{
+	FWriteScopeLock ScopeLock(Lock);
+	Providers.Remove(Id);
+}
+
+TSharedPtr<const ILLMProvider> FLLMProviderRegistry::Find(ELLMProvider Id) const
+{
+	FReadScopeLock ScopeLock(Lock);
+	if (const TSharedRef<const ILLMProvider>* Provider = Providers.Find(Id))
+		return *Provider;
+
+	return nullptr;
+}
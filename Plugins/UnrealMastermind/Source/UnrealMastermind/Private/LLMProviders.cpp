@@ -0,0 +1,398 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "LLMProviders.h"
+#include "HttpModule.h"
+#include "LLMJson.h"
+#include "UnrealMastermindSettings.h"
+#include "Hash/xxhash.h"
+
+namespace
+{
+	using FJsonScanPath = FLLMJsonScanner::FPath;
+	using FJsonScanValue = FLLMJsonScanner::FValue;
+
+	// A POST of the JSON body to the endpoint; authentication headers are up to the provider
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateJsonRequest(const FString& Endpoint, TArray<uint8>&& Body)
+	{
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+		HttpRequest->SetURL(Endpoint);
+		HttpRequest->SetVerb(TEXT("POST"));
+		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+		HttpRequest->SetContent(MoveTemp(Body));
+		return HttpRequest;
+	}
+
+	// Room for the prompts and the few other fields, so the body is allocated once
+	int32 EstimateBodySize(const FLLMProviderRequest& Request)
+	{
+		return Request.SystemPrompt.Len() + Request.Prompt.Len() + 256;
+	}
+
+	FString BodyToString(const TArray<uint8>& Body)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	// Hands the visitor the values of a successful response in one pass over its body, without converting
+	// the body as a whole. False with the error in OutFields if the request failed.
+	bool ScanResponse(const FHttpResponsePtr& Response, bool bWasSuccessful, FLLMResponseFields& OutFields,
+	                  FLLMJsonScanner::FVisitor Visitor)
+	{
+		if (!bWasSuccessful || !Response.IsValid())
+		{
+			OutFields.Error = TEXT("Error: Failed to connect to the API server.");
+			return false;
+		}
+
+		const TArray<uint8>& Body = Response->GetContent();
+		if (Response->GetResponseCode() != 200)
+		{
+			OutFields.Error = FString::Printf(TEXT("Error: HTTP %d - %s"), Response->GetResponseCode(),
+			                                  *BodyToString(Body));
+			return false;
+		}
+
+		FString ErrorMessage;
+		const bool bParsed = FLLMJsonScanner::Scan(
+			FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Body.GetData()), Body.Num()),
+			[&ErrorMessage, Visitor](const FJsonScanPath& Path, const FJsonScanValue& Value)
+			{
+				if (Path.Matches("error.message"))
+				{
+					ErrorMessage = Value.GetString();
+				}
+				else
+				{
+					Visitor(Path, Value);
+				}
+			});
+
+		if (!bParsed)
+		{
+			OutFields.Error = TEXT("Error: Could not parse API response.");
+			return false;
+		}
+
+		if (!ErrorMessage.IsEmpty())
+		{
+			OutFields.Error = FString::Printf(TEXT("Error: %s"), *ErrorMessage);
+			return false;
+		}
+		return true;
+	}
+
+	int32 GetTokenCount(const FJsonScanValue& Value)
+	{
+		return static_cast<int32>(FMath::Clamp<int64>(Value.GetInt(), 0, MAX_int32));
+	}
+
+	// Names the system prompt and prompt prefix of a request, so requests that share them share a cache key
+	FString MakePrefixKey(const FString& Model, const FLLMProviderRequest& Request)
+	{
+		FXxHash64Builder Builder;
+		Builder.Update(*Model, Model.Len() * sizeof(TCHAR));
+		Builder.Update(*Request.SystemPrompt, Request.SystemPrompt.Len() * sizeof(TCHAR));
+		const FUtf8StringView Prefix = Request.Prompt.GetPrefix();
+		Builder.Update(Prefix.GetData(), Prefix.Len());
+		return FString::Printf(TEXT("unreal-mastermind-%016llx"), Builder.Finalize().Hash);
+	}
+
+	// A text content block; with bCache the provider caches everything up to and including it
+	void WriteAnthropicTextBlock(FLLMJsonWriter& Json, FUtf8StringView Text, bool bCache)
+	{
+		Json.BeginObject().Key("type").String(TEXT("text")).Key("text").String(Text);
+		if (bCache)
+		{
+			Json.Key("cache_control").BeginObject().Key("type").String(TEXT("ephemeral")).EndObject();
+		}
+		Json.EndObject();
+	}
+}
+
+FString FOpenAIProvider::GetDefaultModel() const
+{
+	return GetDefault<UUnrealMastermindSettings>()->OpenAIModel;
+}
+
+FString FOpenAIProvider::GetEndpoint() const
+{
+	return GetDefault<UUnrealMastermindSettings>()->OpenAIEndpoint;
+}
+
+FString FOpenAIProvider::GetConfigurationError() const
+{
+	if (GetDefault<UUnrealMastermindSettings>()->OpenAIApiKey.IsEmpty())
+		return TEXT("Error: OpenAI API key not provided. Please enter your API key in the plugin settings.");
+
+	return FString();
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FOpenAIProvider::CreateRequest(const FLLMProviderRequest& Request) const
+{
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	const FString Model = Request.Model.IsEmpty() ? GetDefaultModel() : Request.Model;
+
+	FLLMJsonWriter Json(EstimateBodySize(Request));
+	Json.BeginObject();
+	Json.Key("model").String(Model);
+
+	// System message, then the user message with the prompt; both start the same in every request, which is
+	// what prompt caching needs
+	Json.Key("messages").BeginArray();
+	Json.BeginObject().Key("role").String(TEXT("system")).Key("content").String(Request.SystemPrompt).EndObject();
+	Json.BeginObject().Key("role").String(TEXT("user")).Key("content").String(Request.Prompt.GetView()).EndObject();
+	Json.EndArray();
+
+	Json.Key("max_tokens").Int(Request.MaxTokens);
+	Json.Key("temperature").Number(Request.Temperature);
+	if (Request.bStream)
+	{
+		// Usage is only reported in a stream when asked for, in a last chunk without choices
+		Json.Key("stream").Bool(true);
+		Json.Key("stream_options").BeginObject().Key("include_usage").Bool(true).EndObject();
+	}
+
+	const FString Endpoint = GetEndpoint();
+	if (Settings->bUsePromptCaching && Endpoint.Contains(TEXT("api.openai.com")))
+	{
+		// OpenAI caches long prompt starts by itself; the key routes requests that share one to the same cache
+		Json.Key("prompt_cache_key").String(MakePrefixKey(Model, Request));
+	}
+	else if (Settings->bUsePromptCaching && Settings->OpenAIServerSlot >= 0)
+	{
+		// llama.cpp-style servers keep the last prompt of each slot and only process what follows the shared start
+		Json.Key("cache_prompt").Bool(true);
+		Json.Key("id_slot").Int(Settings->OpenAIServerSlot);
+	}
+	Json.EndObject();
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateJsonRequest(Endpoint, Json.MoveBytes());
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *Settings->OpenAIApiKey));
+	return HttpRequest;
+}
+
+FLLMResponseFields FOpenAIProvider::ParseResponse(FHttpResponsePtr Response, bool bWasSuccessful) const
+{
+	FLLMResponseFields Fields;
+	bool bHasContent = false;
+	const bool bScanned = ScanResponse(Response, bWasSuccessful, Fields,
+		[&Fields, &bHasContent](const FJsonScanPath& Path, const FJsonScanValue& Value)
+		{
+			if (Value.Type == FJsonScanValue::EType::String && Path.Matches("choices.0.message.content"))
+			{
+				Value.AppendString(Fields.Content);
+				bHasContent = true;
+			}
+			else if (Value.Type == FJsonScanValue::EType::String && Path.Matches("choices.0.finish_reason"))
+			{
+				Fields.StopReason = Value.GetString();
+			}
+			else if (Path.Matches("usage.prompt_tokens"))
+			{
+				Fields.InputTokens = GetTokenCount(Value);
+			}
+			else if (Path.Matches("usage.completion_tokens"))
+			{
+				Fields.OutputTokens = GetTokenCount(Value);
+			}
+			else if (Path.Matches("usage.prompt_tokens_details.cached_tokens"))
+			{
+				Fields.CachedInputTokens = GetTokenCount(Value);
+			}
+		});
+
+	if (bScanned && !bHasContent)
+	{
+		Fields.Error = TEXT("Error: Could not parse API response from OpenAI.");
+	}
+	return Fields;
+}
+
+FString FAnthropicProvider::GetDefaultModel() const
+{
+	return GetDefault<UUnrealMastermindSettings>()->AnthropicModel;
+}
+
+FString FAnthropicProvider::GetEndpoint() const
+{
+	const FString& Endpoint = GetDefault<UUnrealMastermindSettings>()->AnthropicApiEndpoint;
+
+	// Default Anthropic API endpoint
+	return Endpoint.IsEmpty() ? FString(TEXT("https://api.anthropic.com/v1/messages")) : Endpoint;
+}
+
+FString FAnthropicProvider::GetConfigurationError() const
+{
+	if (GetDefault<UUnrealMastermindSettings>()->AnthropicApiKey.IsEmpty())
+		return TEXT("Error: Anthropic API key not provided. Please enter your API key in the plugin settings.");
+
+	return FString();
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FAnthropicProvider::CreateRequest(const FLLMProviderRequest& Request) const
+{
+	FLLMJsonWriter Json(EstimateBodySize(Request));
+	Json.BeginObject();
+	Json.Key("model").String(Request.Model.IsEmpty() ? GetDefaultModel() : Request.Model);
+
+	// The system prompt and the start of the prompt are the same in every request, so with prompt caching each
+	// ends in a cache breakpoint: requests with another prompt still share the system prompt
+	const bool bCache = GetDefault<UUnrealMastermindSettings>()->bUsePromptCaching;
+	if (!Request.SystemPrompt.IsEmpty())
+	{
+		const FTCHARToUTF8 SystemPrompt(*Request.SystemPrompt, Request.SystemPrompt.Len());
+		Json.Key("system").BeginArray();
+		WriteAnthropicTextBlock(Json, FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(SystemPrompt.Get()),
+		                                              SystemPrompt.Length()), bCache);
+		Json.EndArray();
+	}
+
+	// Messages array (for Anthropic, this should only have user messages); empty text blocks aren't allowed
+	const FUtf8StringView Prefix = Request.Prompt.GetPrefix();
+	const FUtf8StringView Suffix = Request.Prompt.GetSuffix();
+	Json.Key("messages").BeginArray();
+	Json.BeginObject().Key("role").String(TEXT("user")).Key("content").BeginArray();
+	if (!Prefix.IsEmpty())
+	{
+		WriteAnthropicTextBlock(Json, Prefix, bCache);
+	}
+	if (!Suffix.IsEmpty() || Prefix.IsEmpty())
+	{
+		WriteAnthropicTextBlock(Json, Suffix, false);
+	}
+	Json.EndArray().EndObject();
+	Json.EndArray();
+
+	Json.Key("max_tokens").Int(Request.MaxTokens);
+	Json.Key("temperature").Number(Request.Temperature);
+	if (Request.bStream)
+	{
+		Json.Key("stream").Bool(true);
+	}
+	Json.EndObject();
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateJsonRequest(GetEndpoint(), Json.MoveBytes());
+	HttpRequest->SetHeader(TEXT("x-api-key"), GetDefault<UUnrealMastermindSettings>()->AnthropicApiKey);
+	HttpRequest->SetHeader(TEXT("anthropic-version"), TEXT("2023-06-01"));  // Important for Anthropic API
+	return HttpRequest;
+}
+
+FLLMResponseFields FAnthropicProvider::ParseResponse(FHttpResponsePtr Response, bool bWasSuccessful) const
+{
+	FLLMResponseFields Fields;
+	bool bHasContent = false;
+	const bool bScanned = ScanResponse(Response, bWasSuccessful, Fields,
+		[&Fields, &bHasContent](const FJsonScanPath& Path, const FJsonScanValue& Value)
+		{
+			// The text of every content block, in order
+			if (Value.Type == FJsonScanValue::EType::String && Path.Matches("content.*.text"))
+			{
+				Value.AppendString(Fields.Content);
+				bHasContent = true;
+			}
+			else if (Value.Type == FJsonScanValue::EType::String && Path.Matches("stop_reason"))
+			{
+				Fields.StopReason = Value.GetString();
+			}
+			else if (Path.Matches("usage.input_tokens"))
+			{
+				Fields.InputTokens = GetTokenCount(Value);
+			}
+			else if (Path.Matches("usage.output_tokens"))
+			{
+				Fields.OutputTokens = GetTokenCount(Value);
+			}
+			else if (Path.Matches("usage.cache_read_input_tokens"))
+			{
+				Fields.CachedInputTokens = GetTokenCount(Value);
+			}
+			else if (Path.Matches("usage.cache_creation_input_tokens"))
+			{
+				Fields.CacheWriteInputTokens = GetTokenCount(Value);
+			}
+		});
+
+	if (bScanned && !bHasContent)
+	{
+		Fields.Error = TEXT("Error: Unexpected response format");
+	}
+
+	// Anthropic counts the prompt tokens read from and written to its cache apart from the others
+	Fields.InputTokens += Fields.CachedInputTokens + Fields.CacheWriteInputTokens;
+	return Fields;
+}
+
+FString FGenericLLMProvider::GetDefaultModel() const
+{
+	// The request names no model; the provider name tells configurations apart
+	return GetDefault<UUnrealMastermindSettings>()->OtherProviderName;
+}
+
+FString FGenericLLMProvider::GetEndpoint() const
+{
+	return GetDefault<UUnrealMastermindSettings>()->OtherProviderEndpoint;
+}
+
+FString FGenericLLMProvider::GetConfigurationError() const
+{
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	if (Settings->OtherProviderApiKey.IsEmpty() || Settings->OtherProviderEndpoint.IsEmpty())
+	{
+		return TEXT(
+			"Error: API key or endpoint not provided for the selected provider. Please check the plugin settings.");
+	}
+	return FString();
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FGenericLLMProvider::CreateRequest(const FLLMProviderRequest& Request) const
+{
+	// Create a simple JSON request that most providers would accept
+	FLLMJsonWriter Json(EstimateBodySize(Request));
+	Json.BeginObject();
+	Json.Key("prompt").String(Request.Prompt.GetView());
+	Json.Key("max_tokens").Int(Request.MaxTokens);
+	Json.Key("temperature").Number(Request.Temperature);
+	Json.EndObject();
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateJsonRequest(GetEndpoint(), Json.MoveBytes());
+	HttpRequest->SetHeader(TEXT("Authorization"),
+	                       FString::Printf(TEXT("Bearer %s"), *GetDefault<UUnrealMastermindSettings>()->OtherProviderApiKey));
+	return HttpRequest;
+}
+
+FLLMResponseFields FGenericLLMProvider::ParseResponse(FHttpResponsePtr Response, bool bWasSuccessful) const
+{
+	// Common response formats, in order of preference
+	static const ANSICHAR* const Fields[] = {"text", "output", "result", "response"};
+	constexpr int32 NumFields = UE_ARRAY_COUNT(Fields);
+
+	FLLMResponseFields Result;
+	int32 Best = NumFields;
+	if (!ScanResponse(Response, bWasSuccessful, Result,
+		[&Result, &Best](const FJsonScanPath& Path, const FJsonScanValue& Value)
+		{
+			if (Value.Type != FJsonScanValue::EType::String)
+				return;
+
+			for (int32 Index = 0; Index < Best; ++Index)
+			{
+				if (Path.Matches(Fields[Index]))
+				{
+					Result.Content = Value.GetString();
+					Best = Index;
+					break;
+				}
+			}
+		}))
+	{
+		return Result;
+	}
+
+	// Just return the entire JSON as a fallback
+	if (Best == NumFields)
+	{
+		Result.Content = BodyToString(Response->GetContent());
+	}
+	return Result;
+}
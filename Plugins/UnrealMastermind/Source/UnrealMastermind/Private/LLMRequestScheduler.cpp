@@ -0,0 +1,588 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "LLMRequestScheduler.h"
+#include "HttpModule.h"
+#include "Misc/ScopeLock.h"
+#include "UnrealMastermindSettings.h"
+
+namespace
+{
+	// Attempts per request, including the first, before a rate limit is reported as an error
+	constexpr int32 MaxAttempts = 4;
+
+	// Wait after a 429 that came without retry-after or reset headers
+	constexpr double DefaultRetryDelaySeconds = 5.0;
+
+	const TCHAR* const ShutDownError = TEXT("Error: The editor shut down before the request was sent.");
+
+	// Time to the first byte this many times the best seen means requests are queueing at the provider
+	constexpr double CongestedLatencyFactor = 2.0;
+
+	bool IsRateLimited(int32 ResponseCode)
+	{
+		// 529 is Anthropic's "overloaded"
+		return ResponseCode == 429 || ResponseCode == 503 || ResponseCode == 529;
+	}
+
+	// First header present, by name in order
+	FString GetFirstHeader(const FHttpResponsePtr& Response, TConstArrayView<const TCHAR*> Names)
+	{
+		for (const TCHAR* Name : Names)
+		{
+			FString Value = Response->GetHeader(Name);
+			if (!Value.IsEmpty())
+				return Value;
+		}
+		return FString();
+	}
+}
+
+void FLLMRequestScheduler::FTokenBucket::Refill(double Now)
+{
+	if (Capacity > 0.0)
+	{
+		Level = FMath::Min(Capacity, Level + (Now - LastRefillTime) * Capacity / 60.0);
+	}
+	LastRefillTime = Now;
+}
+
+bool FLLMRequestScheduler::FTokenBucket::CanTake(double Amount) const
+{
+	// A request larger than the whole bucket still goes once the bucket is full
+	return Capacity <= 0.0 || Level >= FMath::Min(Amount, Capacity);
+}
+
+void FLLMRequestScheduler::FTokenBucket::Take(double Amount)
+{
+	if (Capacity > 0.0)
+	{
+		Level -= Amount;
+	}
+}
+
+void FLLMRequestScheduler::FTokenBucket::SetCapacity(double PerMinute)
+{
+	if (PerMinute == Capacity)
+		return;
+
+	// Start full; the provider's remaining-count headers correct the level with the first response
+	Capacity = PerMinute;
+	Level = PerMinute;
+}
+
+FLLMRequestScheduler& FLLMRequestScheduler::Get()
+{
+	static FLLMRequestScheduler Scheduler;
+	return Scheduler;
+}
+
+void FLLMRequestScheduler::Initialize()
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		bShutDown = false;
+	}
+
+	// Requests are sent as soon as they are submitted or a slot frees up; the ticker only catches
+	// buckets refilling and retry delays running out
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FLLMRequestScheduler::Tick), 0.1f);
+}
+
+void FLLMRequestScheduler::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	TArray<TSharedRef<FJob>> Queued;
+	TArray<TSharedRef<FJob>> Sent;
+	{
+		FScopeLock ScopeLock(&Lock);
+		bShutDown = true;
+		for (TPair<ELLMProvider, FProviderState>& Provider : Providers)
+		{
+			for (TArray<TSharedRef<FJob>>& Queue : Provider.Value.Queues)
+			{
+				Queued.Append(MoveTemp(Queue));
+				Queue.Reset();
+			}
+			Sent.Append(Provider.Value.InFlight);
+		}
+	}
+
+	// Outside the lock, the continuations of the futures run right here and may submit more
+	for (const TSharedRef<FJob>& Job : Queued)
+	{
+		Job->Promise.SetValue(ShutDownError);
+	}
+
+	// Their futures complete as the HTTP module reports the cancellations
+	for (const TSharedRef<FJob>& Job : Sent)
+	{
+		Job->HttpRequest->CancelRequest();
+	}
+}
+
+FLLMRequestScheduler::FProviderState& FLLMRequestScheduler::GetProviderState(ELLMProvider Provider)
+{
+	if (FProviderState* State = Providers.Find(Provider))
+		return *State;
+
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	const double Now = FPlatformTime::Seconds();
+
+	FProviderState& State = Providers.Add(Provider);
+	State.ConcurrencyLimit = Settings->MaxConcurrentRequests;
+	State.Requests.SetCapacity(Settings->RequestsPerMinute);
+	State.Requests.LastRefillTime = Now;
+	State.Tokens.SetCapacity(Settings->TokensPerMinute);
+	State.Tokens.LastRefillTime = Now;
+	return State;
+}
+
+TFuture<FString> FLLMRequestScheduler::Submit(ELLMProvider Provider, ELLMRequestPriority Priority,
+                                              int32 EstimatedTokens,
+                                              const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest,
+                                              const FPhaseTimeouts& Timeouts, FResponseHandler ResponseHandler,
+                                              FAttemptCallbacks Callbacks)
+{
+	const TSharedRef<FJob> Job = MakeShared<FJob>();
+	Job->HttpRequest = HttpRequest;
+	Job->ResponseHandler = MoveTemp(ResponseHandler);
+	Job->Callbacks = MoveTemp(Callbacks);
+	Job->Timeouts = Timeouts;
+	Job->Priority = Priority;
+	Job->EstimatedTokens = EstimatedTokens;
+	TFuture<FString> Future = Job->Promise.GetFuture();
+
+	// The total limit is up to the HTTP module, the phases are watched by Tick
+	if (Timeouts.Total > 0.0f)
+	{
+		HttpRequest->SetTimeout(Timeouts.Total);
+	}
+
+	// The job is kept alive by the queues while it is waiting or in flight, the request only refers to it
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[this, Provider, WeakJob = TWeakPtr<FJob>(Job)](FHttpRequestPtr, FHttpResponsePtr Response,
+		                                                bool bWasSuccessful)
+		{
+			if (const TSharedPtr<FJob> PinnedJob = WeakJob.Pin())
+			{
+				OnAttemptComplete(Provider, PinnedJob.ToSharedRef(), Response, bWasSuccessful);
+			}
+		});
+	HttpRequest->OnRequestProgress64().BindLambda(
+		[this, WeakJob = TWeakPtr<FJob>(Job)](FHttpRequestPtr, uint64 BytesSent, uint64 BytesReceived)
+		{
+			if (const TSharedPtr<FJob> PinnedJob = WeakJob.Pin())
+			{
+				OnAttemptProgress(PinnedJob.ToSharedRef(), BytesSent, BytesReceived);
+			}
+		});
+
+	bool bQueued = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!bShutDown)
+		{
+			GetProviderState(Provider).Queues[static_cast<int32>(Priority)].Add(Job);
+			bQueued = true;
+		}
+	}
+
+	// Nothing would ever send it
+	if (!bQueued)
+	{
+		Job->Promise.SetValue(ShutDownError);
+		return Future;
+	}
+
+	Pump();
+	return Future;
+}
+
+void FLLMRequestScheduler::Cancel(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest)
+{
+	const auto IsJobOf = [&HttpRequest](const TSharedRef<FJob>& Job)
+	{
+		return Job->HttpRequest == HttpRequest;
+	};
+
+	TSharedPtr<FJob> QueuedJob;
+	bool bInFlight = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (TPair<ELLMProvider, FProviderState>& Provider : Providers)
+		{
+			for (TArray<TSharedRef<FJob>>& Queue : Provider.Value.Queues)
+			{
+				const int32 Index = Queue.IndexOfByPredicate(IsJobOf);
+				if (Index != INDEX_NONE)
+				{
+					QueuedJob = Queue[Index];
+					Queue.RemoveAt(Index);
+				}
+			}
+			bInFlight |= Provider.Value.InFlight.ContainsByPredicate(IsJobOf);
+		}
+	}
+
+	// Outside the lock, the continuations of the future run right here
+	if (QueuedJob)
+	{
+		QueuedJob->Promise.SetValue(TEXT("Error: The request was cancelled."));
+	}
+	else if (bInFlight)
+	{
+		HttpRequest->CancelRequest();
+	}
+}
+
+bool FLLMRequestScheduler::Tick(float DeltaTime)
+{
+	CheckTimeouts();
+	Pump();
+	return true;
+}
+
+void FLLMRequestScheduler::Pump()
+{
+	const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
+	const double Now = FPlatformTime::Seconds();
+
+	// Beyond the connections the HTTP module keeps per server, requests would wait for a free connection
+	// where neither the limits nor the timeouts can see them
+	int32 MaxConcurrentRequests = Settings->MaxConcurrentRequests;
+	if (FHttpModule::Get().GetHttpMaxConnectionsPerServer() > 0)
+	{
+		MaxConcurrentRequests = FMath::Min(MaxConcurrentRequests, FHttpModule::Get().GetHttpMaxConnectionsPerServer());
+	}
+
+	TArray<TSharedRef<FJob>, TInlineAllocator<8>> ToSend;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bShutDown)
+			return;
+
+		for (TPair<ELLMProvider, FProviderState>& Provider : Providers)
+		{
+			FProviderState& State = Provider.Value;
+			if (Now < State.BlockedUntil)
+				continue;
+
+			State.ConcurrencyLimit = FMath::Clamp(State.ConcurrencyLimit, 1.0,
+			                                      static_cast<double>(MaxConcurrentRequests));
+			State.Requests.Refill(Now);
+			State.Tokens.Refill(Now);
+
+			for (TArray<TSharedRef<FJob>>& Queue : State.Queues)
+			{
+				while (!Queue.IsEmpty() && State.InFlight.Num() < FMath::FloorToInt(State.ConcurrencyLimit))
+				{
+					const TSharedRef<FJob>& Job = Queue[0];
+					if (!State.Requests.CanTake(1.0) || !State.Tokens.CanTake(Job->EstimatedTokens))
+						break;
+
+					State.Requests.Take(1.0);
+					State.Tokens.Take(Job->EstimatedTokens);
+					State.InFlight.Add(Job);
+					ToSend.Add(Job);
+
+					++Job->NumAttempts;
+					Job->AttemptStartTime = Now;
+					Job->LastReceiveTime = Now;
+					Job->BytesReceived = 0;
+					Job->FirstByteSeconds = 0.0;
+					Job->bConnected = false;
+					Job->TimeoutError.Reset();
+					Queue.RemoveAt(0, 1, EAllowShrinking::No);
+				}
+
+				// Background requests never overtake a waiting interactive one
+				if (!Queue.IsEmpty())
+					break;
+			}
+		}
+	}
+
+	// Sent outside the lock, the completion of a failed request can run right away
+	for (const TSharedRef<FJob>& Job : ToSend)
+	{
+		Send(Job);
+	}
+}
+
+void FLLMRequestScheduler::Send(const TSharedRef<FJob>& Job)
+{
+	if (Job->Callbacks.OnStart)
+	{
+		Job->Callbacks.OnStart();
+	}
+
+	Job->HttpRequest->ProcessRequest();
+}
+
+void FLLMRequestScheduler::OnAttemptProgress(const TSharedRef<FJob>& Job, uint64 BytesSent, uint64 BytesReceived)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	bool bFirstByte;
+	double Seconds;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// Bytes go out only once the connection, TLS included, is up
+		Job->bConnected |= BytesSent > 0 || BytesReceived > 0;
+		if (BytesReceived <= Job->BytesReceived)
+			return;
+
+		bFirstByte = Job->BytesReceived == 0;
+		Job->BytesReceived = BytesReceived;
+		Job->LastReceiveTime = Now;
+		Seconds = Now - Job->AttemptStartTime;
+		if (bFirstByte)
+		{
+			Job->FirstByteSeconds = Seconds;
+		}
+	}
+
+	// An error, such as a rate limit that will be retried, is no answer
+	const FHttpResponsePtr Response = Job->HttpRequest->GetResponse();
+	if (bFirstByte && Job->Callbacks.OnFirstByte && !(Response.IsValid() && Response->GetResponseCode() >= 400))
+	{
+		Job->Callbacks.OnFirstByte(Seconds);
+	}
+}
+
+void FLLMRequestScheduler::CheckTimeouts()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<TSharedRef<FJob>, TInlineAllocator<8>> TimedOut;
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (TPair<ELLMProvider, FProviderState>& Provider : Providers)
+		{
+			for (const TSharedRef<FJob>& Job : Provider.Value.InFlight)
+			{
+				if (!Job->TimeoutError.IsEmpty())
+					continue;
+
+				const FPhaseTimeouts& Timeouts = Job->Timeouts;
+				const double Elapsed = Now - Job->AttemptStartTime;
+				if (!Job->bConnected && Timeouts.Connect > 0.0f && Elapsed > Timeouts.Connect)
+				{
+					Job->TimeoutError = FString::Printf(
+						TEXT("Error: Could not connect to the API server within %.0f s."), Timeouts.Connect);
+				}
+				else if (Job->BytesReceived == 0 && Timeouts.FirstByte > 0.0f && Elapsed > Timeouts.FirstByte)
+				{
+					Job->TimeoutError = FString::Printf(
+						TEXT("Error: The API server did not start answering within %.0f s."), Timeouts.FirstByte);
+				}
+				else if (Job->BytesReceived > 0 && Timeouts.Idle > 0.0f && Now - Job->LastReceiveTime > Timeouts.Idle)
+				{
+					Job->TimeoutError = FString::Printf(
+						TEXT("Error: The API server stopped answering for %.0f s."), Timeouts.Idle);
+				}
+
+				if (!Job->TimeoutError.IsEmpty())
+				{
+					TimedOut.Add(Job);
+				}
+			}
+		}
+	}
+
+	// The attempts complete as failed, and OnAttemptComplete reports why
+	for (const TSharedRef<FJob>& Job : TimedOut)
+	{
+		Job->HttpRequest->CancelRequest();
+	}
+}
+
+void FLLMRequestScheduler::OnAttemptComplete(ELLMProvider Provider, const TSharedRef<FJob>& Job,
+                                             FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Seconds = Now - Job->AttemptStartTime;
+	const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+
+	bool bRetry = false;
+	bool bShutDownBeforeRetry = false;
+	FString TimeoutError;
+	{
+		FScopeLock ScopeLock(&Lock);
+		FProviderState& State = GetProviderState(Provider);
+		State.InFlight.Remove(Job);
+		TimeoutError = MoveTemp(Job->TimeoutError);
+
+		if (Response.IsValid())
+		{
+			ApplyRateLimitHeaders(State, Response, Now);
+		}
+
+		if (bWasSuccessful && IsRateLimited(ResponseCode))
+		{
+			// Multiplicative decrease: the provider is telling us we are too many
+			State.ConcurrencyLimit = FMath::Max(1.0, State.ConcurrencyLimit * 0.5);
+
+			double RetryDelay = DefaultRetryDelaySeconds;
+			const FString RetryAfter = Response->GetHeader(TEXT("retry-after"));
+			if (!RetryAfter.IsEmpty() && FCString::IsNumeric(*RetryAfter))
+			{
+				RetryDelay = FCString::Atod(*RetryAfter);
+			}
+			State.BlockedUntil = FMath::Max(State.BlockedUntil, Now + RetryDelay);
+
+			// Retried ahead of everything else of its priority, it has waited longest. Once shut down,
+			// nothing would send it again.
+			bShutDownBeforeRetry = bShutDown && Job->NumAttempts < MaxAttempts;
+			bRetry = !bShutDown && Job->NumAttempts < MaxAttempts;
+			if (bRetry)
+			{
+				State.Queues[static_cast<int32>(Job->Priority)].Insert(Job, 0);
+			}
+		}
+		else if (bWasSuccessful && ResponseCode == 200)
+		{
+			// The whole attempt mostly measures how much was generated; the first byte measures the wait.
+			// Without progress reports there is no first byte, and the latency is left alone.
+			const double FirstByteSeconds = Job->FirstByteSeconds;
+			if (FirstByteSeconds > 0.0)
+			{
+				State.AverageLatency = State.AverageLatency > 0.0
+					                       ? FMath::Lerp(State.AverageLatency, FirstByteSeconds, 0.2)
+					                       : FirstByteSeconds;
+				State.BestLatency = State.BestLatency > 0.0
+					                    ? FMath::Min(State.BestLatency, FirstByteSeconds)
+					                    : FirstByteSeconds;
+			}
+
+			if (FirstByteSeconds > 0.0 && State.AverageLatency > State.BestLatency * CongestedLatencyFactor)
+			{
+				// Requests are queueing at the provider; more of them at once would only add to the wait
+				State.ConcurrencyLimit = FMath::Max(1.0, State.ConcurrencyLimit - 1.0);
+				State.AverageLatency = State.BestLatency * CongestedLatencyFactor;
+			}
+			else
+			{
+				// Additive increase: one more request at once for every full round of successes
+				State.ConcurrencyLimit += 1.0 / FMath::FloorToDouble(State.ConcurrencyLimit);
+			}
+		}
+	}
+
+	if (!bRetry)
+	{
+		if (bShutDownBeforeRetry)
+		{
+			Job->Promise.SetValue(ShutDownError);
+		}
+		else if (!TimeoutError.IsEmpty())
+		{
+			Job->Promise.SetValue(MoveTemp(TimeoutError));
+		}
+		else if (!bWasSuccessful && Job->Timeouts.Total > 0.0f && Seconds >= Job->Timeouts.Total)
+		{
+			Job->Promise.SetValue(FString::Printf(TEXT("Error: Request timed out after %.0f s."), Job->Timeouts.Total));
+		}
+		else
+		{
+			Job->Promise.SetValue(Job->ResponseHandler(Response, bWasSuccessful, Seconds));
+		}
+	}
+
+	// A slot is free, or the job is back in the queue
+	Pump();
+}
+
+void FLLMRequestScheduler::ApplyRateLimitHeaders(FProviderState& State, const FHttpResponsePtr& Response, double Now)
+{
+	// OpenAI sends x-ratelimit-*, Anthropic anthropic-ratelimit-*
+	struct FBucketHeaders
+	{
+		FTokenBucket& Bucket;
+		const TCHAR* Limit[2];
+		const TCHAR* Remaining[2];
+		const TCHAR* Reset[2];
+	};
+
+	const FBucketHeaders Buckets[] = {
+		{
+			State.Requests,
+			{TEXT("x-ratelimit-limit-requests"), TEXT("anthropic-ratelimit-requests-limit")},
+			{TEXT("x-ratelimit-remaining-requests"), TEXT("anthropic-ratelimit-requests-remaining")},
+			{TEXT("x-ratelimit-reset-requests"), TEXT("anthropic-ratelimit-requests-reset")}
+		},
+		{
+			State.Tokens,
+			{TEXT("x-ratelimit-limit-tokens"), TEXT("anthropic-ratelimit-tokens-limit")},
+			{TEXT("x-ratelimit-remaining-tokens"), TEXT("anthropic-ratelimit-tokens-remaining")},
+			{TEXT("x-ratelimit-reset-tokens"), TEXT("anthropic-ratelimit-tokens-reset")}
+		}
+	};
+
+	for (const FBucketHeaders& Headers : Buckets)
+	{
+		const FString Limit = GetFirstHeader(Response, Headers.Limit);
+		if (!Limit.IsEmpty())
+		{
+			Headers.Bucket.SetCapacity(FCString::Atod(*Limit));
+		}
+
+		const FString Remaining = GetFirstHeader(Response, Headers.Remaining);
+		if (Remaining.IsEmpty())
+			continue;
+
+		// Other clients may share the key, so the provider's count wins over ours
+		Headers.Bucket.Level = FMath::Min(Headers.Bucket.Level, FCString::Atod(*Remaining));
+		if (Headers.Bucket.Level < 1.0)
+		{
+			const double ResetDelay = ParseResetDelay(GetFirstHeader(Response, Headers.Reset));
+			State.BlockedUntil = FMath::Max(State.BlockedUntil, Now + ResetDelay);
+		}
+	}
+}
+
+double FLLMRequestScheduler::ParseResetDelay(const FString& Value)
+{
+	if (Value.IsEmpty())
+		return DefaultRetryDelaySeconds;
+
+	// Anthropic: RFC 3339 time of the reset
+	FDateTime ResetTime;
+	if (FDateTime::ParseIso8601(*Value, ResetTime))
+	{
+		return FMath::Max(0.0, (ResetTime - FDateTime::UtcNow()).GetTotalSeconds());
+	}
+
+	// OpenAI: duration such as "20ms", "1s" or "6m0s"
+	double Seconds = 0.0;
+	const TCHAR* Cursor = *Value;
+	while (*Cursor)
+	{
+		TCHAR* End = nullptr;
+		const double Number = FCString::Strtod(Cursor, &End);
+		if (End == Cursor)
+			return DefaultRetryDelaySeconds;
+
+		Cursor = End;
+		if (FCString::Strncmp(Cursor, TEXT("ms"), 2) == 0)
+		{
+			Seconds += Number / 1000.0;
+			Cursor += 2;
+		}
+		else if (*Cursor == TEXT('h') || *Cursor == TEXT('m') || *Cursor == TEXT('s'))
+		{
+			Seconds += Number * (*Cursor == TEXT('h') ? 3600.0 : *Cursor == TEXT('m') ? 60.0 : 1.0);
+			++Cursor;
+		}
+		else
+		{
+			// A bare number is seconds
+			Seconds += Number;
+		}
+	}
+	return Seconds;
+}
@@ -0,0 +1,149 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "LLMResponseCache.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Changing how keys are built orphans the old entries, which are then evicted as the oldest
+	constexpr uint32 CacheKeyVersion = 2;
+
+	const TCHAR* CacheEntryExtension = TEXT(".txt");
+}
+
+FLLMResponseCache& FLLMResponseCache::Get()
+{
+	static FLLMResponseCache Cache;
+	return Cache;
+}
+
+FString FLLMResponseCache::MakeKey(ELLMProvider Provider, FStringView Endpoint, FStringView Model,
+                                   FStringView SystemPrompt, float Temperature, int32 MaxTokens, FUtf8StringView Prompt)
+{
+	FXxHash128Builder Builder;
+	Builder.Update(&CacheKeyVersion, sizeof(CacheKeyVersion));
+	Builder.Update(&Provider, sizeof(Provider));
+	Builder.Update(&Temperature, sizeof(Temperature));
+	Builder.Update(&MaxTokens, sizeof(MaxTokens));
+
+	// Lengths keep the boundaries between the strings part of the hash
+	for (const FStringView Text : {Endpoint, Model, SystemPrompt})
+	{
+		const int32 Length = Text.Len();
+		Builder.Update(&Length, sizeof(Length));
+		Builder.Update(Text.GetData(), Length * sizeof(TCHAR));
+	}
+
+	// The prompt is hashed as the UTF-8 it is sent as
+	const int32 PromptLength = Prompt.Len();
+	Builder.Update(&PromptLength, sizeof(PromptLength));
+	Builder.Update(Prompt.GetData(), PromptLength);
+
+	const FXxHash128 Hash = Builder.Finalize();
+	return FString::Printf(TEXT("%016llx%016llx"), Hash.Hi, Hash.Lo);
+}
+
+FString FLLMResponseCache::GetCacheDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("UnrealMastermind") / TEXT("ResponseCache");
+}
+
+FString FLLMResponseCache::GetEntryPath(const FString& Key)
+{
+	return GetCacheDirectory() / Key + CacheEntryExtension;
+}
+
+void FLLMResponseCache::LoadIndex()
+{
+	if (bIndexLoaded)
+		return;
+
+	bIndexLoaded = true;
+
+	// The files are the index; their timestamps record when they were last used
+	IFileManager::Get().IterateDirectoryStat(*GetCacheDirectory(),
+		[this](const TCHAR* Filename, const FFileStatData& StatData)
+		{
+			const FString Path(Filename);
+			if (!StatData.bIsDirectory && Path.EndsWith(CacheEntryExtension))
+			{
+				Entries.Add(FPaths::GetBaseFilename(Path), {StatData.FileSize, StatData.ModificationTime});
+				TotalSize += StatData.FileSize;
+			}
+			return true;
+		});
+}
+
+bool FLLMResponseCache::Find(const FString& Key, FString& OutResponse)
+{
+	FScopeLock ScopeLock(&Lock);
+	LoadIndex();
+
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+		return false;
+
+	const FString Path = GetEntryPath(Key);
+	if (!FFileHelper::LoadFileToString(OutResponse, *Path))
+	{
+		// Deleted behind our back
+		TotalSize -= Entry->Size;
+		Entries.Remove(Key);
+		return false;
+	}
+
+	Entry->LastAccess = FDateTime::UtcNow();
+	IFileManager::Get().SetTimeStamp(*Path, Entry->LastAccess);
+	return true;
+}
+
+void FLLMResponseCache::Store(const FString& Key, const FString& Response, int64 MaxTotalSize)
+{
+	FScopeLock ScopeLock(&Lock);
+	LoadIndex();
+
+	const FString Path = GetEntryPath(Key);
+	if (!FFileHelper::SaveStringToFile(Response, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		return;
+
+	if (const FEntry* Existing = Entries.Find(Key))
+	{
+		TotalSize -= Existing->Size;
+	}
+
+	const int64 Size = IFileManager::Get().FileSize(*Path);
+	Entries.Add(Key, {Size, FDateTime::UtcNow()});
+	TotalSize += Size;
+
+	Evict(MaxTotalSize);
+}
+
+void FLLMResponseCache::Evict(int64 MaxTotalSize)
+{
+	if (TotalSize <= MaxTotalSize)
+		return;
+
+	TArray<TPair<FDateTime, FString>> ByAge;
+	ByAge.Reserve(Entries.Num());
+	for (const TPair<FString, FEntry>& Entry : Entries)
+	{
+		ByAge.Emplace(Entry.Value.LastAccess, Entry.Key);
+	}
+	ByAge.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (const TPair<FDateTime, FString>& Oldest : ByAge)
+	{
+		if (TotalSize <= MaxTotalSize)
+			break;
+
+		IFileManager::Get().Delete(*GetEntryPath(Oldest.Value), false, false, true);
+		TotalSize -= Entries.FindAndRemoveChecked(Oldest.Value).Size;
+	}
+}
@@ -0,0 +1,259 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "LLMResponseStream.h"
+#include "LLMJson.h"
+#include "Misc/ScopeLock.h"
+
+FLLMResponseStream::FLLMResponseStream(ELLMStreamFormat InFormat, FOnTextReceived InOnTextReceived)
+	: Format(InFormat)
+	, OnTextReceived(MoveTemp(InOnTextReceived))
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FLLMResponseStream::Restart()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Pending.Reset();
+	Body.Reset();
+	Fields = FLLMResponseFields();
+	StartTime = FPlatformTime::Seconds();
+	FirstTokenTime = -1.0;
+}
+
+bool FLLMResponseStream::Append(const void* Data, int64 Length)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const uint8* Bytes = static_cast<const uint8*>(Data);
+	Body.Append(Bytes, Length);
+	Pending.Append(Bytes, Length);
+
+	// Events end with an empty line; servers may use either \n or \r\n line endings
+	int32 EventStart = 0;
+	for (int32 Index = 0; Index + 1 < Pending.Num(); ++Index)
+	{
+		int32 SeparatorLength = 0;
+		if (Pending[Index] == '\n' && Pending[Index + 1] == '\n')
+		{
+			SeparatorLength = 2;
+		}
+		else if (Index + 3 < Pending.Num() && Pending[Index] == '\r' && Pending[Index + 1] == '\n' &&
+			Pending[Index + 2] == '\r' && Pending[Index + 3] == '\n')
+		{
+			SeparatorLength = 4;
+		}
+
+		if (SeparatorLength == 0)
+			continue;
+
+		ProcessEvent(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Pending.GetData() + EventStart),
+		                             Index - EventStart));
+		Index += SeparatorLength - 1;
+		EventStart = Index + 1;
+	}
+
+	Pending.RemoveAt(0, EventStart, EAllowShrinking::No);
+	return true;
+}
+
+void FLLMResponseStream::ProcessEvent(FUtf8StringView Event)
+{
+	// Only the data lines matter; event names are repeated in the payload's "type". Events nearly always
+	// have a single data line, which is decoded where it is; only more of them are joined first.
+	FUtf8StringView Data;
+	TArray<UTF8CHAR> JoinedData;
+	int32 NumDataLines = 0;
+	while (!Event.IsEmpty())
+	{
+		int32 LineEnd;
+		if (!Event.FindChar('\n', LineEnd))
+		{
+			LineEnd = Event.Len();
+		}
+
+		FUtf8StringView Line = Event.Left(LineEnd);
+		Event.RightChopInline(LineEnd + 1);
+		Line.TrimEndInline();
+
+		if (!Line.StartsWith(UTF8TEXT("data:")))
+			continue;
+
+		Line.RightChopInline(5);
+		Line.TrimStartInline();
+		if (NumDataLines++ == 0)
+		{
+			Data = Line;
+			continue;
+		}
+
+		if (JoinedData.IsEmpty())
+		{
+			JoinedData.Append(Data.GetData(), Data.Len());
+		}
+		JoinedData.Add('\n');
+		JoinedData.Append(Line.GetData(), Line.Len());
+		Data = FUtf8StringView(JoinedData.GetData(), JoinedData.Num());
+	}
+
+	if (!Data.IsEmpty())
+	{
+		ProcessData(Data);
+	}
+}
+
+void FLLMResponseStream::ProcessData(FUtf8StringView Data)
+{
+	if (Data.Equals(UTF8TEXT("[DONE]")))
+		return;
+
+	using FPath = FLLMJsonScanner::FPath;
+	using FValue = FLLMJsonScanner::FValue;
+
+	FString Piece;
+	bool bError = false;
+	FString ErrorMessage;
+	const bool bOpenAI = Format == ELLMStreamFormat::OpenAI;
+	const bool bParsed = FLLMJsonScanner::Scan(Data,
+		[this, bOpenAI, &Piece, &bError, &ErrorMessage](const FPath& Path, const FValue& Value)
+		{
+			const bool bString = Value.Type == FValue::EType::String;
+
+			// Both providers report failures mid-stream as {"error": {"message": ...}}
+			if (Path.Segments.Num() > 0 && Path.Segments[0].Key.Equals("error", ESearchCase::CaseSensitive))
+			{
+				bError = true;
+				if (bString && Path.Matches("error.message"))
+				{
+					ErrorMessage = Value.GetString();
+				}
+			}
+			else if (bOpenAI)
+			{
+				// Usage comes last, in a chunk of its own, since the request asks for it
+				if (bString && Path.Matches("choices.0.delta.content"))
+				{
+					Value.AppendString(Piece);
+				}
+				else if (bString && Path.Matches("choices.0.finish_reason"))
+				{
+					Fields.StopReason = Value.GetString();
+				}
+				else if (Path.Matches("usage.prompt_tokens"))
+				{
+					Fields.InputTokens = static_cast<int32>(Value.GetInt());
+				}
+				else if (Path.Matches("usage.completion_tokens"))
+				{
+					Fields.OutputTokens = static_cast<int32>(Value.GetInt());
+				}
+				else if (Path.Matches("usage.prompt_tokens_details.cached_tokens"))
+				{
+					Fields.CachedInputTokens = static_cast<int32>(Value.GetInt());
+				}
+			}
+			else
+			{
+				// Input tokens come with message_start, output tokens and the stop reason with message_delta,
+				// which may repeat the input tokens
+				if (bString && Path.Matches("delta.text"))
+				{
+					Value.AppendString(Piece);
+				}
+				else if (bString && Path.Matches("delta.stop_reason"))
+				{
+					Fields.StopReason = Value.GetString();
+				}
+				else if (Path.Matches("message.usage.input_tokens") || Path.Matches("usage.input_tokens"))
+				{
+					Fields.InputTokens = static_cast<int32>(Value.GetInt());
+				}
+				else if (Path.Matches("message.usage.cache_read_input_tokens") ||
+					Path.Matches("usage.cache_read_input_tokens"))
+				{
+					Fields.CachedInputTokens = static_cast<int32>(Value.GetInt());
+				}
+				else if (Path.Matches("message.usage.cache_creation_input_tokens") ||
+					Path.Matches("usage.cache_creation_input_tokens"))
+				{
+					Fields.CacheWriteInputTokens = static_cast<int32>(Value.GetInt());
+				}
+				else if (Path.Matches("usage.output_tokens"))
+				{
+					Fields.OutputTokens = static_cast<int32>(Value.GetInt());
+				}
+			}
+		});
+
+	if (!bParsed)
+		return;
+
+	if (bError)
+	{
+		Fields.Error = FString::Printf(TEXT("Error: %s"),
+		                               ErrorMessage.IsEmpty() ? TEXT("Unknown error occurred") : *ErrorMessage);
+		return;
+	}
+
+	if (Piece.IsEmpty())
+		return;
+
+	if (FirstTokenTime < 0.0)
+	{
+		FirstTokenTime = FPlatformTime::Seconds() - StartTime;
+	}
+
+	Fields.Content += Piece;
+	if (OnTextReceived)
+	{
+		OnTextReceived(Piece);
+	}
+}
+
+FLLMResponseFields FLLMResponseStream::Finish(FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FLLMResponseFields Result;
+	if (!bWasSuccessful || !Response.IsValid())
+	{
+		Result.Error = TEXT("Error: Failed to connect to the API server.");
+		return Result;
+	}
+
+	// Error responses are plain JSON rather than events; the stream delegate received them all the same
+	if (Response->GetResponseCode() != 200)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		Result.Error = FString::Printf(TEXT("Error: HTTP %d - %s"), Response->GetResponseCode(),
+		                              *FString(Converted.Length(), Converted.Get()));
+		return Result;
+	}
+
+	// Whatever is left is the last event, in case the server closed without a final empty line
+	if (!Pending.IsEmpty())
+	{
+		ProcessEvent(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Pending.GetData()), Pending.Num()));
+		Pending.Reset();
+	}
+
+	if (Fields.Error.IsEmpty() && Fields.Content.IsEmpty())
+	{
+		Fields.Error = TEXT("Error: The response stream contained no text.");
+	}
+
+	// Anthropic counts the prompt tokens read from and written to its cache apart from the others
+	Result = Fields;
+	if (Format == ELLMStreamFormat::Anthropic)
+	{
+		Result.InputTokens += Result.CachedInputTokens + Result.CacheWriteInputTokens;
+	}
+	return Result;
+}
+
+double FLLMResponseStream::GetTimeToFirstToken() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return FirstTokenTime;
+}
@@ -0,0 +1,407 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "LLMTokenizer.h"
+#include "UnrealMastermind.h"
+#include "UnrealMastermindSettings.h"
+#include "Hash/xxhash.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// The longest token in cl100k_base is 128 bytes, so longer pieces (long runs of one symbol, encoded data)
+	// are counted in chunks of this size; merging is quadratic in the length of a piece
+	constexpr int32 MaxPieceBytes = 256;
+
+	enum class ECharClass : uint8
+	{
+		Letter,
+		Number,
+		Newline,
+		Space,
+		Other
+	};
+
+	// The code point at Text[Index] and its size; a malformed byte counts as a character of its own
+	uint32 DecodeAt(const UTF8CHAR* Text, int32 Len, int32 Index, int32& OutBytes)
+	{
+		const uint8 Lead = static_cast<uint8>(Text[Index]);
+		int32 Count = Lead < 0x80 ? 1 : (Lead >> 5) == 0x6 ? 2 : (Lead >> 4) == 0xE ? 3 : (Lead >> 3) == 0x1E ? 4 : 1;
+		if (Index + Count > Len)
+		{
+			Count = 1;
+		}
+
+		uint32 CodePoint = Count == 1 ? Lead : Lead & (0x7F >> Count);
+		for (int32 Offset = 1; Offset < Count; ++Offset)
+		{
+			const uint8 Next = static_cast<uint8>(Text[Index + Offset]);
+			if ((Next & 0xC0) != 0x80)
+			{
+				Count = 1;
+				CodePoint = Lead;
+				break;
+			}
+			CodePoint = (CodePoint << 6) | (Next & 0x3F);
+		}
+
+		OutBytes = Count;
+		return CodePoint;
+	}
+
+	ECharClass Classify(uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			if ((CodePoint >= 'a' && CodePoint <= 'z') || (CodePoint >= 'A' && CodePoint <= 'Z'))
+				return ECharClass::Letter;
+			if (CodePoint >= '0' && CodePoint <= '9')
+				return ECharClass::Number;
+			if (CodePoint == '\r' || CodePoint == '\n')
+				return ECharClass::Newline;
+			if (CodePoint == ' ' || CodePoint == '\t' || CodePoint == '\v' || CodePoint == '\f')
+				return ECharClass::Space;
+			return ECharClass::Other;
+		}
+
+		// Beyond ASCII only the common whitespace, punctuation and symbol blocks are told apart from letters;
+		// the pieces of source-like text only depend on those
+		if (CodePoint == 0x85 || CodePoint == 0xA0 || CodePoint == 0x1680 || (CodePoint >= 0x2000 && CodePoint <= 0x200A) ||
+			CodePoint == 0x2028 || CodePoint == 0x2029 || CodePoint == 0x202F || CodePoint == 0x205F || CodePoint == 0x3000)
+			return ECharClass::Space;
+		if ((CodePoint < 0xC0 && CodePoint != 0xAA && CodePoint != 0xB5 && CodePoint != 0xBA) || CodePoint == 0xD7 ||
+			CodePoint == 0xF7 || (CodePoint >= 0x2000 && CodePoint <= 0x2BFF) || (CodePoint >= 0x3000 && CodePoint <= 0x303F) ||
+			(CodePoint >= 0xFE30 && CodePoint <= 0xFE4F) || (CodePoint >= 0xFF00 && CodePoint <= 0xFF20) ||
+			(CodePoint >= 0x1F000 && CodePoint < 0x20000))
+			return ECharClass::Other;
+		return ECharClass::Letter;
+	}
+
+	ECharClass ClassifyAt(const UTF8CHAR* Text, int32 Len, int32 Index, int32& OutBytes)
+	{
+		return Classify(DecodeAt(Text, Len, Index, OutBytes));
+	}
+
+	// End of the run of characters of one class that starts at Index
+	int32 SkipClass(const UTF8CHAR* Text, int32 Len, int32 Index, ECharClass Class)
+	{
+		int32 Bytes;
+		while (Index < Len && ClassifyAt(Text, Len, Index, Bytes) == Class)
+		{
+			Index += Bytes;
+		}
+		return Index;
+	}
+
+	ANSICHAR LowerAt(const UTF8CHAR* Text, int32 Len, int32 Index)
+	{
+		return Index < Len ? FCharAnsi::ToLower(static_cast<ANSICHAR>(Text[Index])) : '\0';
+	}
+
+	// End of the piece that starts at Start, following cl100k_base's pattern:
+	// 's|'t|'re|'ve|'m|'ll|'d (any case), [^\r\n\p{L}\p{N}]?\p{L}+, \p{N}{1,3}, ' '?[^\s\p{L}\p{N}]+[\r\n]*,
+	// \s*[\r\n]+, \s+(?!\S), \s+
+	int32 FindPieceEnd(const UTF8CHAR* Text, int32 Len, int32 Start)
+	{
+		int32 FirstBytes;
+		const uint32 First = DecodeAt(Text, Len, Start, FirstBytes);
+		const ECharClass FirstClass = Classify(First);
+		const int32 Next = Start + FirstBytes;
+
+		// Contractions
+		if (First == '\'')
+		{
+			const ANSICHAR A = LowerAt(Text, Len, Next);
+			if (A == 's' || A == 't' || A == 'm' || A == 'd')
+				return Next + 1;
+
+			const ANSICHAR B = LowerAt(Text, Len, Next + 1);
+			if ((A == 'r' && B == 'e') || (A == 'v' && B == 'e') || (A == 'l' && B == 'l'))
+				return Next + 2;
+		}
+
+		// Words, with the space or punctuation mark before them
+		const int32 WordStart = FirstClass == ECharClass::Letter ? Start
+			                        : FirstClass == ECharClass::Space || FirstClass == ECharClass::Other ? Next
+			                        : INDEX_NONE;
+		if (WordStart != INDEX_NONE && WordStart < Len)
+		{
+			int32 Bytes;
+			if (ClassifyAt(Text, Len, WordStart, Bytes) == ECharClass::Letter)
+				return SkipClass(Text, Len, WordStart, ECharClass::Letter);
+		}
+
+		// Numbers, 3 digits at a time
+		if (FirstClass == ECharClass::Number)
+		{
+			int32 End = Next;
+			int32 Bytes;
+			for (int32 Digits = 1; Digits < 3 && End < Len && ClassifyAt(Text, Len, End, Bytes) == ECharClass::Number; ++Digits)
+			{
+				End += Bytes;
+			}
+			return End;
+		}
+
+		// Punctuation, with the space before it and the line breaks after it
+		const int32 SymbolStart = First == ' ' ? Next : Start;
+		const int32 SymbolEnd = SkipClass(Text, Len, SymbolStart, ECharClass::Other);
+		if (SymbolEnd > SymbolStart)
+		{
+			int32 End = SymbolEnd;
+			int32 Bytes;
+			while (End < Len && ClassifyAt(Text, Len, End, Bytes) == ECharClass::Newline)
+			{
+				End += Bytes;
+			}
+			return End;
+		}
+
+		// Whitespace up to its last line break, or else up to the space that goes with the next word
+		int32 End = Start;
+		int32 LastStart = Start;
+		int32 AfterLastBreak = INDEX_NONE;
+		while (End < Len)
+		{
+			int32 Bytes;
+			const ECharClass Class = ClassifyAt(Text, Len, End, Bytes);
+			if (Class != ECharClass::Space && Class != ECharClass::Newline)
+				break;
+
+			LastStart = End;
+			End += Bytes;
+			if (Class == ECharClass::Newline)
+			{
+				AfterLastBreak = End;
+			}
+		}
+
+		if (AfterLastBreak != INDEX_NONE)
+			return AfterLastBreak;
+		if (End == Len || LastStart == Start)
+			return FMath::Max(End, Next);
+		return LastStart;
+	}
+
+	FString GetVocabularyFilename()
+	{
+		const FString& Configured = GetDefault<UUnrealMastermindSettings>()->TokenizerVocabulary.FilePath;
+		if (!Configured.IsEmpty())
+			return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Configured);
+
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealMastermind"));
+		return Plugin.IsValid() ? Plugin->GetBaseDir() / TEXT("Resources/Tokenizers/cl100k_base.tiktoken") : FString();
+	}
+}
+
+TSharedPtr<const FLLMTokenizer> FLLMTokenizer::GetConfigured()
+{
+	static FCriticalSection Lock;
+	static FString LoadedFilename;
+	static bool bLoaded = false;
+	static TSharedPtr<const FLLMTokenizer> Tokenizer;
+
+	const FString Filename = GetVocabularyFilename();
+
+	// Callers wait for a load in progress rather than estimate meanwhile
+	FScopeLock ScopeLock(&Lock);
+	if (!bLoaded || Filename != LoadedFilename)
+	{
+		bLoaded = true;
+		LoadedFilename = Filename;
+
+		const double StartTime = FPlatformTime::Seconds();
+		FString Error;
+		Tokenizer = LoadFromFile(Filename, Error);
+		if (Tokenizer.IsValid())
+		{
+			UE_LOG(LogUnrealMastermindLLM, Log, TEXT("Loaded the tokenizer vocabulary %s (%d tokens) in %.0f ms"),
+			       *Filename, Tokenizer->GetVocabularySize(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+		else
+		{
+			UE_LOG(LogUnrealMastermindLLM, Log,
+			       TEXT("%s; prompt tokens are estimated from the length instead. Scripts/fetch_tokenizer.py "
+				       "downloads the cl100k_base vocabulary"), *Error);
+		}
+	}
+	return Tokenizer;
+}
+
+TSharedPtr<const FLLMTokenizer> FLLMTokenizer::LoadFromFile(const FString& Filename, FString& OutError)
+{
+	TArray<uint8> File;
+	if (Filename.IsEmpty() || !FFileHelper::LoadFileToArray(File, *Filename, FILEREAD_Silent))
+	{
+		OutError = FString::Printf(TEXT("No tokenizer vocabulary at %s"), *Filename);
+		return nullptr;
+	}
+
+	const TSharedRef<FLLMTokenizer> Tokenizer = MakeShared<FLLMTokenizer>();
+
+	// Base64 takes 4 characters for every 3 bytes; the ranks make the estimate generous
+	Tokenizer->Bytes.Reserve(File.Num() * 3 / 4);
+	Tokenizer->Entries.Reserve(File.Num() / 10);
+
+	const ANSICHAR* Cursor = reinterpret_cast<const ANSICHAR*>(File.GetData());
+	const ANSICHAR* const End = Cursor + File.Num();
+	for (int32 LineNumber = 1; Cursor < End; ++LineNumber)
+	{
+		const ANSICHAR* LineEnd = Cursor;
+		while (LineEnd < End && *LineEnd != '\n')
+		{
+			++LineEnd;
+		}
+		const FAnsiStringView Line = FAnsiStringView(Cursor, static_cast<int32>(LineEnd - Cursor)).TrimEnd();
+		Cursor = LineEnd + 1;
+
+		if (Line.IsEmpty())
+			continue;
+
+		// "<base64 token> <rank>"
+		int32 Separator = INDEX_NONE;
+		bool bValid = Line.FindChar(' ', Separator) && Separator > 0 && Separator + 1 < Line.Len();
+
+		int64 Rank = 0;
+		for (int32 Index = Separator + 1; bValid && Index < Line.Len(); ++Index)
+		{
+			bValid = FCharAnsi::IsDigit(Line[Index]) && Rank <= MAX_int32 / 10;
+			Rank = Rank * 10 + (Line[Index] - '0');
+		}
+
+		FEntry Entry;
+		if (bValid)
+		{
+			Entry.Offset = Tokenizer->Bytes.Num();
+			Entry.Len = FBase64::GetDecodedDataSize(Line.GetData(), Separator);
+			Entry.Rank = static_cast<int32>(Rank);
+
+			Tokenizer->Bytes.AddUninitialized(Entry.Len);
+			bValid = Entry.Len > 0 &&
+				FBase64::Decode(Line.GetData(), Separator, Tokenizer->Bytes.GetData() + Entry.Offset);
+		}
+
+		if (!bValid)
+		{
+			OutError = FString::Printf(TEXT("Line %d of %s is not a base64 token and its rank, as in a .tiktoken file"),
+			                           LineNumber, *Filename);
+			return nullptr;
+		}
+		Tokenizer->Entries.Add(Entry);
+	}
+
+	if (Tokenizer->Entries.Num() == 0)
+	{
+		OutError = FString::Printf(TEXT("The tokenizer vocabulary %s is empty"), *Filename);
+		return nullptr;
+	}
+
+	Tokenizer->Bytes.Shrink();
+	Tokenizer->Entries.Shrink();
+	Tokenizer->BuildIndex();
+	return Tokenizer;
+}
+
+void FLLMTokenizer::BuildIndex()
+{
+	// At most half full, so lookups of pairs that aren't tokens, the most common kind, end quickly
+	Slots.Init(INDEX_NONE, FMath::RoundUpToPowerOfTwo(Entries.Num() * 2));
+	const uint32 Mask = Slots.Num() - 1;
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		uint32 Slot = static_cast<uint32>(FXxHash64::HashBuffer(Bytes.GetData() + Entry.Offset, Entry.Len).Hash) & Mask;
+		while (Slots[Slot] != INDEX_NONE)
+		{
+			Slot = (Slot + 1) & Mask;
+		}
+		Slots[Slot] = Index;
+	}
+}
+
+int32 FLLMTokenizer::FindRank(const UTF8CHAR* Token, int32 Len) const
+{
+	const uint32 Mask = Slots.Num() - 1;
+	for (uint32 Slot = static_cast<uint32>(FXxHash64::HashBuffer(Token, Len).Hash) & Mask;; Slot = (Slot + 1) & Mask)
+	{
+		const int32 Index = Slots[Slot];
+		if (Index == INDEX_NONE)
+			return INDEX_NONE;
+
+		const FEntry& Entry = Entries[Index];
+		if (Entry.Len == Len && FMemory::Memcmp(Bytes.GetData() + Entry.Offset, Token, Len) == 0)
+			return Entry.Rank;
+	}
+}
+
+int32 FLLMTokenizer::CountTokens(FUtf8StringView Text) const
+{
+	const UTF8CHAR* const Data = Text.GetData();
+	const int32 Len = Text.Len();
+
+	int32 Tokens = 0;
+	for (int32 Start = 0; Start < Len;)
+	{
+		const int32 End = FindPieceEnd(Data, Len, Start);
+		for (int32 ChunkStart = Start; ChunkStart < End;)
+		{
+			// Chunks end on a character boundary
+			int32 ChunkEnd = FMath::Min(ChunkStart + MaxPieceBytes, End);
+			while (ChunkEnd < End && ChunkEnd > ChunkStart + 1 && (static_cast<uint8>(Data[ChunkEnd]) & 0xC0) == 0x80)
+			{
+				--ChunkEnd;
+			}
+			Tokens += CountPieceTokens(Data + ChunkStart, ChunkEnd - ChunkStart);
+			ChunkStart = ChunkEnd;
+		}
+		Start = End;
+	}
+	return Tokens;
+}
+
+int32 FLLMTokenizer::CountPieceTokens(const UTF8CHAR* Piece, int32 Len) const
+{
+	if (Len <= 1 || FindRank(Piece, Len) != INDEX_NONE)
+		return Len > 0 ? 1 : 0;
+
+	// Parts start as single bytes; PairRanks[Part] is the rank of joining Part with the part after it
+	TArray<int32, TInlineAllocator<MaxPieceBytes + 1>> Starts;
+	TArray<int32, TInlineAllocator<MaxPieceBytes>> PairRanks;
+	for (int32 Index = 0; Index <= Len; ++Index)
+	{
+		Starts.Add(Index);
+	}
+	for (int32 Part = 0; Part + 2 < Starts.Num(); ++Part)
+	{
+		PairRanks.Add(FindRank(Piece + Part, 2));
+	}
+
+	// Join the pair with the lowest rank, leftmost first, until no pair is a token
+	for (;;)
+	{
+		int32 Best = INDEX_NONE;
+		for (int32 Part = 0; Part < PairRanks.Num(); ++Part)
+		{
+			if (PairRanks[Part] != INDEX_NONE && (Best == INDEX_NONE || PairRanks[Part] < PairRanks[Best]))
+			{
+				Best = Part;
+			}
+		}
+		if (Best == INDEX_NONE)
+			break;
+
+		Starts.RemoveAt(Best + 1, 1, EAllowShrinking::No);
+		PairRanks.RemoveAt(Best, 1, EAllowShrinking::No);
+
+		// Only the pairs on either side of the joined part changed
+		for (int32 Part = FMath::Max(Best - 1, 0); Part <= Best && Part < PairRanks.Num(); ++Part)
+		{
+			PairRanks[Part] = FindRank(Piece + Starts[Part], Starts[Part + 2] - Starts[Part]);
+		}
+	}
+	return Starts.Num() - 1;
+}
@@ -0,0 +1,157 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#include "PromptWriter.h"
+
+FPromptWriter& FPromptWriter::GetThreadLocal()
+{
+	static thread_local FPromptWriter Writer(64 * 1024);
+	Writer.Reset();
+	return Writer;
+}
+
+void FPromptWriter::Truncate(int32 NumBytes)
+{
+	if (NumBytes >= Buffer.Num())
+		return;
+
+	// Back up to the first byte of the character that would be cut in half
+	NumBytes = FMath::Max(NumBytes, 0);
+	while (NumBytes > 0 && (static_cast<uint8>(Buffer[NumBytes]) & 0xC0) == 0x80)
+	{
+		--NumBytes;
+	}
+	Buffer.SetNum(NumBytes, EAllowShrinking::No);
+}
+
+void FPromptWriter::Reserve(int32 NumBytes)
+{
+	if (NumBytes > Buffer.Max())
+	{
+		Buffer.Reserve(NumBytes);
+		++NumGrowths;
+	}
+}
+
+FString FPromptWriter::ToString() const
+{
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), Buffer.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+TArray<UTF8CHAR> FPromptWriter::MoveText()
+{
+	return MoveTemp(Buffer);
+}
+
+UTF8CHAR* FPromptWriter::AddUninitialized(int32 NumBytes)
+{
+	const int32 Required = Buffer.Num() + NumBytes;
+	if (Required > Buffer.Max())
+	{
+		// Grow geometrically so large prompts settle after a handful of reallocations
+		Reserve(FMath::Max(Required, Buffer.Max() * 2));
+	}
+
+	const int32 Offset = Buffer.AddUninitialized(NumBytes);
+	return Buffer.GetData() + Offset;
+}
+
+FPromptWriter& FPromptWriter::Append(FStringView Text)
+{
+	const TCHAR* Char = Text.GetData();
+	const TCHAR* const TextEnd = Char + Text.Len();
+	while (Char < TextEnd)
+	{
+		// ASCII is most of any prompt and is copied a run at a time
+		const TCHAR* const AsciiStart = Char;
+		while (Char < TextEnd && static_cast<uint32>(*Char) < 0x80)
+		{
+			++Char;
+		}
+		if (Char > AsciiStart)
+		{
+			const int32 NumAscii = UE_PTRDIFF_TO_INT32(Char - AsciiStart);
+			UTF8CHAR* Out = AddUninitialized(NumAscii);
+			for (int32 Index = 0; Index < NumAscii; ++Index)
+			{
+				Out[Index] = static_cast<UTF8CHAR>(AsciiStart[Index]);
+			}
+		}
+
+		// Everything else is encoded a run at a time, so surrogate pairs stay together
+		const TCHAR* const WideStart = Char;
+		while (Char < TextEnd && static_cast<uint32>(*Char) >= 0x80)
+		{
+			++Char;
+		}
+		if (Char > WideStart)
+		{
+			const int32 NumWide = UE_PTRDIFF_TO_INT32(Char - WideStart);
+			const int32 NumBytes = FPlatformString::ConvertedLength<UTF8CHAR>(WideStart, NumWide);
+			FPlatformString::Convert(AddUninitialized(NumBytes), NumBytes, WideStart, NumWide);
+		}
+	}
+	return *this;
+}
+
+FPromptWriter& FPromptWriter::Append(FUtf8StringView Text)
+{
+	if (Text.Len() > 0)
+	{
+		FMemory::Memcpy(AddUninitialized(Text.Len()), Text.GetData(), Text.Len());
+	}
+	return *this;
+}
+
+FPromptWriter& FPromptWriter::Append(TCHAR Char)
+{
+	if (static_cast<uint32>(Char) < 0x80)
+	{
+		*AddUninitialized(1) = static_cast<UTF8CHAR>(Char);
+		return *this;
+	}
+	return Append(FStringView(&Char, 1));
+}
+
+FPromptWriter& FPromptWriter::Append(FName Name)
+{
+	// Resolve into a stack buffer instead of allocating an FString
+	TCHAR NameBuffer[NAME_SIZE];
+	const uint32 NameLen = Name.ToString(NameBuffer);
+	return Append(FStringView(NameBuffer, NameLen));
+}
+
+FPromptWriter& FPromptWriter::AppendInt(int64 Value)
+{
+	UTF8CHAR Digits[24];
+	int32 NumDigits = 0;
+
+	const bool bNegative = Value < 0;
+	uint64 Magnitude = bNegative ? 0 - static_cast<uint64>(Value) : static_cast<uint64>(Value);
+	do
+	{
+		Digits[NumDigits++] = static_cast<UTF8CHAR>('0' + Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude > 0);
+
+	UTF8CHAR* Out = AddUninitialized(NumDigits + (bNegative ? 1 : 0));
+	if (bNegative)
+	{
+		*Out++ = '-';
+	}
+	while (NumDigits > 0)
+	{
+		*Out++ = Digits[--NumDigits];
+	}
+	return *this;
+}
+
+FPromptWriter& FPromptWriter::Indent(int32 NumSpaces)
+{
+	if (NumSpaces > 0)
+	{
+		FMemory::Memset(AddUninitialized(NumSpaces), ' ', NumSpaces);
+	}
+	return *this;
+}
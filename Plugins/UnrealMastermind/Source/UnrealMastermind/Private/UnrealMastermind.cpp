@@ -8,6 +8,14 @@
 #include "ToolMenus.h"
 #include "PropertyEditorModule.h"
 #include "BlueprintDetailsCustomization.h"
+#include "BlueprintDocumentationTags.h"
+#include "BlueprintGraphDatabase.h"
+#include "ComponentPropertyPlan.h"
+#include "LLMProviders.h"
+#include "LLMRequestScheduler.h"
+#include "LLMTokenizer.h"
+#include "Async/Async.h"
+#include "UnrealMastermindSettings.h"
 
 static const FName UnrealMastermindTabName("UnrealMastermind");
 
@@ -43,6 +51,22 @@ void FUnrealMastermindModule::StartupModule()
 	{
 		FModuleManager::Get().OnModulesChanged().AddRaw(this, &FUnrealMastermindModule::HandleModulesChanged);
 	}
+
+	FBlueprintDocumentationTags::Register();
+	FComponentPropertyPlanCache::Get().Initialize();
+	FBlueprintGraphDatabase::Get().Initialize();
+	FLLMRequestScheduler::Get().Initialize();
+
+	FLLMProviderRegistry& Providers = FLLMProviderRegistry::Get();
+	Providers.Register(ELLMProvider::OpenAI, MakeShared<FOpenAIProvider>());
+	Providers.Register(ELLMProvider::Anthropic, MakeShared<FAnthropicProvider>());
+	Providers.Register(ELLMProvider::Other, MakeShared<FGenericLLMProvider>());
+
+	// Loading the tokenizer vocabulary takes a moment, so it is ready before the first prompt is counted
+	Async(EAsyncExecution::ThreadPool, []()
+	{
+		FLLMTokenizer::GetConfigured();
+	});
 }
 
 void FUnrealMastermindModule::HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason) const
@@ -62,6 +86,15 @@ void FUnrealMastermindModule::ShutdownModule()
 	FUnrealMastermindStyle::Shutdown();
 	FUnrealMastermindCommands::Unregister();
 	FBlueprintDetailsCustomization::Unregister();
+	FBlueprintDocumentationTags::Unregister();
+	FComponentPropertyPlanCache::Get().Shutdown();
+	FBlueprintGraphDatabase::Get().Shutdown();
+	FLLMRequestScheduler::Get().Shutdown();
+
+	FLLMProviderRegistry& Providers = FLLMProviderRegistry::Get();
+	Providers.Unregister(ELLMProvider::OpenAI);
+	Providers.Unregister(ELLMProvider::Anthropic);
+	Providers.Unregister(ELLMProvider::Other);
 	
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(UnrealMastermindTabName);
 }
@@ -0,0 +1,492 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+// Developer console commands that measure the extraction and request paths.
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintExecutionFlow.h"
+#include "BlueprintGraphIR.h"
+#include "BlueprintIRRenderer.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MallocBase.h"
+#include "HAL/PlatformTLS.h"
+#include "LLMJson.h"
+#include "LLMPrompt.h"
+#include "PromptWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogUnrealMastermindBenchmark, Log, All);
+
+namespace
+{
+	// Forwards everything to the real allocator and counts the allocations made by one thread while it is GMalloc.
+	// Never destroyed: another thread may have read GMalloc just before it was put back and still call into it.
+	class FAllocationCountingMalloc final : public FMalloc
+	{
+	public:
+		static FAllocationCountingMalloc& Get()
+		{
+			static FAllocationCountingMalloc* const CountingMalloc = new FAllocationCountingMalloc(GMalloc);
+			return *CountingMalloc;
+		}
+
+		// False if another allocator replaced the one this forwards to, which then can't be swapped for it
+		bool Begin()
+		{
+			if (GMalloc != Inner)
+				return false;
+
+			NumAllocations = 0;
+			TrackedThreadId.store(FPlatformTLS::GetCurrentThreadId(), std::memory_order_relaxed);
+			GMalloc = this;
+			return true;
+		}
+
+		uint64 End()
+		{
+			GMalloc = Inner;
+			TrackedThreadId.store(0, std::memory_order_relaxed);
+			return NumAllocations;
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountIfTracked();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountIfTracked();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* MallocZeroed(SIZE_T Count, uint32 Alignment) override
+		{
+			CountIfTracked();
+			return Inner->MallocZeroed(Count, Alignment);
+		}
+
+		virtual void* TryMallocZeroed(SIZE_T Count, uint32 Alignment) override
+		{
+			CountIfTracked();
+			return Inner->TryMallocZeroed(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountIfTracked();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountIfTracked();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		// Containers grow into the slack of the real allocator's size classes, or they'd allocate more often
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			Inner->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			Inner->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual void UpdateStats() override
+		{
+			Inner->UpdateStats();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+		{
+			Inner->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+		{
+			Inner->DumpAllocatorStats(Ar);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return Inner->ValidateHeap();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("UnrealMastermindAllocationCounter");
+		}
+
+	private:
+		explicit FAllocationCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		void CountIfTracked()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == TrackedThreadId.load(std::memory_order_relaxed))
+			{
+				++NumAllocations;
+			}
+		}
+
+		FMalloc* const Inner;
+		std::atomic<uint32> TrackedThreadId{0};
+
+		// Only changed by the tracked thread
+		uint64 NumAllocations = 0;
+	};
+
+	struct FBenchmarkResult
+	{
+		uint64 NumAllocations = 0;
+		double Seconds = 0.0;
+		int32 OutputLen = 0;
+	};
+
+	template <typename FunctionType>
+	FBenchmarkResult MeasureAllocations(int32 Iterations, FunctionType&& Function)
+	{
+		FAllocationCountingMalloc& CountingMalloc = FAllocationCountingMalloc::Get();
+		const bool bCounting = CountingMalloc.Begin();
+		if (!bCounting)
+		{
+			UE_LOG(LogUnrealMastermindBenchmark, Warning, TEXT("GMalloc was replaced, allocations are not counted"));
+		}
+
+		FBenchmarkResult Result;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Result.OutputLen = Function();
+		}
+		Result.Seconds = FPlatformTime::Seconds() - StartTime;
+
+		if (bCounting)
+		{
+			Result.NumAllocations = CountingMalloc.End();
+		}
+		return Result;
+	}
+
+	// The execution flow and component sections as they were formatted before FPromptWriter:
+	// one FString::Printf temporary per line, appended with +=, and an FString::ChrN per indent.
+	// Only these sections, the bulk of a large Blueprint's prompt, so it does less than the text renderer.
+	int32 RenderWithPrintf(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings)
+	{
+		struct FPrintfVisitor
+		{
+			const FBlueprintIRGraph& Graph;
+			FString& BlueprintInfo;
+
+			void Node(int32 NodeIndex, int32 Depth)
+			{
+				const FBlueprintIRNode& Node = Graph.Nodes[NodeIndex];
+				FString Indent = FString::ChrN(Depth * 2, ' ');
+				BlueprintInfo += FString::Printf(TEXT("%s→ %s\n"), *Indent, *Node.Title);
+				for (int32 PinIndex = 0; PinIndex < Node.NumPins; ++PinIndex)
+				{
+					const FBlueprintIRPin& Pin = Graph.GetPin(Node, PinIndex);
+					if (Pin.bIsInput && !Pin.bIsExec)
+					{
+						const int32 Source = Graph.GetFirstLinkedNode(Pin);
+						FString PinValue = Source != INDEX_NONE
+							                   ? FString::Printf(TEXT("Connected to %s"), *Graph.Nodes[Source].Title)
+							                   : Pin.DefaultValue;
+						BlueprintInfo += FString::Printf(TEXT("%s  Input: %s (%s) = %s\n"), *Indent,
+						                                 *Pin.Name.ToString(), *Pin.Category.ToString(), *PinValue);
+					}
+				}
+			}
+
+			void BackReference(int32 NodeIndex, int32 Depth)
+			{
+				FString Indent = FString::ChrN(Depth * 2, ' ');
+				BlueprintInfo += FString::Printf(TEXT("%s→ (continues at #%d %s)\n"), *Indent, NodeIndex,
+				                                 *Graph.Nodes[NodeIndex].Title);
+			}
+
+			void BranchLabel(int32 PinIndex, int32 Depth)
+			{
+				FString Indent = FString::ChrN(Depth * 2, ' ');
+				BlueprintInfo += FString::Printf(TEXT("%s[%s]\n"), *Indent, *Graph.Pins[PinIndex].Name.ToString());
+			}
+
+			void DepthLimit(int32 Depth)
+			{
+				FString Indent = FString::ChrN((Depth - 1) * 2, ' ');
+				BlueprintInfo += FString::Printf(TEXT("%s→ ... (Max depth reached) ...\n"), *Indent);
+			}
+		};
+
+		FString BlueprintInfo;
+		TArray<int32, TInlineAllocator<4>> ExecPins;
+		for (const FBlueprintIRGraph& Graph : IR.Graphs)
+		{
+			BlueprintInfo += FString::Printf(TEXT("- %s\n"), *Graph.Name);
+
+			FBlueprintExecutionFlowWalker Walker(Graph);
+			FPrintfVisitor Visitor{Graph, BlueprintInfo};
+			for (const int32 EntryIndex : Graph.EntryNodes)
+			{
+				BlueprintInfo += FString::Printf(TEXT("  Event: %s\n"), *Graph.Nodes[EntryIndex].FullTitle);
+				Walker.GetExecOutputs(EntryIndex, ExecPins);
+				for (const int32 ExecPin : ExecPins)
+				{
+					Walker.Walk(ExecPin, 2, Settings.MaxExecutionFlowDepth, Visitor);
+				}
+			}
+		}
+
+		for (const FBlueprintIRComponent& Component : IR.Components)
+		{
+			BlueprintInfo += FString::Printf(TEXT("- %s (%s)\n"), *Component.Name, *Component.ClassName);
+			for (int32 PropIndex = Component.FirstProperty; PropIndex < Component.FirstProperty + Component.NumProperties; ++PropIndex)
+			{
+				BlueprintInfo += FString::Printf(TEXT("    %s: %s\n"), *IR.Properties[PropIndex].Name,
+				                                 *IR.Properties[PropIndex].Value);
+			}
+		}
+
+		return BlueprintInfo.Len();
+	}
+
+	// The text renderer that builds the prompt, into the thread-local FPromptWriter
+	int32 RenderWithWriter(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings)
+	{
+		FPromptWriter& Out = FPromptWriter::GetThreadLocal();
+		FBlueprintIRRendererRegistry::Render(FBlueprintIRRendererRegistry::Text, IR, Settings, Out);
+		return Out.Len();
+	}
+
+	UBlueprint* FindBlueprintByName(const FString& BlueprintName)
+	{
+		const FAssetRegistryModule& AssetRegistryModule =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+
+		TArray<FAssetData> BlueprintAssets;
+		AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
+		for (const FAssetData& Asset : BlueprintAssets)
+		{
+			if (Asset.AssetName.ToString() == BlueprintName)
+			{
+				return Cast<UBlueprint>(Asset.GetAsset());
+			}
+		}
+		return nullptr;
+	}
+
+	void BenchmarkExtraction(const TArray<FString>& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogUnrealMastermindBenchmark, Display,
+			       TEXT("Usage: UnrealMastermind.BenchmarkExtraction <BlueprintName> [Iterations]"));
+			return;
+		}
+
+		UBlueprint* Blueprint = FindBlueprintByName(Args[0]);
+		if (!Blueprint)
+		{
+			UE_LOG(LogUnrealMastermindBenchmark, Warning, TEXT("Blueprint '%s' not found"), *Args[0]);
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+
+		FBlueprintDocumentationSettings Settings;
+		Settings.ComponentDetailLevel = FBlueprintDocumentationSettings::EComponentDetailLevel::Full;
+		Settings.MaxExecutionFlowDepth = 64;
+		const FBlueprintIR IR = FBlueprintIRBuilder::Build(Blueprint, Settings);
+
+		// Warm the thread-local writer so the measurement shows steady state
+		RenderWithWriter(IR, Settings);
+
+		const FBenchmarkResult Printf = MeasureAllocations(Iterations, [&]() { return RenderWithPrintf(IR, Settings); });
+		const FBenchmarkResult Writer = MeasureAllocations(Iterations, [&]() { return RenderWithWriter(IR, Settings); });
+
+		UE_LOG(LogUnrealMastermindBenchmark, Display, TEXT("%s: %d iterations"), *Args[0], Iterations);
+		UE_LOG(LogUnrealMastermindBenchmark, Display,
+		       TEXT("  Printf + FString: %8llu allocations/iteration, %.3f ms/iteration, %d characters"),
+		       Printf.NumAllocations / Iterations, Printf.Seconds * 1000.0 / Iterations, Printf.OutputLen);
+		UE_LOG(LogUnrealMastermindBenchmark, Display,
+		       TEXT("  Text renderer:    %8llu allocations/iteration, %.3f ms/iteration, %d bytes"),
+		       Writer.NumAllocations / Iterations, Writer.Seconds * 1000.0 / Iterations, Writer.OutputLen);
+	}
+
+	FAutoConsoleCommand BenchmarkExtractionCommand(
+		TEXT("UnrealMastermind.BenchmarkExtraction"),
+		TEXT("Compares heap allocations and time of Printf-based prompt formatting and the text renderer for a Blueprint"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkExtraction));
+
+	// A prompt the size of a large Blueprint, with the quotes, line breaks and non-ASCII arrows of a real one
+	FString MakeSyntheticPrompt(int32 SizeBytes)
+	{
+		const FString Line = TEXT("  → Set \"Health\" (float) = Connected to Get Max Health\n\t[Then]\n");
+		FString Prompt;
+		Prompt.Reserve(SizeBytes + Line.Len());
+		while (Prompt.Len() < SizeBytes)
+		{
+			Prompt += Line;
+		}
+		return Prompt;
+	}
+
+	// The request body as it was built before FLLMJsonWriter: a DOM, serialized to an FString that
+	// SetContentAsString then converts to UTF-8
+	int32 WriteRequestWithDom(const FString& Prompt)
+	{
+		const TSharedRef<FJsonObject> RequestJsonObject = MakeShared<FJsonObject>();
+		RequestJsonObject->SetStringField(TEXT("model"), TEXT("gpt-4o"));
+
+		TArray<TSharedPtr<FJsonValue>> MessagesArray;
+		const TSharedPtr<FJsonObject> UserMessageObject = MakeShared<FJsonObject>();
+		UserMessageObject->SetStringField(TEXT("role"), TEXT("user"));
+		UserMessageObject->SetStringField(TEXT("content"), Prompt);
+		MessagesArray.Add(MakeShared<FJsonValueObject>(UserMessageObject));
+		RequestJsonObject->SetArrayField(TEXT("messages"), MessagesArray);
+		RequestJsonObject->SetNumberField(TEXT("max_tokens"), 4096);
+
+		FString RequestBody;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
+		FJsonSerializer::Serialize(RequestJsonObject, Writer);
+
+		const FTCHARToUTF8 Converted(*RequestBody, RequestBody.Len());
+		return Converted.Length();
+	}
+
+	// The request body as it is built now, from the prompt as the UTF-8 it was extracted as
+	int32 WriteRequestWithWriter(const FLLMPrompt& Prompt)
+	{
+		FLLMJsonWriter Json(Prompt.Len() + 256);
+		Json.BeginObject();
+		Json.Key("model").String(TEXT("gpt-4o"));
+		Json.Key("messages").BeginArray();
+		Json.BeginObject().Key("role").String(TEXT("user")).Key("content").String(Prompt.GetView()).EndObject();
+		Json.EndArray();
+		Json.Key("max_tokens").Int(4096);
+		Json.EndObject();
+		return Json.MoveBytes().Num();
+	}
+
+	// The response as it was read before FLLMJsonScanner: converted to an FString, then parsed into a DOM
+	int32 ReadResponseWithDom(const TArray<uint8>& Body)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		const FString ResponseText(Converted.Length(), Converted.Get());
+
+		TSharedPtr<FJsonObject> JsonObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseText);
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+			return 0;
+
+		const TArray<TSharedPtr<FJsonValue>> Choices = JsonObject->GetArrayField(TEXT("choices"));
+		return Choices[0]->AsObject()->GetObjectField(TEXT("message"))->GetStringField(TEXT("content")).Len();
+	}
+
+	int32 ReadResponseWithScanner(const TArray<uint8>& Body)
+	{
+		FString Content;
+		FLLMJsonScanner::Scan(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Body.GetData()), Body.Num()),
+			[&Content](const FLLMJsonScanner::FPath& Path, const FLLMJsonScanner::FValue& Value)
+			{
+				if (Path.Matches("choices.0.message.content"))
+				{
+					Value.AppendString(Content);
+				}
+			});
+		return Content.Len();
+	}
+
+	void LogJsonResult(const TCHAR* Name, const FBenchmarkResult& Result, int32 Iterations, int32 SizeBytes)
+	{
+		const double MegabytesPerSecond = Result.Seconds > 0.0
+			                                  ? static_cast<double>(SizeBytes) * Iterations / Result.Seconds / (1024.0 * 1024.0)
+			                                  : 0.0;
+		UE_LOG(LogUnrealMastermindBenchmark, Display,
+		       TEXT("  %-20s %8llu allocations/iteration, %.3f ms/iteration, %.0f MB/s"), Name,
+		       Result.NumAllocations / Iterations, Result.Seconds * 1000.0 / Iterations, MegabytesPerSecond);
+	}
+
+	void BenchmarkJson(const TArray<FString>& Args)
+	{
+		const int32 SizeMB = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+		const FString Prompt = MakeSyntheticPrompt(SizeMB * 1024 * 1024);
+
+		FPromptWriter PromptWriter;
+		PromptWriter << Prompt;
+		const FLLMPrompt Utf8Prompt(PromptWriter.MoveText());
+
+		// A Chat Completions response with the prompt as its content
+		FLLMJsonWriter Response;
+		Response.BeginObject();
+		Response.Key("id").String(TEXT("chatcmpl-benchmark"));
+		Response.Key("choices").BeginArray().BeginObject();
+		Response.Key("index").Int(0);
+		Response.Key("message").BeginObject().Key("role").String(TEXT("assistant")).Key("content").String(Prompt).EndObject();
+		Response.Key("finish_reason").String(TEXT("stop"));
+		Response.EndObject().EndArray();
+		Response.Key("usage").BeginObject().Key("prompt_tokens").Int(1000).Key("completion_tokens").Int(1000).EndObject();
+		Response.EndObject();
+		const TArray<uint8> ResponseBody = Response.MoveBytes();
+
+		const FBenchmarkResult RequestDom = MeasureAllocations(Iterations, [&]() { return WriteRequestWithDom(Prompt); });
+		const FBenchmarkResult RequestWriter = MeasureAllocations(Iterations, [&]() { return WriteRequestWithWriter(Utf8Prompt); });
+		const FBenchmarkResult ResponseDom = MeasureAllocations(Iterations, [&]() { return ReadResponseWithDom(ResponseBody); });
+		const FBenchmarkResult ResponseScanner = MeasureAllocations(Iterations, [&]() { return ReadResponseWithScanner(ResponseBody); });
+
+		UE_LOG(LogUnrealMastermindBenchmark, Display, TEXT("Request: %d bytes, %d iterations"), RequestWriter.OutputLen,
+		       Iterations);
+		LogJsonResult(TEXT("FJsonObject:"), RequestDom, Iterations, RequestWriter.OutputLen);
+		LogJsonResult(TEXT("FLLMJsonWriter:"), RequestWriter, Iterations, RequestWriter.OutputLen);
+
+		UE_LOG(LogUnrealMastermindBenchmark, Display, TEXT("Response: %d bytes, %d iterations"), ResponseBody.Num(),
+		       Iterations);
+		LogJsonResult(TEXT("FJsonObject:"), ResponseDom, Iterations, ResponseBody.Num());
+		LogJsonResult(TEXT("FLLMJsonScanner:"), ResponseScanner, Iterations, ResponseBody.Num());
+	}
+
+	FAutoConsoleCommand BenchmarkJsonCommand(
+		TEXT("UnrealMastermind.BenchmarkJson"),
+		TEXT("Compares heap allocations and throughput of DOM-based and streaming JSON for a request and a response "
+			"of the given size. Usage: UnrealMastermind.BenchmarkJson [SizeMB] [Iterations]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkJson));
+}
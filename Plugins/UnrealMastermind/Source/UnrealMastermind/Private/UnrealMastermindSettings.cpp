@@ -6,12 +6,38 @@ UUnrealMastermindSettings::UUnrealMastermindSettings()
 {
 	// Default provider
 	SelectedProvider = ELLMProvider::OpenAI;
+	MaxConcurrentRequests = 4;
+	RequestsPerMinute = 0;
+	TokensPerMinute = 0;
+	bStreamResponses = true;
+	bUsePromptCaching = true;
+	bUseResponseCache = true;
+	ResponseCacheSizeMB = 256;
+	ConnectTimeoutSeconds = 15.0f;
+	FirstByteTimeoutSeconds = 60.0f;
+	IdleTimeoutSeconds = 30.0f;
+	RequestTimeoutSeconds = 600.0f;
+	bHedgeRequests = false;
+	HedgeProvider = ELLMProvider::Anthropic;
+	HedgeLatencyPercentile = 95.0f;
+	HedgeDelaySeconds = 10.0f;
 
 	// Default model settings
 	OpenAIModel = TEXT("gpt-4");
 	OpenAIEndpoint = TEXT("https://api.openai.com/v1/chat/completions");
 	AnthropicModel = TEXT("claude-3-5-haiku-latest");
 	AnthropicApiEndpoint = TEXT("https://api.anthropic.com/v1/messages");
+	OpenAIServerSlot = -1;
+
+	// Prompt size limits; gpt-4 has an 8k context shared with the response
+	OpenAIMaxInputTokens = 4000;
+	AnthropicMaxInputTokens = 150000;
+	OtherProviderMaxInputTokens = 4000;
+
+	// Prices differ per model, so none is assumed
+	InputCostPerMillionTokens = 0.0f;
+	CachedInputCostPerMillionTokens = 0.0f;
+	OutputCostPerMillionTokens = 0.0f;
 
 	// Default documentation settings
 	bIncludeVariableDescriptions = true;
@@ -22,6 +48,8 @@ UUnrealMastermindSettings::UUnrealMastermindSettings()
 	MaxExecutionFlowDepth = 5;
 	bTrackVariableUsage = true;
 	ComponentDetailLevel = 1;
+	SnapshotFrameBudgetMs = 4.0f;
+	bSplitLargeBlueprints = true;
 	MaxTokens = 4000;
 	Temperature = 0.5f;
 
@@ -41,6 +69,36 @@ UUnrealMastermindSettings::UUnrealMastermindSettings()
 		"Format the documentation in a clear, structured way with headings, bullet points, and code-like notation for Blueprint nodes. Dont specifically document individual node behaviours such as ForEach Loops, Then etc. Instead focus on summarizing the behaviour, intention and functionality of the blueprint.");
 }
 
+FBlueprintDocumentationSettings UUnrealMastermindSettings::MakeDocumentationSettings() const
+{
+	FBlueprintDocumentationSettings DocSettings;
+	DocSettings.ComponentDetailLevel = static_cast<FBlueprintDocumentationSettings::EComponentDetailLevel>(
+		ComponentDetailLevel);
+	DocSettings.bTrackVariableUsage = bTrackVariableUsage;
+	DocSettings.MaxExecutionFlowDepth = MaxExecutionFlowDepth;
+	DocSettings.bIncludeComments = bIncludeComments;
+	DocSettings.IgnoredPropertyPrefixes = IgnoredPropertyPrefixes;
+	return DocSettings;
+}
+
+int32 UUnrealMastermindSettings::GetMaxInputTokens() const
+{
+	return GetMaxInputTokens(SelectedProvider);
+}
+
+int32 UUnrealMastermindSettings::GetMaxInputTokens(ELLMProvider Provider) const
+{
+	switch (Provider)
+	{
+	case ELLMProvider::OpenAI:
+		return OpenAIMaxInputTokens;
+	case ELLMProvider::Anthropic:
+		return AnthropicMaxInputTokens;
+	default:
+		return OtherProviderMaxInputTokens;
+	}
+}
+
 FName UUnrealMastermindSettings::GetCategoryName() const
 {
 	return FName("Plugins");
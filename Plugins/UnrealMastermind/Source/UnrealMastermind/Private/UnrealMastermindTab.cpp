@@ -4,21 +4,21 @@
 #include "LLMConnector.h"
 #include "BlueprintDocumentation.h"
 #include "BlueprintDocumentationSettings.h"
-#include "EdGraphNode_Comment.h"
-#include "K2Node_Event.h"
+#include "BlueprintDocumentationTags.h"
+#include "BlueprintDocumentationMapReduce.h"
+#include "BlueprintGraphDatabase.h"
+#include "BlueprintGraphIR.h"
+#include "BlueprintIRRenderer.h"
+#include "BlueprintPromptBudget.h"
+#include "BlueprintSnapshot.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Input/SComboBox.h"
 #include "Widgets/Input/SSpinBox.h"
 #include "AssetRegistry/AssetRegistryModule.h"
-#include "K2Node_FunctionEntry.h"
-#include "K2Node_VariableGet.h"
-#include "K2Node_VariableSet.h"
 #include "SSearchableComboBox.h"
 #include "UnrealMastermindSettings.h"
-#include "EdGraph/EdGraphPin.h"
-#include "Engine/SCS_Node.h"
-#include "Engine/SimpleConstructionScript.h"
+#include "Framework/Application/SlateApplication.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
@@ -308,6 +308,20 @@ void SUnrealMastermindTab::Construct(const FArguments& InArgs)
 			]
 		]
 
+		// Request Estimate
+		+ SVerticalBox::Slot()
+		  .AutoHeight()
+		  .Padding(10, 5, 10, 0)
+		[
+			SAssignNew(RequestEstimateText, STextBlock)
+			.ToolTipText(FText::FromString("Prompt tokens of the selected Blueprint against the provider's Max Input Tokens, "
+				"and the cost and time to expect from the prices in the plugin settings and recent requests"))
+			.Visibility_Lambda([this]() -> EVisibility
+			{
+				return RequestEstimateText->GetText().IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible;
+			})
+		]
+
 		// Buttons
 		+ SVerticalBox::Slot()
 		  .AutoHeight()
@@ -322,10 +336,23 @@ void SUnrealMastermindTab::Construct(const FArguments& InArgs)
 				SNew(SButton)
 				.HAlign(HAlign_Center)
 				.Text(FText::FromString("Generate Documentation"))
+				.ToolTipText(FText::FromString("Shift-click to ask the AI model again instead of reusing a cached response"))
 				.OnClicked(this, &SUnrealMastermindTab::OnGenerateDocumentationClicked)
 				.IsEnabled_Lambda([this]() -> bool { return !bIsGenerating; })
 			]
 
+			+ SHorizontalBox::Slot()
+			  .AutoWidth()
+			  .Padding(5, 0)
+			[
+				SNew(SButton)
+				.HAlign(HAlign_Center)
+				.Text(FText::FromString("Estimate"))
+				.ToolTipText(FText::FromString("Count the prompt tokens and estimate the cost and time of generating, without contacting the AI model"))
+				.OnClicked(this, &SUnrealMastermindTab::OnEstimateClicked)
+				.IsEnabled_Lambda([this]() -> bool { return !bIsGenerating; })
+			]
+
 			+ SHorizontalBox::Slot()
 			  .FillWidth(1.0f)
 			  .Padding(5, 0, 0, 0)
@@ -433,41 +460,76 @@ void SUnrealMastermindTab::SelectBlueprint(const FString& BlueprintName)
 
 void SUnrealMastermindTab::OnBlueprintSelected(TSharedPtr<FString> SelectedItem, ESelectInfo::Type SelectInfo)
 {
-	if (SelectedItem.IsValid())
+	if (!SelectedItem.IsValid())
+		return;
+
+	CurrentSelectedBlueprint = SelectedItem;
+	SelectedBlueprintText->SetText(FText::FromString(*SelectedItem));
+
+	FAssetData Asset;
+	if (!FindSelectedAsset(Asset))
 	{
-		CurrentSelectedBlueprint = SelectedItem;
-		SelectedBlueprintText->SetText(FText::FromString(*SelectedItem));
+		// Invalid blueprint, clear the text area
+		ShowDocumentation(FString());
+		return;
+	}
 
-		// Check if the selected blueprint has documentation and load it
-		if (UBlueprint* Blueprint = GetSelectedBlueprint())
-		{
-			if (FString ExistingDocumentation = UBlueprintDocumentation::GetDocumentation(Blueprint); !
-				ExistingDocumentation.IsEmpty())
-			{
-				// Existing documentation found, load it
-				GeneratedDocumentation = ExistingDocumentation;
-				DocumentationTextBox->SetText(FText::FromString(GeneratedDocumentation));
-			}
-			else
-			{
-				// No documentation found, clear the text area
-				GeneratedDocumentation = TEXT("");
-				DocumentationTextBox->SetText(FText::FromString(TEXT("")));
-			}
-		}
-		else
-		{
-			// Invalid blueprint, clear the text area
-			GeneratedDocumentation = TEXT("");
-			DocumentationTextBox->SetText(FText::FromString(TEXT("")));
-		}
+	// A loaded Blueprint may have documentation that is not saved yet, so its metadata comes first
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset.FastGetAsset(false)))
+	{
+		ShowDocumentation(UBlueprintDocumentation::GetDocumentation(Blueprint));
+		return;
+	}
+
+	FBlueprintDocumentationState State;
+	if (!FBlueprintDocumentationTags::GetState(Asset, State))
+	{
+		// Saved before the tags; only the package knows
+		ShowDocumentation(UBlueprintDocumentation::GetDocumentation(Cast<UBlueprint>(Asset.GetAsset())));
+		return;
 	}
+
+	if (!State.bDocumented)
+	{
+		ShowDocumentation(FString());
+		return;
+	}
+
+	// The preview until the package is loaded in the background; nothing to save until then
+	GeneratedDocumentation.Empty();
+	DocumentationTextBox->SetText(FText::FromString(State.Preview));
+
+	LoadPackageAsync(Asset.PackageName.ToString(), FLoadPackageAsyncDelegate::CreateSPLambda(
+		this, [this, SelectedItem, AssetPath = Asset.GetSoftObjectPath()](
+		const FName&, UPackage*, EAsyncLoadingResult::Type Result)
+		{
+			// Another Blueprint may have been picked meanwhile
+			if (CurrentSelectedBlueprint != SelectedItem || bIsGenerating)
+				return;
+
+			UBlueprint* Blueprint = Result == EAsyncLoadingResult::Succeeded
+				                        ? Cast<UBlueprint>(AssetPath.ResolveObject())
+				                        : nullptr;
+			ShowDocumentation(UBlueprintDocumentation::GetDocumentation(Blueprint));
+		}));
+}
+
+void SUnrealMastermindTab::ShowDocumentation(const FString& Documentation)
+{
+	GeneratedDocumentation = Documentation;
+	DocumentationTextBox->SetText(FText::FromString(GeneratedDocumentation));
 }
 
 UBlueprint* SUnrealMastermindTab::GetSelectedBlueprint() const
+{
+	FAssetData Asset;
+	return FindSelectedAsset(Asset) ? Cast<UBlueprint>(Asset.GetAsset()) : nullptr;
+}
+
+bool SUnrealMastermindTab::FindSelectedAsset(FAssetData& OutAsset) const
 {
 	if (!CurrentSelectedBlueprint.IsValid())
-		return nullptr;
+		return false;
 
 	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<
 		FAssetRegistryModule>("AssetRegistry");
@@ -479,463 +541,323 @@ UBlueprint* SUnrealMastermindTab::GetSelectedBlueprint() const
 
 	AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
 
-	for (const FAssetData& Asset : BlueprintAssets)
+	for (FAssetData& Asset : BlueprintAssets)
 	{
 		if (Asset.AssetName.ToString() == *CurrentSelectedBlueprint)
 		{
-			return Cast<UBlueprint>(Asset.GetAsset());
+			OutAsset = MoveTemp(Asset);
+			return true;
 		}
 	}
 
-	return nullptr;
+	return false;
 }
 
-void SUnrealMastermindTab::ExtractEventGraphInfo(UBlueprint* Blueprint, const FBlueprintDocumentationSettings& Settings,
-                                                 FString& BlueprintInfo)
+FLLMPrompt SUnrealMastermindTab::ExtractBlueprintInfo(const FBlueprintIR& Snapshot,
+                                                      const FBlueprintDocumentationSettings& Settings,
+                                                      int32 TokenBudget,
+                                                      FBlueprintPromptBudgetReport& OutReport)
 {
-	BlueprintInfo += TEXT("\nEvent Graphs:\n");
-	for (UEdGraph* EventGraph : Blueprint->UbergraphPages)
-	{
-		BlueprintInfo += FString::Printf(TEXT("- %s\n"), *EventGraph->GetName());
-
-		// Find event nodes
-		TArray<UK2Node_Event*> EventNodes;
-		for (UEdGraphNode* Node : EventGraph->Nodes)
-		{
-			if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
-			{
-				EventNodes.Add(EventNode);
-			}
-		}
+	if (!Snapshot.IsValid())
+		return FLLMPrompt(UTF8TEXTVIEW("Invalid Blueprint"));
 
-		// Process each event
-		for (UK2Node_Event* EventNode : EventNodes)
-		{
-			BlueprintInfo += FString::Printf(
-				TEXT("  Event: %s\n"), *EventNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+	// Other formats can be rendered from the same snapshot
+	FPromptWriter& Writer = FPromptWriter::GetThreadLocal();
+	OutReport = FBlueprintPromptBudget::Render(FBlueprintIRRendererRegistry::Text, Snapshot, Settings, TokenBudget,
+	                                           Writer);
 
-			// Follow execution flow from this event
-			for (UEdGraphPin* Pin : EventNode->Pins)
-			{
-				if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == "exec")
-				{
-					TraceExecutionFlow(Pin, BlueprintInfo, 2, Settings.MaxExecutionFlowDepth);
-					break;
-				}
-			}
-			BlueprintInfo += TEXT("\n");
-		}
-	}
+	// Copied out: the writer is reused by anything else this thread renders before the prompt is sent
+	return FLLMPrompt(Writer.ToView());
 }
 
-void SUnrealMastermindTab::ExtractFunctionGraphInfo(UBlueprint* Blueprint,
-                                                    const FBlueprintDocumentationSettings& Settings,
-                                                    FString& BlueprintInfo)
+FReply SUnrealMastermindTab::OnGenerateDocumentationClicked()
 {
-	BlueprintInfo += TEXT("\nFunctions:\n");
-	for (UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
-	{
-		BlueprintInfo += FString::Printf(TEXT("- %s\n"), *FunctionGraph->GetName());
-
-		// Find function entry node to get parameters
-		UK2Node_FunctionEntry* EntryNode = nullptr;
-		for (UEdGraphNode* Node : FunctionGraph->Nodes)
-		{
-			if (UK2Node_FunctionEntry* PotentialEntryNode = Cast<UK2Node_FunctionEntry>(Node))
-			{
-				EntryNode = PotentialEntryNode;
-				break;
-			}
-		}
-
-		if (EntryNode)
-		{
-			// Parameters
-			BlueprintInfo += TEXT("  Parameters:\n");
-			for (UEdGraphPin* Pin : EntryNode->Pins)
-			{
-				if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory != "exec")
-				{
-					BlueprintInfo += FString::Printf(TEXT("    - %s (%s)\n"),
-					                                 *Pin->PinName.ToString(),
-					                                 *Pin->PinType.PinCategory.ToString());
-				}
-			}
+	CachePolicy = FSlateApplication::Get().GetModifierKeys().IsShiftDown()
+		              ? ELLMCachePolicy::Refresh
+		              : ELLMCachePolicy::Use;
 
-			// Node execution flow - follow the exec lines
-			BlueprintInfo += TEXT("  Execution Flow:\n");
-			for (UEdGraphPin* Pin : EntryNode->Pins)
-			{
-				// Find the 'then' execution pin
-				if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == "exec")
-				{
-					TraceExecutionFlow(Pin, BlueprintInfo, 1, Settings.MaxExecutionFlowDepth);
-					break;
-				}
-			}
-		}
-	}
+	AnalyzeSelectedBlueprint(false);
+	return FReply::Handled();
 }
 
-void SUnrealMastermindTab::ExtractVariableInfo(UBlueprint* Blueprint, FString& BlueprintInfo) const
+FReply SUnrealMastermindTab::OnEstimateClicked()
 {
-	// Add this to track where variables are used
-	BlueprintInfo += TEXT("\nVariable Usages:\n");
-	for (FBPVariableDescription& Variable : Blueprint->NewVariables)
-	{
-		FString VarName = Variable.VarName.ToString();
-		BlueprintInfo += FString::Printf(TEXT("- %s is used in:\n"), *VarName);
-
-		// Search all graphs for references to this variable
-		bool bFoundUsage = false;
-		for (UEdGraph* Graph : Blueprint->UbergraphPages)
-		{
-			for (UEdGraphNode* Node : Graph->Nodes)
-			{
-				// Look for get/set variable nodes
-				const UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node);
-				const UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node);
-
-				if ((GetNode && GetNode->VariableReference.GetMemberName() == Variable.VarName) ||
-					(SetNode && SetNode->VariableReference.GetMemberName() == Variable.VarName))
-				{
-					UEdGraph* OwningGraph = Node->GetGraph();
-					BlueprintInfo += FString::Printf(TEXT("    %s (%s)\n"),
-					                                 *OwningGraph->GetName(),
-					                                 GetNode ? TEXT("Read") : TEXT("Write"));
-					bFoundUsage = true;
-				}
-			}
-		}
-
-		if (!bFoundUsage)
-		{
-			BlueprintInfo += TEXT("    Not used in any graph\n");
-		}
-	}
+	AnalyzeSelectedBlueprint(true);
+	return FReply::Handled();
 }
 
-FString SUnrealMastermindTab::ExtractBlueprintInfo(UBlueprint* Blueprint,
-                                                   const FBlueprintDocumentationSettings& Settings =
-	                                                   FBlueprintDocumentationSettings())
+void SUnrealMastermindTab::AnalyzeSelectedBlueprint(bool bEstimateOnly)
 {
-	if (!Blueprint)
-		return TEXT("Invalid Blueprint");
-
-	FString BlueprintInfo;
-
-	// Basic Blueprint Info
-	if (Settings.bIncludeBasicInfo)
-	{
-		BlueprintInfo += FString::Printf(TEXT("Blueprint Name: %s\n"), *Blueprint->GetName());
-		BlueprintInfo += FString::Printf(TEXT("Parent Class: %s\n\n"), *Blueprint->ParentClass->GetName());
-	}
-
-	// Variables
-	if (Settings.bIncludeVariables)
+	UBlueprint* SelectedBlueprint = GetSelectedBlueprint();
+	if (!SelectedBlueprint)
 	{
-		ExtractVariableInfo(Blueprint, BlueprintInfo);
+		// Show error notification
+		FNotificationInfo Info(FText::FromString("Please select a valid Blueprint first."));
+		Info.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return;
 	}
 
-	ExtractEventGraphInfo(Blueprint, Settings, BlueprintInfo);
-	ExtractFunctionGraphInfo(Blueprint, Settings, BlueprintInfo);
+	// Get the custom prompt text from the UI thread BEFORE starting background work
+	FString CustomPromptText = CustomPromptTextBox->GetText().ToString();
 
-	// Enhanced component information
-	if (Blueprint->SimpleConstructionScript)
-	{
-		if (TArray<USCS_Node*> ComponentNodes = Blueprint->SimpleConstructionScript->GetAllNodes(); ComponentNodes.Num()
-			> 0)
-		{
-			BlueprintInfo += TEXT("\nComponents:\n");
-			for (const USCS_Node* Node : ComponentNodes)
-			{
-				// Basic component info
-				BlueprintInfo += FString::Printf(TEXT("- %s (%s)\n"),
-				                                 *Node->GetVariableName().ToString(),
-				                                 *Node->ComponentClass->GetName());
-
-				// Component properties (optional, can be verbose)
-				UActorComponent* TemplateComponent = Node->ComponentTemplate;
-				if (TemplateComponent)
-				{
-					if (Settings.ComponentDetailLevel !=
-						FBlueprintDocumentationSettings::EComponentDetailLevel::Minimal)
-					{
-						// Add important properties for Basic level
-						AddImportantComponentProperties(BlueprintInfo, TemplateComponent, Node);
+	// Get the persistent settings
+	const UUnrealMastermindSettings* PersistentSettings = GetDefault<UUnrealMastermindSettings>();
+	const FBlueprintDocumentationSettings DocSettings = PersistentSettings->MakeDocumentationSettings();
 
-						// Add all non-default properties for Full level
-						if (Settings.ComponentDetailLevel ==
-							FBlueprintDocumentationSettings::EComponentDetailLevel::Full)
-						{
-							AddAllComponentProperties(BlueprintInfo, TemplateComponent, Node,
-							                          Settings.IgnoredPropertyPrefixes);
-						}
-					}
-				}
-			}
-		}
-	}
+	// Show the loading indicator
+	SetGenerationStatus(true, 0.0f, "Analyzing Blueprint structure...");
 
-	//Extract comments
-	BlueprintInfo += TEXT("\nDocumentation Comments:\n");
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	// Clear previous results
+	if (!bEstimateOnly)
 	{
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (UEdGraphNode_Comment* CommentNode = Cast<UEdGraphNode_Comment>(Node))
-			{
-				BlueprintInfo += FString::Printf(TEXT("- [%s] %s\n"),
-				                                 *Graph->GetName(), *CommentNode->NodeComment);
-			}
-		}
+		StreamedDocumentation.Reset();
+		DocumentationTextBox->SetText(FText::FromString(""));
 	}
 
-	return BlueprintInfo;
-}
-
-// Helper method for important properties
-void SUnrealMastermindTab::AddImportantComponentProperties(FString& BlueprintInfo, UActorComponent* Component,
-                                                           const USCS_Node* Node) const
-{
-	// Only add the most important properties
-	FString ImportantProps[] = {
-		"RelativeLocation",
-		"RelativeRotation",
-		"RelativeScale3D",
-		"AttachParent",
-		"Mobility"
-	};
-
-	for (const FString& PropName : ImportantProps)
+	// Without unsaved changes the stored snapshot of the saved package is as good as a new one
+	const UPackage* Package = SelectedBlueprint->GetPackage();
+	if (!Package->IsDirty())
 	{
-		FProperty* Property = Component->GetClass()->FindPropertyByName(FName(*PropName));
-		if (Property)
+		if (TSharedPtr<const FBlueprintIR> StoredSnapshot =
+			FBlueprintGraphDatabase::Get().FindFresh(Package->GetFName(), DocSettings))
 		{
-			void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Component);
-			FString ValueStr;
-			Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, nullptr, PPF_None);
-
-			if (!ValueStr.IsEmpty() && ValueStr != TEXT("()"))
-			{
-				BlueprintInfo += FString::Printf(TEXT("    %s: %s\n"), *PropName, *ValueStr);
-			}
+			OnSnapshotComplete(MoveTemp(StoredSnapshot), DocSettings, MoveTemp(CustomPromptText), bEstimateOnly);
+			return;
 		}
 	}
-}
-
-// Helper method for all properties
-void SUnrealMastermindTab::AddAllComponentProperties(FString& BlueprintInfo, UActorComponent* Component,
-                                                     const USCS_Node* Node,
-                                                     const TArray<FString>& IgnoredPrefixes) const
-{
-	for (TFieldIterator<FProperty> PropIt(Component->GetClass()); PropIt; ++PropIt)
-	{
-		FProperty* Property = *PropIt;
-		const FString PropName = Property->GetName();
 
-		// Skip if we should ignore this property
-		bool bShouldIgnore = false;
-		for (const FString& Prefix : IgnoredPrefixes)
-		{
-			if (PropName.StartsWith(Prefix))
+	// Snapshot the Blueprint on the game thread, spread over frames so large Blueprints don't hitch the editor
+	TWeakObjectPtr<const UPackage> WeakPackage(Package);
+	ActiveSnapshot = MakeShared<FBlueprintSnapshotTask>(SelectedBlueprint, DocSettings,
+	                                                    PersistentSettings->SnapshotFrameBudgetMs);
+	ActiveSnapshot->Start(
+		FBlueprintSnapshotTask::FOnComplete::CreateSPLambda(
+			this, [this, WeakPackage, DocSettings, CustomPromptText, bEstimateOnly](TSharedPtr<const FBlueprintIR> Snapshot)
 			{
-				bShouldIgnore = true;
-				break;
-			}
-		}
-
-		if (bShouldIgnore || Property->HasAnyPropertyFlags(CPF_Deprecated | CPF_Transient))
-			continue;
-
-		void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Component);
-		FString ValueStr;
-		Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, nullptr, PPF_None);
-
-		if (!ValueStr.IsEmpty() && ValueStr != TEXT("()"))
+				// Taken from the saved state, so keep it for later runs and project-wide scans
+				if (Snapshot.IsValid() && WeakPackage.IsValid() && !WeakPackage->IsDirty())
+				{
+					FBlueprintGraphDatabase::Get().Store(WeakPackage->GetFName(), *Snapshot, DocSettings);
+				}
+				OnSnapshotComplete(Snapshot, DocSettings, CustomPromptText, bEstimateOnly);
+			}),
+		FBlueprintSnapshotTask::FOnProgress::CreateSPLambda(this, [this](float Progress)
 		{
-			BlueprintInfo += FString::Printf(TEXT("    %s: %s\n"), *PropName, *ValueStr);
-		}
-	}
+			SetGenerationStatus(true, Progress * 0.3f, "Analyzing Blueprint structure...");
+		}));
 }
 
-void SUnrealMastermindTab::TraceExecutionFlow(UEdGraphPin* ExecPin, FString& BlueprintInfo, int32 Depth, int32 MaxDepth)
+void SUnrealMastermindTab::OnSnapshotComplete(TSharedPtr<const FBlueprintIR> Snapshot,
+                                              FBlueprintDocumentationSettings DocSettings, FString CustomPromptText,
+                                              bool bEstimateOnly)
 {
-	// Get the setting if not provided
-	if (MaxDepth <= 0)
-	{
-		const UUnrealMastermindSettings* Settings = GetDefault<UUnrealMastermindSettings>();
-		MaxDepth = Settings->MaxExecutionFlowDepth;
-	}
+	ActiveSnapshot.Reset();
 
-	// Stop if we've reached the maximum depth
-	if (Depth > MaxDepth)
+	if (!Snapshot.IsValid())
 	{
-		FString Indent = FString::ChrN((Depth - 1) * 2, ' ');
-		BlueprintInfo += FString::Printf(TEXT("%s→ ... (Max depth reached) ...\n"), *Indent);
-		return;
-	}
+		SetGenerationStatus(false, 0.0f, "Blueprint is no longer available");
 
-	// Stop if we have no pin or no connections
-	if (!ExecPin || ExecPin->LinkedTo.Num() == 0)
+		FNotificationInfo Info(FText::FromString("The Blueprint was removed before it could be analyzed."));
+		Info.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
 		return;
+	}
 
-	// Follow the first connection
-	UEdGraphPin* ConnectedPin = ExecPin->LinkedTo[0];
-	UEdGraphNode* ConnectedNode = ConnectedPin->GetOwningNode();
+	// Keep the prompt within what the selected provider accepts
+	const int32 TokenBudget = ULLMConnector::GetBlueprintInfoTokenBudget(CustomPromptText);
 
-	// Indentation based on depth
-	FString Indent = FString::ChrN(Depth * 2, ' ');
+	const UUnrealMastermindSettings* PersistentSettings = GetDefault<UUnrealMastermindSettings>();
+	const bool bSplitLargeBlueprints = PersistentSettings->bSplitLargeBlueprints;
+	const int32 MaxConcurrentRequests = PersistentSettings->MaxConcurrentRequests;
 
-	// Describe the node
-	UK2Node* K2Node = Cast<UK2Node>(ConnectedNode);
-	if (K2Node)
+	// Everything from here on only reads the snapshot, so it can run on a background thread. Requests can outlive
+	// the tab through streaming, retries and hedging, so callbacks only touch it if it is still open.
+	const TWeakPtr<SUnrealMastermindTab> WeakThis = SharedThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+	          [WeakThis, Snapshot, TokenBudget, bSplitLargeBlueprints, MaxConcurrentRequests, CachePolicy = CachePolicy,
+		          bEstimateOnly, DocSettings = MoveTemp(DocSettings), CustomPromptText = MoveTemp(CustomPromptText)]()
 	{
-		// Add node title/type
-		BlueprintInfo += FString::Printf(
-			TEXT("%s→ %s\n"), *Indent, *K2Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
-
-		// Add input/output values
-		for (UEdGraphPin* Pin : K2Node->Pins)
+		// Extract blueprint info
+		FBlueprintPromptBudgetReport BudgetReport;
+		const FLLMPrompt BlueprintInfo = ExtractBlueprintInfo(*Snapshot, DocSettings, TokenBudget, BudgetReport);
+
+		// Counted locally before anything is sent
+		const int32 NumParts = BudgetReport.WasReduced() && bSplitLargeBlueprints
+			                       ? FBlueprintDocumentationMapReduce::CountParts(*Snapshot)
+			                       : 1;
+		const bool bSplit = NumParts > 1;
+		const FLLMRequestEstimate Estimate =
+			ULLMConnector::EstimateDocumentation(BlueprintInfo.GetView(), CustomPromptText);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Estimate, NumParts, bEstimateOnly]()
 		{
-			if (Pin->Direction == EGPD_Input && Pin->PinType.PinCategory != "exec")
-			{
-				FString PinValue = GetPinValue(Pin);
-				BlueprintInfo += FString::Printf(TEXT("%s  Input: %s (%s) = %s\n"),
-				                                 *Indent, *Pin->PinName.ToString(),
-				                                 *Pin->PinType.PinCategory.ToString(), *PinValue);
-			}
-		}
+			const TSharedPtr<SUnrealMastermindTab> This = WeakThis.Pin();
+			if (!This.IsValid())
+				return;
 
-		// Follow the next execution pin
-		for (UEdGraphPin* Pin : K2Node->Pins)
-		{
-			if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == "exec")
+			This->ShowRequestEstimate(Estimate, NumParts);
+			if (bEstimateOnly)
 			{
-				TraceExecutionFlow(Pin, BlueprintInfo, Depth + 1, MaxDepth);
-				break;
+				This->SetGenerationStatus(false, 0.0f, "Estimate complete");
 			}
-		}
-	}
-}
+		});
 
-FString SUnrealMastermindTab::GetPinValue(UEdGraphPin* Pin) const
-{
-	// For connected pins, show what they connect to
-	if (Pin->LinkedTo.Num() > 0)
-	{
-		const UEdGraphPin* ConnectedPin = Pin->LinkedTo[0];
-		const UEdGraphNode* ConnectedNode = ConnectedPin->GetOwningNode();
-		return FString::Printf(
-			TEXT("Connected to %s"), *ConnectedNode->GetNodeTitle(ENodeTitleType::ListView).ToString());
-	}
+		if (bEstimateOnly)
+			return;
 
-	// For literal values
-	return Pin->DefaultValue;
-}
+		const FString SourceHash = UBlueprintDocumentation::ComputeSourceHash(*Snapshot, DocSettings, CustomPromptText);
 
-FReply SUnrealMastermindTab::OnGenerateDocumentationClicked()
-{
-	UBlueprint* SelectedBlueprint = GetSelectedBlueprint();
-	if (!SelectedBlueprint)
-	{
-		// Show error notification
-		FNotificationInfo Info(FText::FromString("Please select a valid Blueprint first."));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-		return FReply::Handled();
-	}
-
-	// Get the custom prompt text from the UI thread BEFORE starting background work
-	FString CustomPromptText = CustomPromptTextBox->GetText().ToString();
-
-	// Show the loading indicator
-	SetGenerationStatus(true, 0.0f, "Analyzing Blueprint structure...");
+		// Show the documentation as it is written when the response is streamed
+		const double RequestStartTime = FPlatformTime::Seconds();
+		FLLMRequestOptions Options;
+		Options.CachePolicy = CachePolicy;
+		Options.OnTextReceived = [WeakThis, RequestStartTime](const FString& Text)
+		{
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Text, RequestStartTime]()
+			{
+				if (const TSharedPtr<SUnrealMastermindTab> This = WeakThis.Pin())
+				{
+					This->OnDocumentationTextReceived(Text, RequestStartTime);
+				}
+			});
+		};
 
-	// Clear previous results
-	DocumentationTextBox->SetText(FText::FromString(""));
+		TFuture<FString> Documentation;
+		if (bSplit)
+		{
+			// Too large for one prompt: document each function and event on its own, then combine them
+			AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+			{
+				if (const TSharedPtr<SUnrealMastermindTab> This = WeakThis.Pin())
+				{
+					This->SetGenerationStatus(true, 0.3f, "Documenting each function and event...");
+				}
+			});
 
-	// Generate documentation on a background thread to not freeze UI
-	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, SelectedBlueprint, CustomPromptText]()
-	{
-		// Get the persistent settings
-		const UUnrealMastermindSettings* PersistentSettings = GetDefault<UUnrealMastermindSettings>();
-
-		// Create a documentation settings instance and populate from persistent settings
-		FBlueprintDocumentationSettings DocSettings;
-		DocSettings.ComponentDetailLevel = static_cast<FBlueprintDocumentationSettings::EComponentDetailLevel>(
-			PersistentSettings->ComponentDetailLevel);
-		DocSettings.bTrackVariableUsage = PersistentSettings->bTrackVariableUsage;
-		DocSettings.MaxExecutionFlowDepth = PersistentSettings->MaxExecutionFlowDepth;
-		DocSettings.bIncludeComments = PersistentSettings->bIncludeComments;
-		DocSettings.IgnoredPropertyPrefixes = PersistentSettings->IgnoredPropertyPrefixes;
+			Documentation = FBlueprintDocumentationMapReduce::Generate(
+				*Snapshot, DocSettings, CustomPromptText, TokenBudget, MaxConcurrentRequests,
+				[WeakThis](int32 NumComplete, int32 NumParts)
+				{
+					AsyncTask(ENamedThreads::GameThread, [WeakThis, NumComplete, NumParts]()
+					{
+						const TSharedPtr<SUnrealMastermindTab> This = WeakThis.Pin();
+						if (!This.IsValid())
+							return;
+
+						This->SetGenerationStatus(true, 0.3f + 0.4f * NumComplete / NumParts,
+						                          NumComplete < NumParts
+							                          ? FString::Printf(TEXT("Documented %d of %d parts..."),
+							                                            NumComplete, NumParts)
+							                          : FString(TEXT("Combining the documentation...")));
+					});
+				},
+				Options);
+		}
+		else
+		{
+			// Update UI to show we're contacting the LLM
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, BudgetReport]()
+			{
+				const TSharedPtr<SUnrealMastermindTab> This = WeakThis.Pin();
+				if (!This.IsValid())
+					return;
 
-		// Extract blueprint info
-		const FString BlueprintInfo = ExtractBlueprintInfo(SelectedBlueprint, DocSettings);
+				This->SetGenerationStatus(true, 0.3f, "Contacting AI model...");
 
-		// Update UI to show we're contacting the LLM
-		AsyncTask(ENamedThreads::GameThread, [this]()
-		{
-			SetGenerationStatus(true, 0.3f, "Contacting AI model...");
-		});
+				// Tell the user what was left out, so a thinner result isn't a surprise
+				if (BudgetReport.WasReduced())
+				{
+					FNotificationInfo BudgetInfo(FText::FromString(BudgetReport.ToString()));
+					BudgetInfo.ExpireDuration = 8.0f;
+					FSlateNotificationManager::Get().AddNotification(BudgetInfo);
+				}
+			});
 
-		// Create the LLM connector and generate documentation
-		ULLMConnector* LLMConnector = NewObject<ULLMConnector>();
-		FString GeneratedDoc = LLMConnector->GenerateDocumentation(BlueprintInfo, CustomPromptText);
+			Documentation = ULLMConnector::GenerateDocumentation(BlueprintInfo.GetView(), CustomPromptText, Options);
+		}
 
-		// Update UI to show we're processing the response
-		AsyncTask(ENamedThreads::GameThread, [this]()
+		// The response completes the future; update the UI on the game thread
+		Documentation.Next([WeakThis, SourceHash](FString GeneratedDoc)
 		{
-			SetGenerationStatus(true, 0.7f, "Processing response...");
-		});
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, SourceHash, GeneratedDoc = MoveTemp(GeneratedDoc)]()
+			{
+				// The tab was closed while the documentation was being written
+				const TSharedPtr<SUnrealMastermindTab> This = WeakThis.Pin();
+				if (!This.IsValid())
+					return;
 
-		// Small delay to show the progress bar moving
-		FPlatformProcess::Sleep(0.5f);
+				// Now it's safe to update UI elements
+				This->GeneratedDocumentation = GeneratedDoc;
+				This->GeneratedSourceHash = SourceHash;
+				This->DocumentationTextBox->SetText(FText::FromString(This->GeneratedDocumentation));
 
-		// Update the UI on the game thread
-		AsyncTask(ENamedThreads::GameThread, [this, GeneratedDoc]()
-		{
-			// Now it's safe to update UI elements
-			GeneratedDocumentation = GeneratedDoc;
-			DocumentationTextBox->SetText(FText::FromString(GeneratedDocumentation));
+				// Hide the loading indicator
+				This->SetGenerationStatus(false, 1.0f, "Generation complete");
 
-			// Hide the loading indicator
-			SetGenerationStatus(false, 1.0f, "Generation complete");
+				// Check if the result contains an error message
+				bool bIsError = This->GeneratedDocumentation.StartsWith(TEXT("Error:"));
 
-			// Check if the result contains an error message
-			bool bIsError = GeneratedDocumentation.StartsWith(TEXT("Error:"));
+				// Show appropriate notification
+				if (bIsError)
+				{
+					// Extract error message (limited to first line)
+					FString ErrorMessage = This->GeneratedDocumentation;
+					int32 NewlineIndex;
+					if (ErrorMessage.FindChar('\n', NewlineIndex))
+					{
+						ErrorMessage = ErrorMessage.Left(NewlineIndex);
+					}
 
-			// Show appropriate notification
-			if (bIsError)
-			{
-				// Extract error message (limited to first line)
-				FString ErrorMessage = GeneratedDocumentation;
-				int32 NewlineIndex;
-				if (ErrorMessage.FindChar('\n', NewlineIndex))
+					// Show error notification
+					FNotificationInfo ErrorInfo(FText::FromString(ErrorMessage));
+					ErrorInfo.ExpireDuration = 5.0f;
+					ErrorInfo.bUseSuccessFailIcons = true;
+					ErrorInfo.Image = FCoreStyle::Get().GetBrush(TEXT("MessageLog.Error"));
+					FSlateNotificationManager::Get().AddNotification(ErrorInfo);
+				}
+				else
 				{
-					ErrorMessage = ErrorMessage.Left(NewlineIndex);
+					// Show success notification
+					FNotificationInfo SuccessInfo(FText::FromString("Documentation generated successfully!"));
+					SuccessInfo.ExpireDuration = 3.0f;
+					SuccessInfo.bUseSuccessFailIcons = true;
+					SuccessInfo.Image = FCoreStyle::Get().GetBrush(TEXT("MessageLog.Success"));
+					FSlateNotificationManager::Get().AddNotification(SuccessInfo);
 				}
-
-				// Show error notification
-				FNotificationInfo ErrorInfo(FText::FromString(ErrorMessage));
-				ErrorInfo.ExpireDuration = 5.0f;
-				ErrorInfo.bUseSuccessFailIcons = true;
-				ErrorInfo.Image = FCoreStyle::Get().GetBrush(TEXT("MessageLog.Error"));
-				FSlateNotificationManager::Get().AddNotification(ErrorInfo);
-			}
-			else
-			{
-				// Show success notification
-				FNotificationInfo SuccessInfo(FText::FromString("Documentation generated successfully!"));
-				SuccessInfo.ExpireDuration = 3.0f;
-				SuccessInfo.bUseSuccessFailIcons = true;
-				SuccessInfo.Image = FCoreStyle::Get().GetBrush(TEXT("MessageLog.Success"));
-				FSlateNotificationManager::Get().AddNotification(SuccessInfo);
-			}
+			});
 		});
 	});
+}
 
-	return FReply::Handled();
+void SUnrealMastermindTab::ShowRequestEstimate(const FLLMRequestEstimate& Estimate, int32 NumParts)
+{
+	FString Text = Estimate.ToString();
+	if (NumParts > 1)
+	{
+		// The estimate is of the reduced Blueprint, which fits one prompt; the parts and their combination take more
+		Text += FString::Printf(TEXT(" · documented in %d parts, which costs more"), NumParts);
+	}
+	else if (!Estimate.Fits())
+	{
+		Text += TEXT(" · too large to send");
+	}
+	RequestEstimateText->SetText(FText::FromString(Text));
+}
+
+void SUnrealMastermindTab::OnDocumentationTextReceived(const FString& Text, double RequestStartTime)
+{
+	// Pieces can still be queued when the complete response has already been shown
+	if (!bIsGenerating)
+		return;
+
+	if (StreamedDocumentation.IsEmpty())
+	{
+		SetGenerationStatus(true, 0.8f, FString::Printf(TEXT("Receiving documentation (first words after %.1f s)..."),
+		                                                FPlatformTime::Seconds() - RequestStartTime));
+	}
+
+	StreamedDocumentation += Text;
+	DocumentationTextBox->SetText(FText::FromString(StreamedDocumentation));
 }
 
 FReply SUnrealMastermindTab::OnSaveDocumentationClicked() const
@@ -958,7 +880,7 @@ FReply SUnrealMastermindTab::OnSaveDocumentationClicked() const
 	FString DocumentationText = DocumentationTextBox->GetText().ToString();
 
 	// Save documentation to the Blueprint's metadata
-	UBlueprintDocumentation::SaveDocumentation(SelectedBlueprint, DocumentationText);
+	UBlueprintDocumentation::SaveDocumentation(SelectedBlueprint, DocumentationText, GeneratedSourceHash);
 
 	// Show success notification
 	FNotificationInfo SuccessInfo(FText::FromString("Documentation saved successfully!"));
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "IDetailCustomization.h"
 
+struct FBlueprintDocumentationState;
+
 class FBlueprintDetailsCustomization : public IDetailCustomization
 {
 public:
@@ -26,6 +28,9 @@ private:
     bool HasDocumentation() const;
     FString GetDocumentation() const;
 
+    /** Documentation state from the asset registry tags; false if they are missing or the package has unsaved changes */
+    bool GetRegistryState(FBlueprintDocumentationState& OutState) const;
+
     /** Register the details customization */
     static bool bIsRegistered;
     
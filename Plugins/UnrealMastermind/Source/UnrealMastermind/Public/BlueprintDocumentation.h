@@ -4,19 +4,36 @@
 
 #include "CoreMinimal.h"
 #include "Engine/Blueprint.h"
+#include "BlueprintDocumentationSettings.h"
 #include "BlueprintDocumentation.generated.h"
 
+class FJsonObject;
+struct FBlueprintIR;
+
 UCLASS()
 class UNREALMASTERMIND_API UBlueprintDocumentation : public UObject
 {
 	GENERATED_BODY()
 	
 public:
-	// Save documentation to Blueprint metadata
-	static bool SaveDocumentation(UBlueprint* Blueprint, const FString& Documentation);
+	// Save documentation to Blueprint metadata, stamped with the source hash it was generated from
+	static bool SaveDocumentation(UBlueprint* Blueprint, const FString& Documentation,
+	                              const FString& SourceHash = FString());
 	
 	// Retrieve documentation from Blueprint metadata
 	static FString GetDocumentation(UBlueprint* Blueprint);
+
+	// Source hash the documentation was saved with; empty without documentation, or if it was saved unstamped
+	static FString GetSourceHash(const UBlueprint* Blueprint);
+
+	// Documentation and source hash without creating the package's metadata, so it is safe while the package is
+	// being saved; false without documentation
+	static bool FindDocumentation(const UBlueprint* Blueprint, FString& OutDocumentation, FString& OutSourceHash);
+
+	// Hash of everything documentation is generated from: the captured Blueprint, the settings that shape the
+	// prompt, and the provider and model that answer it. Documentation stamped with a different hash is stale.
+	static FString ComputeSourceHash(const FBlueprintIR& Snapshot, const FBlueprintDocumentationSettings& Settings,
+	                                 const FString& CustomPrompt);
 	
 	// Check if a Blueprint has documentation
 	static bool HasDocumentation(UBlueprint* Blueprint);
@@ -27,4 +44,6 @@ public:
 private:
 	// Metadata key used to store documentation
 	static const FName DocumentationMetadataKey;
+
+	static TSharedPtr<FJsonObject> ReadMetadata(const UBlueprint* Blueprint);
 };
\ No newline at end of file
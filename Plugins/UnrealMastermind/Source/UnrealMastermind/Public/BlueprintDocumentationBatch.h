@@ -0,0 +1,225 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintDocumentationJournal.h"
+#include "BlueprintDocumentationSettings.h"
+#include "BlueprintDocumentationShard.h"
+#include "Containers/Queue.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FBlueprintSnapshotTask;
+class UBlueprint;
+struct FBlueprintIR;
+
+// What a bulk documentation run covers and how much of each stage may run at once
+struct UNREALMASTERMIND_API FBlueprintDocumentationBatchOptions
+{
+	// Long package paths to search, e.g. /Game/Characters; all of /Game if empty
+	TArray<FString> PackagePaths;
+
+	// Also document Blueprints whose documentation is up to date, see UBlueprintDocumentation::ComputeSourceHash
+	bool bOverwrite = false;
+
+	// Only log the Blueprints whose documentation is missing or stale, without generating any
+	bool bListStale = false;
+
+	// Generate the documentation but save nothing
+	bool bDryRun = false;
+
+	// Only the Blueprints of this shard, see FBlueprintDocumentationShard
+	int32 ShardIndex = 0;
+	int32 NumShards = 1;
+
+	// Write the documentation to this file for a later merge instead of saving it into the packages
+	FString OutputFile;
+
+	// Record the progress of every Blueprint here, see FBlueprintDocumentationJournal
+	FString JournalFile;
+
+	// Skip the Blueprints the journal of an earlier run has as saved, and add to its output file
+	bool bResume = false;
+
+	// At most this many Blueprints, the largest first; 0 for all of them
+	int32 Limit = 0;
+
+	FString CustomPrompt;
+
+	// Packages loading asynchronously at once
+	int32 MaxLoading = 8;
+
+	// Blueprints being captured on the game thread at once, and the time each may take per tick
+	int32 MaxExtracting = 4;
+	float ExtractBudgetMs = 20.0f;
+
+	// Prompts rendering on worker threads at once
+	int32 MaxRendering = 4;
+
+	// Blueprints with requests in flight at once; a large Blueprint documented in parts counts once
+	int32 MaxRequests = 4;
+
+	// Loaded Blueprints waiting for a request; loading pauses beyond this, which bounds memory
+	int32 MaxQueued = 32;
+
+	// Garbage is collected after this many Blueprints are done with, to unload their packages
+	int32 BlueprintsPerGarbageCollection = 64;
+};
+
+// The stages every Blueprint of a batch goes through, in order
+enum class EBlueprintDocumentationStage : uint8
+{
+	Load,       // Asynchronous package load
+	Extract,    // Snapshot of the Blueprint on the game thread
+	Render,     // Prompt rendered within the token budget on a worker thread
+	Request,    // LLM requests, paced by FLLMRequestScheduler
+	Save,       // Documentation saved into the package, or written to the output file, on the game thread
+	Num
+};
+
+struct UNREALMASTERMIND_API FBlueprintDocumentationBatchStats
+{
+	int32 NumFound = 0;
+	int32 NumDocumented = 0;
+	int32 NumUpToDate = 0;
+	int32 NumFailed = 0;
+
+	// Missing or stale documentation found when only listing it
+	int32 NumStale = 0;
+
+	// Saved by the run that was resumed; not counted in the others
+	int32 NumResumed = 0;
+
+	// Answered from the asset registry tags and the graph database, without loading the package
+	int32 NumNotLoaded = 0;
+
+	// Blueprint info tokens sent, before any split into parts
+	int64 PromptTokens = 0;
+
+	double WallSeconds = 0.0;
+
+	struct FStage
+	{
+		int32 NumJobs = 0;
+
+		// Summed over every job; more than the wall time when jobs overlap
+		double BusySeconds = 0.0;
+		double MaxSeconds = 0.0;
+		int32 MaxInFlight = 0;
+		int32 Limit = 0;
+	};
+	FStage Stages[static_cast<int32>(EBlueprintDocumentationStage::Num)];
+
+	// A report of several lines
+	FString ToString() const;
+};
+
+// Documents many Blueprints as a bounded pipeline driven from the game thread: packages are loaded
+// asynchronously, captured, rendered on worker threads, sent to the provider and saved, with every stage
+// working on different Blueprints at the same time within its own limit. The largest Blueprints are loaded
+// first and the largest prompts sent first, so the slowest jobs don't end up alone at the end of the run.
+// Completions from other threads are queued and picked up by the next Tick.
+class UNREALMASTERMIND_API FBlueprintDocumentationBatch : public TSharedFromThis<FBlueprintDocumentationBatch>
+{
+public:
+	explicit FBlueprintDocumentationBatch(const FBlueprintDocumentationBatchOptions& InOptions);
+
+	// Finds the Blueprints to document in the asset registry; game thread. False if the output can't be written.
+	bool Start();
+
+	// Advances every stage; call on the game thread until IsComplete, while the core ticker, the task
+	// graph and async loading are pumped so loads and requests complete
+	void Tick();
+
+	bool IsComplete() const;
+
+	const FBlueprintDocumentationBatchStats& GetStats() const { return Stats; }
+
+private:
+	struct FJob
+	{
+		FName PackageName;
+		FSoftObjectPath AssetPath;
+
+		// Size on disk at first, then the tokens of the unreduced prompt; larger jobs go first
+		int64 Weight = 0;
+
+		// Only touched on the game thread
+		TStrongObjectPtr<UBlueprint> Blueprint;
+
+		TSharedPtr<FBlueprintSnapshotTask> Capture;
+		TSharedPtr<const FBlueprintIR> Snapshot;
+
+		// What the saved documentation was generated from, and what it would be generated from now
+		FString SavedSourceHash;
+		FString SourceHash;
+		bool bUpToDate = false;
+
+		// The registry tags told whether the Blueprint is documented, and SavedSourceHash came from them
+		bool bTagged = false;
+
+		TArray<UTF8CHAR> BlueprintInfo;
+		int32 PromptTokens = 0;
+		int32 NumParts = 1;
+
+		FString Documentation;
+
+		// Set by the thread that finishes a stage off the game thread, as the game thread sees it a tick later
+		double StageStartTime = 0.0;
+		double StageEndTime = 0.0;
+	};
+
+	void StartLoads();
+	bool SkipLoad(const TSharedRef<FJob>& Job);
+	void OnPackageLoaded(const TSharedRef<FJob>& Job, UPackage* Package);
+	void StartExtracts();
+	void OnExtracted(const TSharedRef<FJob>& Job, TSharedPtr<const FBlueprintIR> Snapshot);
+	void StartRenders();
+	void StartRequests();
+	void SaveCompleted();
+	void CollectGarbageWhenIdle();
+	void Release(FJob& Job);
+	bool OpenFiles(TMap<FName, uint64>& OutResumedHashes);
+
+	bool SavesPackages() const { return !Options.bDryRun && Options.OutputFile.IsEmpty(); }
+
+	static bool IsHeavier(const TSharedRef<FJob>& A, const TSharedRef<FJob>& B);
+
+	void EnterStage(FJob& Job, EBlueprintDocumentationStage Stage);
+	void LeaveStage(FJob& Job, EBlueprintDocumentationStage Stage);
+	void Fail(const FJob& Job, EBlueprintDocumentationStage Stage, const FString& Reason);
+
+	FBlueprintDocumentationBatchOptions Options;
+	FBlueprintDocumentationSettings DocSettings;
+	int32 TokenBudget = 0;
+	bool bSplitLargeBlueprints = true;
+	int32 MaxPartRequests = 1;
+
+	// Waiting to load, the largest last so it is popped first
+	TArray<TSharedRef<FJob>> Pending;
+
+	// Loaded and waiting to be captured, then captured and waiting to be rendered, in order
+	TArray<TSharedRef<FJob>> Loaded;
+	TArray<TSharedRef<FJob>> Extracted;
+
+	// Rendered and waiting for a request; a heap, the largest on top
+	TArray<TSharedRef<FJob>> Rendered;
+
+	// Finished on other threads
+	TQueue<TSharedPtr<FJob>, EQueueMode::Mpsc> RenderedQueue;
+	TQueue<TSharedPtr<FJob>, EQueueMode::Mpsc> CompletedQueue;
+
+	int32 InFlight[static_cast<int32>(EBlueprintDocumentationStage::Num)] = {};
+
+	// Loaded and not yet sent, wherever they are; bounded by MaxQueued
+	int32 NumQueued = 0;
+
+	int32 ReleasedSinceGarbageCollection = 0;
+	bool bGarbageCollectionPending = false;
+
+	FBlueprintDocumentationShard Output;
+	FBlueprintDocumentationJournal Journal;
+
+	FBlueprintDocumentationBatchStats Stats;
+	double StartTime = 0.0;
+};
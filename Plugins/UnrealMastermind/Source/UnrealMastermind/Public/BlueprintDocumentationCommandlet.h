@@ -0,0 +1,44 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BlueprintDocumentationCommandlet.generated.h"
+
+// Documents every Blueprint of a project without the editor UI, e.g. on a build machine:
+//
+//   UnrealEditor-Cmd Project.uproject -run=BlueprintDocumentation [-Paths=/Game/A+/Game/B] [-Overwrite] [-DryRun]
+//       [-ListStale] [-Limit=N] [-Load=8] [-Extract=4] [-Render=4] [-Requests=N] [-Queue=32] [-Prompt="..."]
+//       [-Shard=I -NumShards=N [-Output=File]] [-Resume] [-Journal=File]
+//   UnrealEditor-Cmd Project.uproject -run=BlueprintDocumentation -Merge[=Dir+File...]
+//   UnrealEditor-Cmd Project.uproject -run=BlueprintDocumentation -Coverage [-Paths=...]
+//
+// The provider and its endpoint come from the plugin settings; to try a run against Scripts/mock_llm_server.py add
+//   -ini:EditorPerProjectUserSettings:[/Script/UnrealMastermind.UnrealMastermindSettings]:OpenAIEndpoint=http://127.0.0.1:8765/v1/chat/completions
+// Documentation is only generated where it is missing or stale: saved documentation is stamped with a hash of
+// the Blueprint content and the generator settings, and one with the same hash is left alone unless -Overwrite.
+// -ListStale only logs which Blueprints would be documented. Blueprints saved with the documentation asset registry
+// tags whose snapshot is in the graph database are checked without loading them, see FBlueprintDocumentationTags;
+// -Coverage only counts documented Blueprints from those tags.
+// -Load, -Extract, -Render and -Requests limit how many Blueprints each stage works on at once, see
+// FBlueprintDocumentationBatchOptions; -Requests defaults to Max Concurrent Requests.
+// With -NumShards each agent documents its own share of the Blueprints into Saved/UnrealMastermind/Documentation
+// (or -Output) instead of the packages, and -Merge then saves every shard's results into the packages in one pass,
+// see FBlueprintDocumentationShard.
+// Every run keeps a journal in the same directory (or -Journal); -Resume skips what the journal of a run that was
+// killed has as saved, and the requests it had finished are answered from the response cache.
+// Throughput statistics are logged at the end, and the exit code is 1 if any Blueprint failed.
+UCLASS()
+class UNREALMASTERMIND_API UBlueprintDocumentationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBlueprintDocumentationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 Merge(const FString& Paths);
+};
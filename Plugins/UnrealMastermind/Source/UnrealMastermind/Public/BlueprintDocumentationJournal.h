@@ -0,0 +1,53 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLMJson.h"
+
+// How far a Blueprint of a bulk run got
+enum class EBlueprintDocumentationJournalStage : uint8
+{
+	Generated,  // The provider answered; a retry is answered from the response cache
+	Saved,      // The documentation is on disk, in the package or in the shard's output file
+	Failed
+};
+
+// Append-only record of a bulk run, so a run that was killed can be resumed without redoing what it finished.
+// Every entry is one JSON line with the package, the stage it reached and a hash of the documentation, and
+// is on disk before the run moves on.
+// Only game thread.
+class UNREALMASTERMIND_API FBlueprintDocumentationJournal
+{
+public:
+	FBlueprintDocumentationJournal();
+	~FBlueprintDocumentationJournal();
+
+	// Saved/UnrealMastermind/Documentation/Journal[-<Index>-of-<NumShards>].jsonl
+	static FString GetDefaultPath(int32 ShardIndex, int32 NumShards);
+
+	// Reads the entries of an earlier run when resuming, or starts an empty journal
+	bool Open(const FString& Filename, bool bResume);
+
+	// Whether an earlier run saved the documentation, and its hash, to check it against what is on disk
+	bool GetSavedHash(FName PackageName, uint64& OutHash) const;
+	void GetSavedHashes(TMap<FName, uint64>& OutHashes) const;
+
+	void Record(FName PackageName, EBlueprintDocumentationJournalStage Stage, const FString& Documentation);
+
+	static uint64 HashDocumentation(const FString& Documentation);
+
+private:
+	struct FEntry
+	{
+		EBlueprintDocumentationJournalStage Stage = EBlueprintDocumentationJournalStage::Failed;
+		uint64 ResultHash = 0;
+	};
+
+	bool Read(const FString& Filename);
+
+	FLLMJsonLinesFile File;
+
+	// The last entry of each package
+	TMap<FName, FEntry> Entries;
+};
@@ -0,0 +1,47 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintGraphIR.h"
+#include "Async/Future.h"
+#include "LLMConnector.h"
+
+// Documents a Blueprint that is too large for a single request. Every function and every event is
+// documented by its own request, several at a time, and one last request combines the parts with an
+// outline of the Blueprint (variables, components, comments). Wall time approaches that of the
+// slowest part instead of the sum of all of them, and each prompt stays small.
+class UNREALMASTERMIND_API FBlueprintDocumentationMapReduce
+{
+public:
+	// Called from whichever thread completes each request, as parts finish
+	using FOnPartComplete = TFunction<void(int32 /*NumComplete*/, int32 /*NumParts*/)>;
+
+	// Number of requests (besides the combining one) the Blueprint would be split into
+	static int32 CountParts(const FBlueprintIR& IR);
+
+	// Renders every prompt on the calling thread, then returns; the future completes once the combining
+	// request has. Finished parts start the next ones, so no thread waits on a request.
+	// Only the combining request is streamed to Options.OnTextReceived, as the parts are not shown on their own.
+	static TFuture<FString> Generate(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                                 const FString& CustomPrompt, int32 TokenBudget, int32 MaxConcurrentRequests,
+	                                 const FOnPartComplete& OnPartComplete,
+	                                 const FLLMRequestOptions& Options = FLLMRequestOptions());
+
+private:
+	struct FPart
+	{
+		int32 Graph = INDEX_NONE;
+		int32 EntryNode = INDEX_NONE;    // Only this event of the graph, or the whole graph
+		FString Name;
+	};
+
+	struct FRun;
+
+	static void StartPart(const TSharedRef<FRun>& Run, int32 PartIndex);
+	static void Combine(const TSharedRef<FRun>& Run);
+
+	static TArray<FPart> CollectParts(const FBlueprintIR& IR);
+	static FBlueprintIR MakePartIR(const FBlueprintIR& IR, const FPart& Part);
+	static FBlueprintIR MakeOutlineIR(const FBlueprintIR& IR);
+};
@@ -20,9 +20,11 @@ struct FBlueprintDocumentationSettings
 	// Execution flow settings
 	bool bTraceExecutionFlow = true;      // Show node connections
 	int32 MaxExecutionFlowDepth = 5;      // How deep to follow execution chains
+	bool bIncludePinValues = true;        // Literal values of unconnected input pins
     
 	// Variable usage tracking
 	bool bTrackVariableUsage = true;      // Find where variables are used
+	bool bSummarizeUnusedVariables = false; // List unused variables on one line instead of one entry each
     
 	// Comments
 	bool bIncludeComments = true;         // Include comment nodes
@@ -0,0 +1,44 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLMJson.h"
+#include "UObject/SoftObjectPath.h"
+
+// One Blueprint's documentation, as a shard of a bulk run writes it
+struct UNREALMASTERMIND_API FBlueprintDocumentationRecord
+{
+	FName PackageName;
+	FSoftObjectPath AssetPath;
+	FString Documentation;
+	FString SourceHash;
+};
+
+// A bulk run split across machines: every agent documents the Blueprints of its own shard and writes the
+// results to a file instead of the packages, so agents never check out or save the same asset. The files
+// are then merged into the packages in one pass on one machine. Shards are picked by a hash of the package
+// path, so every agent agrees on them without talking to the others, whatever its platform.
+// The file holds one JSON object per line and every record is on disk before the next is documented.
+class UNREALMASTERMIND_API FBlueprintDocumentationShard
+{
+public:
+	static int32 GetShardIndex(FName PackageName, int32 NumShards);
+
+	// Saved/UnrealMastermind/Documentation/Shard-<Index>-of-<NumShards>.jsonl
+	static FString GetDefaultPath(int32 ShardIndex, int32 NumShards);
+
+	// Starts an empty file, or adds to the records already in it
+	bool Open(const FString& Filename, bool bAppend = false);
+	void Write(const FBlueprintDocumentationRecord& Record);
+
+	// Records of every complete line; a line cut off by a crash is skipped
+	static bool Read(const FString& Filename, TArray<FBlueprintDocumentationRecord>& OutRecords);
+
+	// Saves the documentation of every record into its package, each package once, the last record winning.
+	// Files may be given by name or as directories of .jsonl files.
+	static bool Merge(const TArray<FString>& Paths, int32& OutNumSaved, int32& OutNumFailed);
+
+private:
+	FLLMJsonLinesFile File;
+};
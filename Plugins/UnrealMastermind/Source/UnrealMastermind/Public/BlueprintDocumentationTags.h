@@ -0,0 +1,67 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FAssetRegistryTagsContext;
+
+// Documentation of a Blueprint as the asset registry has it
+struct UNREALMASTERMIND_API FBlueprintDocumentationState
+{
+	bool bDocumented = false;
+
+	// See UBlueprintDocumentation::ComputeSourceHash; empty if the documentation was saved unstamped
+	FString SourceHash;
+
+	// In characters
+	int32 Length = 0;
+
+	// The start of the documentation on one line
+	FString Preview;
+};
+
+struct UNREALMASTERMIND_API FBlueprintDocumentationCoverage
+{
+	int32 NumBlueprints = 0;
+	int32 NumDocumented = 0;
+
+	// Documented with a source hash, so staleness can be told from the hash alone
+	int32 NumStamped = 0;
+
+	// Last saved without the tags; only loading them tells
+	int32 NumUnknown = 0;
+
+	FString ToString() const;
+};
+
+// Puts the documentation state of every Blueprint into its asset registry tags when it is saved, so whether a
+// Blueprint is documented, what from, how much and how it starts can be answered from the registry without
+// loading the package: coverage of a whole project, Content Browser columns, filters and tooltips.
+class UNREALMASTERMIND_API FBlueprintDocumentationTags
+{
+public:
+	static const FName DocumentedTag;
+	static const FName SourceHashTag;
+	static const FName LengthTag;
+	static const FName PreviewTag;
+
+	// Adds the tags of every Blueprint from now on; called by the module
+	static void Register();
+	static void Unregister();
+
+	// False if the Blueprint was last saved without these tags; then only its package knows
+	static bool GetState(const FAssetData& Asset, FBlueprintDocumentationState& OutState);
+
+	// Registry data of a Blueprint, without loading it
+	static bool FindAsset(const FSoftObjectPath& AssetPath, FAssetData& OutAsset);
+
+	// Blueprints under the given long package paths, or all of /Game
+	static FBlueprintDocumentationCoverage GetCoverage(const TArray<FString>& PackagePaths);
+
+private:
+	static void AddTags(FAssetRegistryTagsContext Context);
+
+	static FDelegateHandle TagsHandle;
+};
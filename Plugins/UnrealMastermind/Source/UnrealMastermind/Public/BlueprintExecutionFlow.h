@@ -0,0 +1,100 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintGraphIR.h"
+
+// Iterative, cycle-safe walk over the exec pins of an IR graph.
+// Every exec output is followed (Branch, Sequence, Switch, ...), each reachable node is reported once,
+// and reaching an already reported node again is reported as a back-reference instead of re-walking it.
+// The visited set lives as long as the walker, so tails shared between entries of a graph are only described once.
+//
+// The visitor must provide:
+//   void Node(int32 NodeIndex, int32 Depth);
+//   void BackReference(int32 NodeIndex, int32 Depth);
+//   void BranchLabel(int32 ExecPinIndex, int32 Depth);  // Before each path of a node with several exec outputs
+//   void DepthLimit(int32 Depth);
+class UNREALMASTERMIND_API FBlueprintExecutionFlowWalker
+{
+public:
+	explicit FBlueprintExecutionFlowWalker(const FBlueprintIRGraph& InGraph);
+
+	// Whether a node can be reached through more than one exec link, i.e. may show up as a back-reference
+	bool IsReconvergent(int32 NodeIndex) const { return IncomingExecLinks[NodeIndex] > 1; }
+
+	bool WasVisited(int32 NodeIndex) const { return Visited[NodeIndex]; }
+
+	// Exec output pins of a node, in pin order
+	void GetExecOutputs(int32 NodeIndex, TArray<int32, TInlineAllocator<4>>& OutPins) const;
+
+	// Follow everything reachable from an exec output pin. Nodes deeper than MaxDepth are cut off.
+	template <typename VisitorType>
+	void Walk(int32 ExecPin, int32 StartDepth, int32 MaxDepth, VisitorType& Visitor);
+
+private:
+	struct FWorkItem
+	{
+		int32 Pin;
+		int32 Depth;
+		bool bIsLabel;
+	};
+
+	const FBlueprintIRGraph& Graph;
+	TBitArray<> Visited;
+	TArray<int32> IncomingExecLinks;
+	TArray<FWorkItem> Stack;
+};
+
+template <typename VisitorType>
+void FBlueprintExecutionFlowWalker::Walk(int32 ExecPin, int32 StartDepth, int32 MaxDepth, VisitorType& Visitor)
+{
+	Stack.Reset();
+	Stack.Add({ExecPin, StartDepth, false});
+
+	TArray<int32, TInlineAllocator<4>> ExecOutputs;
+	while (Stack.Num() > 0)
+	{
+		const FWorkItem Item = Stack.Pop(EAllowShrinking::No);
+		if (Item.bIsLabel)
+		{
+			Visitor.BranchLabel(Item.Pin, Item.Depth);
+			continue;
+		}
+
+		const FBlueprintIRPin& Pin = Graph.Pins[Item.Pin];
+		for (int32 EdgeIndex = Pin.FirstEdge; EdgeIndex < Pin.FirstEdge + Pin.NumEdges; ++EdgeIndex)
+		{
+			const int32 NodeIndex = Graph.Pins[Graph.Edges[EdgeIndex].ToPin].Node;
+			if (Visited[NodeIndex])
+			{
+				Visitor.BackReference(NodeIndex, Item.Depth);
+				continue;
+			}
+
+			if (Item.Depth > MaxDepth)
+			{
+				Visitor.DepthLimit(Item.Depth);
+				continue;
+			}
+
+			Visited[NodeIndex] = true;
+			Visitor.Node(NodeIndex, Item.Depth);
+
+			// Push in reverse so paths come out in pin order
+			GetExecOutputs(NodeIndex, ExecOutputs);
+			const bool bLabelPaths = ExecOutputs.Num() > 1;
+			for (int32 Index = ExecOutputs.Num() - 1; Index >= 0; --Index)
+			{
+				if (Graph.Pins[ExecOutputs[Index]].NumEdges == 0)
+					continue;
+
+				Stack.Add({ExecOutputs[Index], Item.Depth + 1, false});
+				if (bLabelPaths)
+				{
+					Stack.Add({ExecOutputs[Index], Item.Depth + 1, true});
+				}
+			}
+		}
+	}
+}
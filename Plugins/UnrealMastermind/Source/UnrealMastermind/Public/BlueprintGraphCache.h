@@ -0,0 +1,44 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintGraphIR.h"
+#include "UObject/ObjectKey.h"
+
+class UEdGraph;
+
+// Stable content hash of a graph, built from node GUIDs, pins, pin links, default values and comments.
+// Node titles are not resolved (that is what capturing a graph costs); the member references, event names,
+// subgraphs and pin default objects they are made from are hashed instead, so renaming a called function or
+// variable, or picking another class to spawn, changes it.
+struct UNREALMASTERMIND_API FBlueprintGraphHash
+{
+	static uint64 Compute(const UEdGraph* Graph);
+};
+
+// Captured graphs from previous extractions, keyed by graph object and content hash.
+// A graph whose hash is unchanged is copied from the cache instead of being walked again.
+class UNREALMASTERMIND_API FBlueprintIRGraphCache
+{
+public:
+	static FBlueprintIRGraphCache& Get();
+
+	TSharedPtr<const FBlueprintIRGraph> Find(const UEdGraph* Graph, uint64 Hash, EBlueprintIRGraphKind Kind);
+	void Add(const UEdGraph* Graph, const FBlueprintIRGraph& GraphIR);
+
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		uint64 Hash = 0;
+		TSharedRef<const FBlueprintIRGraph> Graph;
+	};
+
+	// Entries of deleted graphs are never looked up again; start over rather than let them pile up
+	static constexpr int32 MaxEntries = 4096;
+
+	FCriticalSection Lock;
+	TMap<FObjectKey, FEntry> Entries;
+};
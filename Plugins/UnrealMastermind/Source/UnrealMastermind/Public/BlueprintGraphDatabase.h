@@ -0,0 +1,85 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintGraphIR.h"
+#include "Containers/Ticker.h"
+#include "IO/IoHash.h"
+#include "UObject/ObjectSaveContext.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class FBlueprintSnapshotTask;
+
+// Project-wide store of captured Blueprints in Saved/UnrealMastermind, so coverage checks and
+// cross-Blueprint analysis don't have to load every UBlueprint.
+// Records are keyed by package name and the saved-package hash from the asset registry; a record is
+// only handed out while both still match, so nothing is ever read from a package that changed since.
+// The file is memory-mapped and records are decoded on demand. Saving a Blueprint package captures it
+// again in the background and the file is rewritten shortly after.
+class UNREALMASTERMIND_API FBlueprintGraphDatabase
+{
+public:
+	static FBlueprintGraphDatabase& Get();
+
+	// Maps the database and starts following package saves; called by the module
+	void Initialize();
+	void Shutdown();
+
+	// Snapshot of the package as currently saved, captured with the same component settings.
+	// Never loads the package; returns null if there is no fresh record.
+	TSharedPtr<const FBlueprintIR> FindFresh(FName PackageName, const FBlueprintDocumentationSettings& Settings);
+	bool IsFresh(FName PackageName, const FBlueprintDocumentationSettings& Settings) const;
+
+	// Store a snapshot taken from the saved state of the package (the package must not be dirty)
+	void Store(FName PackageName, const FBlueprintIR& Snapshot, const FBlueprintDocumentationSettings& Settings);
+
+	// Packages that have a record, fresh or not
+	TArray<FName> GetPackageNames() const;
+
+	// Hash of a snapshot as it is stored, the same for every capture of the same Blueprint content
+	static uint64 HashSnapshot(const FBlueprintIR& Snapshot);
+
+	// Write pending records to disk
+	void Flush();
+
+private:
+	struct FRecord
+	{
+		FIoHash SavedHash;
+		uint32 SettingsHash = 0;
+
+		// Location in the mapped file, or the encoded snapshot if it was stored after the file was mapped
+		int64 Offset = INDEX_NONE;
+		int64 Size = 0;
+		TSharedPtr<const TArray<uint8>> Pending;
+	};
+
+	static FString GetDatabasePath();
+	static uint32 HashCaptureSettings(const FBlueprintDocumentationSettings& Settings);
+	static bool GetSavedHash(FName PackageName, FIoHash& OutHash);
+
+	void MapFile();
+	void UnmapFile();
+	TConstArrayView<uint8> GetRecordData(const FRecord& Record) const;
+
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+	bool Tick(float DeltaTime);
+	void CaptureNextSavedPackage();
+
+	mutable FCriticalSection Lock;
+	TMap<FName, FRecord> Records;
+	bool bDirty = false;
+	double FlushTime = 0.0;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	// Saved Blueprint packages waiting to be captured, one at a time
+	TArray<FName> SavedPackages;
+	TSharedPtr<FBlueprintSnapshotTask> ActiveCapture;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PackageSavedHandle;
+};
@@ -0,0 +1,206 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintDocumentationSettings.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UActorComponent;
+class USCS_Node;
+struct FComponentPropertyPlan;
+
+// Intermediate representation of a Blueprint, built once and rendered into any number of formats.
+// Everything is stored in flat arrays and cross-referenced by index, and holds no UObject pointers.
+
+enum class EBlueprintIRGraphKind : uint8
+{
+	EventGraph,
+	Function,
+	Macro,
+	Other       // Collapsed graphs, delegate signatures, ...
+};
+
+enum class EBlueprintIRNodeKind : uint8
+{
+	Generic,
+	Event,
+	FunctionEntry,
+	MacroEntry,
+	VariableGet,
+	VariableSet
+};
+
+struct FBlueprintIRPin
+{
+	FName Name;
+	FName Category;
+	FString DefaultValue;
+	int32 Node = INDEX_NONE;
+
+	// Range in FBlueprintIRGraph::Edges of the links leaving this pin
+	int32 FirstEdge = 0;
+	int32 NumEdges = 0;
+
+	bool bIsInput = false;
+	bool bIsExec = false;
+};
+
+struct FBlueprintIREdge
+{
+	int32 FromPin = INDEX_NONE;
+	int32 ToPin = INDEX_NONE;
+};
+
+struct FBlueprintIRNode
+{
+	FGuid Guid;
+	FString Title;        // ENodeTitleType::ListView
+	FString FullTitle;    // ENodeTitleType::FullTitle
+	FName VariableName;   // Only set for variable get/set nodes
+	EBlueprintIRNodeKind Kind = EBlueprintIRNodeKind::Generic;
+
+	// Range in FBlueprintIRGraph::Pins
+	int32 FirstPin = 0;
+	int32 NumPins = 0;
+};
+
+struct FBlueprintIRGraph
+{
+	FString Name;
+	EBlueprintIRGraphKind Kind = EBlueprintIRGraphKind::Other;
+
+	// FBlueprintGraphHash of the graph this was captured from
+	uint64 ContentHash = 0;
+
+	TArray<FBlueprintIRNode> Nodes;
+	TArray<FBlueprintIRPin> Pins;
+
+	// Each link appears once per direction, mirroring UEdGraphPin::LinkedTo
+	TArray<FBlueprintIREdge> Edges;
+	TArray<FString> Comments;
+
+	// Nodes that start an execution chain (events, function and macro entries)
+	TArray<int32> EntryNodes;
+
+	// Pin of a node by local index, e.g. GetPin(Node, 0) is its first pin
+	const FBlueprintIRPin& GetPin(const FBlueprintIRNode& Node, int32 LocalIndex) const
+	{
+		return Pins[Node.FirstPin + LocalIndex];
+	}
+
+	// Node the first link of a pin leads to, or INDEX_NONE if unconnected
+	int32 GetFirstLinkedNode(const FBlueprintIRPin& Pin) const
+	{
+		return Pin.NumEdges > 0 ? Pins[Edges[Pin.FirstEdge].ToPin].Node : INDEX_NONE;
+	}
+};
+
+struct FBlueprintIRVariableUsage
+{
+	int32 Graph = INDEX_NONE;
+	int32 Node = INDEX_NONE;
+	bool bIsWrite = false;
+	FString ExecContext;
+};
+
+struct FBlueprintIRVariable
+{
+	FName Name;
+	FName Category;
+
+	// Range in FBlueprintIR::VariableUsages
+	int32 FirstUsage = 0;
+	int32 NumUsages = 0;
+};
+
+struct FBlueprintIRProperty
+{
+	FString Name;
+	FString Value;
+};
+
+struct FBlueprintIRComponent
+{
+	FString Name;
+	FString ClassName;
+
+	// Range in FBlueprintIR::Properties captured for the Basic detail level
+	int32 FirstImportantProperty = 0;
+	int32 NumImportantProperties = 0;
+
+	// Range in FBlueprintIR::Properties captured for the Full detail level
+	int32 FirstProperty = 0;
+	int32 NumProperties = 0;
+};
+
+struct FBlueprintIR
+{
+	FString BlueprintName;
+	FString ParentClassName;
+
+	TArray<FBlueprintIRGraph> Graphs;
+	TArray<FBlueprintIRVariable> Variables;
+	TArray<FBlueprintIRVariableUsage> VariableUsages;
+	TArray<FBlueprintIRComponent> Components;
+	TArray<FBlueprintIRProperty> Properties;
+
+	// Component detail that was captured; renderers can only go as deep as this
+	FBlueprintDocumentationSettings::EComponentDetailLevel CapturedDetailLevel =
+		FBlueprintDocumentationSettings::EComponentDetailLevel::Minimal;
+
+	bool IsValid() const { return !BlueprintName.IsEmpty(); }
+};
+
+// Walks a Blueprint once and captures it into an FBlueprintIR.
+// The capture is split into steps (one graph, the variables, or one component each) so it can be
+// spread over several frames on the game thread; see FBlueprintSnapshotTask.
+class UNREALMASTERMIND_API FBlueprintIRBuilder
+{
+public:
+	// Settings only control how much component detail is captured; everything else is always captured
+	static FBlueprintIR Build(const UBlueprint* Blueprint, const FBlueprintDocumentationSettings& Settings);
+
+	FBlueprintIRBuilder(const UBlueprint* InBlueprint, const FBlueprintDocumentationSettings& InSettings);
+
+	// Runs steps until the capture is complete or BudgetSeconds have passed; returns true when complete.
+	// At least one step always runs, so the capture makes progress under any budget.
+	bool Step(double BudgetSeconds);
+
+	bool IsComplete() const { return NextStep >= NumSteps; }
+	float GetProgress() const { return NumSteps > 0 ? static_cast<float>(NextStep) / NumSteps : 1.0f; }
+
+	// Hands over the captured IR; only valid once complete
+	FBlueprintIR Finish();
+
+private:
+	void RunStep(int32 StepIndex);
+
+	static void AddGraph(FBlueprintIR& IR, const UEdGraph* Graph, EBlueprintIRGraphKind Kind);
+	static void AddVariableUsages(const FBlueprintIRGraph& GraphIR, int32 GraphIndex,
+	                              TMap<FName, TArray<FBlueprintIRVariableUsage>>& OutUsages);
+	static void AddVariables(FBlueprintIR& IR, const UBlueprint* Blueprint,
+	                         TMap<FName, TArray<FBlueprintIRVariableUsage>>& Usages);
+	static void AddComponent(FBlueprintIR& IR, const USCS_Node* Node, const FBlueprintDocumentationSettings& Settings);
+	static void AddImportantComponentProperties(FBlueprintIR& IR, const UActorComponent* Component,
+	                                            const FComponentPropertyPlan& Plan);
+	static void AddAllComponentProperties(FBlueprintIR& IR, const UActorComponent* Component,
+	                                      const FComponentPropertyPlan& Plan);
+
+	const UBlueprint* Blueprint;
+	FBlueprintDocumentationSettings Settings;
+	FBlueprintIR IR;
+
+	// Graphs in capture order, each with the kind it is captured as
+	TArray<TPair<const UEdGraph*, EBlueprintIRGraphKind>> PendingGraphs;
+	TArray<const USCS_Node*> PendingComponents;
+
+	// Usage sites of each variable, collected from every graph as it is captured
+	TMap<FName, TArray<FBlueprintIRVariableUsage>> VariableUsages;
+
+	// Steps are: every graph, then the variables, then every component
+	int32 NumSteps = 0;
+	int32 NextStep = 0;
+};
@@ -0,0 +1,91 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintGraphIR.h"
+#include "PromptWriter.h"
+
+class FBlueprintExecutionFlowWalker;
+
+// Turns an FBlueprintIR into text. Renderers never touch UObjects, so the same IR can be
+// rendered in several formats or with different settings without walking the Blueprint again.
+class IBlueprintIRRenderer
+{
+public:
+	virtual ~IBlueprintIRRenderer() = default;
+
+	virtual void Render(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                    FPromptWriter& Out) const = 0;
+};
+
+// The detailed, human-readable format used for documentation prompts
+class UNREALMASTERMIND_API FBlueprintIRTextRenderer : public IBlueprintIRRenderer
+{
+public:
+	virtual void Render(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                    FPromptWriter& Out) const override;
+
+private:
+	static void RenderVariableInfo(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                               FPromptWriter& Out);
+	static void RenderEventGraphInfo(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                                 FPromptWriter& Out);
+	static void RenderFunctionGraphInfo(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                                    FPromptWriter& Out);
+	static void RenderComponentInfo(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                                FPromptWriter& Out);
+	static void RenderComments(const FBlueprintIR& IR, FPromptWriter& Out);
+	static void TraceExecutionFlow(FBlueprintExecutionFlowWalker& Walker, const FBlueprintIRGraph& Graph,
+	                               int32 ExecPin, FPromptWriter& Out, int32 Depth,
+	                               const FBlueprintDocumentationSettings& Settings);
+	static void AppendPinValue(const FBlueprintIRGraph& Graph, const FBlueprintIRPin& Pin, FPromptWriter& Out);
+};
+
+// A terse line-oriented format that trades readability for prompt size
+class UNREALMASTERMIND_API FBlueprintIRCompactRenderer : public IBlueprintIRRenderer
+{
+public:
+	virtual void Render(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                    FPromptWriter& Out) const override;
+};
+
+// Machine-readable export of the full IR
+class UNREALMASTERMIND_API FBlueprintIRJsonRenderer : public IBlueprintIRRenderer
+{
+public:
+	virtual void Render(const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                    FPromptWriter& Out) const override;
+};
+
+// Looks up renderers by format name. "Text", "Compact" and "Json" are always available.
+class UNREALMASTERMIND_API FBlueprintIRRendererRegistry
+{
+public:
+	static const FName Text;
+	static const FName Compact;
+	static const FName Json;
+
+	static void Register(FName Format, const TSharedRef<const IBlueprintIRRenderer>& Renderer);
+	static void Unregister(FName Format);
+	static TSharedPtr<const IBlueprintIRRenderer> Find(FName Format);
+
+	// Render through the calling thread's reusable writer; returns an empty string for unknown formats
+	static FString Render(FName Format, const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings);
+
+	// Render into a caller-provided writer; does nothing for unknown formats
+	static void Render(FName Format, const FBlueprintIR& IR, const FBlueprintDocumentationSettings& Settings,
+	                   FPromptWriter& Writer);
+};
+
+// Describes what changed between two captures of the same Blueprint
+class UNREALMASTERMIND_API FBlueprintIRDiff
+{
+public:
+	static void Render(const FBlueprintIR& OldIR, const FBlueprintIR& NewIR, FString& OutText);
+
+private:
+	static void DiffGraph(const FBlueprintIRGraph& OldGraph, const FBlueprintIRGraph& NewGraph, FString& OutText);
+	static bool NodesDiffer(const FBlueprintIRGraph& OldGraph, const FBlueprintIRNode& OldNode,
+	                        const FBlueprintIRGraph& NewGraph, const FBlueprintIRNode& NewNode);
+};
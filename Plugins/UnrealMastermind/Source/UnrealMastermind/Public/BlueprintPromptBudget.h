@@ -0,0 +1,42 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintGraphIR.h"
+#include "PromptWriter.h"
+
+// What had to be given up to fit a Blueprint into its token budget
+struct UNREALMASTERMIND_API FBlueprintPromptBudgetReport
+{
+	int32 TokenBudget = 0;
+	int32 InitialTokens = 0;
+	int32 FinalTokens = 0;
+
+	// Detail that was dropped, in the order it was dropped
+	TArray<FString> Reductions;
+
+	// The output was cut off because even the least detailed rendering did not fit
+	bool bTruncated = false;
+
+	bool WasReduced() const { return Reductions.Num() > 0 || bTruncated; }
+	FString ToString() const;
+};
+
+// Renders a Blueprint within an input-token budget, lowering detail one section at a time until it fits:
+// literal pin values first, then execution flow depth, then component properties, then unused variables.
+// If nothing else helps the output is truncated, so the result never exceeds the budget.
+class UNREALMASTERMIND_API FBlueprintPromptBudget
+{
+public:
+	// Tokens in text, counted by the configured FLLMTokenizer, or estimated at about 4 bytes per token without one
+	static int32 EstimateTokens(FUtf8StringView Text);
+	static int32 EstimateTokens(FStringView Text);
+
+	// Whether EstimateTokens counts exactly rather than estimates
+	static bool HasTokenizer();
+
+	static FBlueprintPromptBudgetReport Render(FName Format, const FBlueprintIR& IR,
+	                                           const FBlueprintDocumentationSettings& Settings, int32 TokenBudget,
+	                                           FPromptWriter& Out);
+};
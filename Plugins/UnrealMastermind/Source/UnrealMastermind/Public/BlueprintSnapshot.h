@@ -0,0 +1,48 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintGraphIR.h"
+#include "Containers/Ticker.h"
+
+class UBlueprint;
+
+// Captures a Blueprint into an immutable FBlueprintIR on the game thread, a few steps per frame.
+// UEdGraph and FProperty data are only safe to read on the game thread, so this is the one stage
+// that touches UObjects; everything downstream (rendering, prompts, requests) works on the snapshot
+// and can run on any thread. If the Blueprint is edited mid-capture, the capture starts over.
+class UNREALMASTERMIND_API FBlueprintSnapshotTask : public TSharedFromThis<FBlueprintSnapshotTask>
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnProgress, float /*Progress*/);
+	// Snapshot is null if the Blueprint was deleted or the task was cancelled
+	DECLARE_DELEGATE_OneParam(FOnComplete, TSharedPtr<const FBlueprintIR> /*Snapshot*/);
+
+	FBlueprintSnapshotTask(UBlueprint* InBlueprint, const FBlueprintDocumentationSettings& InSettings,
+	                       float InFrameBudgetMs);
+	~FBlueprintSnapshotTask();
+
+	// Must be called on the game thread; delegates are also invoked on the game thread
+	void Start(FOnComplete InOnComplete, FOnProgress InOnProgress = FOnProgress());
+	void Cancel();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+private:
+	bool Tick(float DeltaTime);
+	void OnObjectModified(UObject* Object);
+	void Complete(TSharedPtr<const FBlueprintIR> Snapshot);
+
+	TWeakObjectPtr<UBlueprint> Blueprint;
+	FBlueprintDocumentationSettings Settings;
+	double FrameBudgetSeconds;
+
+	TUniquePtr<FBlueprintIRBuilder> Builder;
+	bool bRestartRequested = false;
+
+	FOnComplete OnComplete;
+	FOnProgress OnProgress;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle ObjectModifiedHandle;
+};
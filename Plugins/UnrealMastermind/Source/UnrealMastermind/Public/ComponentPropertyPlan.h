@@ -0,0 +1,71 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+class UActorComponent;
+
+// Set of name prefixes compiled into a trie, so a name is checked against all of them in one pass
+class UNREALMASTERMIND_API FPropertyPrefixTrie
+{
+public:
+	FPropertyPrefixTrie();
+	explicit FPropertyPrefixTrie(const TArray<FString>& Prefixes);
+
+	// Whether the name starts with any of the prefixes, ignoring case like FString::StartsWith
+	bool MatchesAnyPrefix(FStringView Name) const;
+
+private:
+	struct FNode
+	{
+		TArray<TPair<TCHAR, int32>, TInlineAllocator<4>> Children;
+		bool bIsTerminal = false;
+	};
+
+	int32 FindChild(int32 NodeIndex, TCHAR Char) const;
+
+	TArray<FNode> Nodes;
+};
+
+// Properties of a component class worth exporting, resolved once per class
+struct FComponentPropertyPlan
+{
+	// The key transform properties shown at the Basic detail level
+	TArray<const FProperty*> ImportantProperties;
+
+	// Every exportable property for the Full detail level, with ignored prefixes, deprecated and transient properties removed
+	TArray<const FProperty*> Properties;
+};
+
+// Caches one FComponentPropertyPlan per component class.
+// The cache is flushed whenever the ignored prefix list changes or classes are reinstanced.
+class UNREALMASTERMIND_API FComponentPropertyPlanCache
+{
+public:
+	static FComponentPropertyPlanCache& Get();
+
+	// Starts following class reinstancing; called by the module
+	void Initialize();
+	void Shutdown();
+
+	// The plan stays valid until the next call with different prefixes or the next Reset
+	TSharedRef<const FComponentPropertyPlan> GetPlan(const UClass* ComponentClass, const TArray<FString>& IgnoredPrefixes);
+
+	void Reset();
+
+private:
+	FComponentPropertyPlanCache() = default;
+
+	TSharedRef<const FComponentPropertyPlan> BuildPlan(const UClass* ComponentClass) const;
+	void OnObjectsReinstanced(const FCoreUObjectDelegates::FReplacementObjectMap& ReplacementMap);
+
+	FCriticalSection Lock;
+	TArray<FString> CachedPrefixes;
+	FPropertyPrefixTrie PrefixTrie;
+	TMap<FObjectKey, TSharedRef<const FComponentPropertyPlan>> Plans;
+
+	FDelegateHandle ReinstancedHandle;
+};
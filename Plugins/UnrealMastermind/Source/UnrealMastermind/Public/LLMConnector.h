@@ -4,36 +4,150 @@
 
 #include "CoreMinimal.h"
 #include "Http.h"
+#include "Async/Future.h"
+#include "LLMPrompt.h"
+#include "LLMProvider.h"
+#include "LLMRequestScheduler.h"
+#include "LLMResponseCache.h"
+#include "LLMResponseStream.h"
 #include "LLMConnector.generated.h"
 
+class FPromptWriter;
+
+// How a request is made; the defaults suit a request someone in the editor is waiting for
+struct FLLMRequestOptions
+{
+	// Receives the documentation as it is generated when responses are streamed; see FLLMResponseStream
+	FLLMResponseStream::FOnTextReceived OnTextReceived;
+
+	ELLMCachePolicy CachePolicy = ELLMCachePolicy::Use;
+	ELLMRequestPriority Priority = ELLMRequestPriority::Interactive;
+};
+
+// What a request will take, worked out before it is sent
+struct UNREALMASTERMIND_API FLLMRequestEstimate
+{
+	// System prompt and prompt together
+	int32 InputTokens = 0;
+	int32 MaxInputTokens = 0;
+
+	// Counted by the tokenizer rather than estimated from the length
+	bool bExactTokenCount = false;
+
+	// Input tokens likely read from the provider's prompt cache, going by recent requests
+	int32 CachedInputTokens = 0;
+
+	// The average of recent responses, or Max Tokens until the provider has answered
+	int32 OutputTokens = 0;
+	bool bOutputTokensMeasured = false;
+
+	// In dollars, negative without prices in the settings
+	double Cost = -1.0;
+
+	// The average of recent requests to the provider, negative until one has been timed
+	double Seconds = -1.0;
+
+	bool Fits() const { return InputTokens <= MaxInputTokens; }
+	FString ToString() const;
+};
+
+// Sends documentation requests to the selected provider, see FLLMProviderRegistry. Requests never block:
+// each call returns a future that the HTTP completion fulfills (on whichever thread completes the request),
+// and any number of requests can be in flight at once; FLLMRequestScheduler paces them to the provider's
+// rate limits. Results that start with "Error:" describe a failure.
 UCLASS()
 class UNREALMASTERMIND_API ULLMConnector : public UObject
 {
 	GENERATED_BODY()
 	
 public:
-	ULLMConnector();
-	
-	// Main function to generate documentation
-	FString GenerateDocumentation(const FString& BlueprintInfo, const FString& CustomPrompt);
+	// Main function to generate documentation. The Blueprint info is UTF-8, as written by FPromptWriter,
+	// and is copied into the prompt before this returns.
+	static TFuture<FString> GenerateDocumentation(FUtf8StringView BlueprintInfo, const FString& CustomPrompt,
+	                                              const FLLMRequestOptions& Options = FLLMRequestOptions());
+
+	// Document one part (a function or an event) of a Blueprint that is documented in several requests
+	static TFuture<FString> GenerateDocumentationPart(const FString& BlueprintName, const FString& PartName,
+	                                                  FUtf8StringView PartInfo, const FString& CustomPrompt,
+	                                                  const FLLMRequestOptions& Options = FLLMRequestOptions());
+
+	// Combine the documentation of every part into the documentation of the whole Blueprint
+	static TFuture<FString> CombineDocumentationParts(FUtf8StringView BlueprintOutline,
+	                                                  const TArray<FString>& PartDocumentation,
+	                                                  const FString& CustomPrompt,
+	                                                  const FLLMRequestOptions& Options = FLLMRequestOptions());
+
+	// Tokens left for the Blueprint info once the system prompt and instructions are counted
+	static int32 GetBlueprintInfoTokenBudget(const FString& CustomPrompt);
+
+	// Tokens, cost and time GenerateDocumentation would take with the selected provider, without sending anything
+	static FLLMRequestEstimate EstimateDocumentation(FUtf8StringView BlueprintInfo, const FString& CustomPrompt);
 	
 private:
-	// Provider-specific implementations
-	FString GenerateWithOpenAI(const FString& Prompt);
-	FString GenerateWithAnthropic(const FString& Prompt);
-	FString GenerateWithOtherProvider(const FString& Prompt);
-	
+	struct FHedgedRequest;
+
+	// A result and the provider that gave it, so it is cached under the model that wrote it; Model is empty
+	// for the provider's default
+	struct FProviderResult
+	{
+		FString Result;
+		ELLMProvider Provider = {};
+		FString Model;
+	};
+
+	// Answer a prompt from the response cache, or send it to the selected provider and cache the response
+	static TFuture<FString> SendPrompt(const FLLMPrompt& Prompt, const FLLMRequestOptions& Options);
+
+	// Send a prompt to the selected provider, hedged with the secondary one if enabled
+	static TFuture<FProviderResult> SendPromptToProvider(const FLLMPrompt& Prompt, const FLLMRequestOptions& Options);
+	static TFuture<FProviderResult> SendToSelectedProvider(const FLLMPrompt& Prompt, const FLLMRequestOptions& Options);
+	static FString MakeCacheKey(const FLLMPrompt& Prompt, ELLMProvider ProviderId, const FString& Model);
+
+	// Build the request for one provider and queue it; Model is empty for the provider's default.
+	// OnRequestCreated sees the request before it is queued.
+	static TFuture<FString> SendToProvider(
+		ELLMProvider ProviderId, const FString& Model, const FLLMPrompt& Prompt, const FLLMRequestOptions& Options,
+		TFunction<void(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>&)> OnRequestCreated = nullptr,
+		FLLMRequestScheduler::FAttemptCallbacks Callbacks = FLLMRequestScheduler::FAttemptCallbacks());
+
+	// Hedged requests: the secondary provider is asked too once the primary is slower to answer than
+	// usual, or as soon as the primary fails, and the first good answer wins. An unconfigured secondary
+	// is never asked, so the primary's own error is what a failure reports
+	static TFuture<FProviderResult> SendHedged(const FLLMPrompt& Prompt, const FLLMRequestOptions& Options);
+	static void StartHedgeLeg(const TSharedRef<FHedgedRequest>& Request, int32 Leg);
+	static void ArmHedgeTimer(const TSharedRef<FHedgedRequest>& Request);
+	static void OnHedgeFirstByte(const TSharedRef<FHedgedRequest>& Request, double Seconds);
+	static bool ClaimHedgeWin(const TSharedRef<FHedgedRequest>& Request, int32 Leg);
+	static void OnHedgeLegComplete(const TSharedRef<FHedgedRequest>& Request, int32 Leg, FString Result);
+	static void CancelHedgeLeg(const TSharedRef<FHedgedRequest>& Request, int32 Leg);
+
 	// Helper methods
-	FString CreatePrompt(const FString& BlueprintInfo, const FString& CustomPrompt);
-	
-	// HTTP Request handlers
-	void OnResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-	void OnAnthropicResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-	
-	// Default timeout in seconds
-	float RequestTimeout;
-	
-	// Result container
-	FString Result;
-	bool bRequestComplete;
+	static FLLMPrompt CreatePrompt(FUtf8StringView BlueprintInfo, const FString& CustomPrompt);
+	static void AppendCustomPrompt(FPromptWriter& Prompt, const FString& CustomPrompt);
+
+	// The project glossary ends the part of a prompt that is the same in every request; returns its length
+	static int32 AppendGlossary(FPromptWriter& Prompt);
+
+	// Tokens of the system prompt and the prompt, as the provider counts them against its context window
+	static int32 CountInputTokens(const FLLMPrompt& Prompt);
+
+	// Timeouts from the settings, for a streamed or a complete response
+	static FLLMRequestScheduler::FPhaseTimeouts GetPhaseTimeouts(bool bStream);
+
+	// The documentation, or the error; usage and truncation are logged, and the time taken kept for estimates
+	static FString MakeResult(ELLMProvider ProviderId, FLLMResponseFields&& Fields, double Seconds);
+
+	// Queue a request whose response is turned into the result by the provider. RequestTokens is what the
+	// request counts against the provider's tokens-per-minute limit, the response included.
+	static TFuture<FString> ProcessRequest(ELLMProvider ProviderId, const TSharedRef<const ILLMProvider>& Provider,
+	                                       const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest,
+	                                       int32 RequestTokens, ELLMRequestPriority Priority,
+	                                       FLLMRequestScheduler::FAttemptCallbacks Callbacks);
+
+	// Queue a request whose response body is decoded as server-sent events while it arrives
+	static TFuture<FString> ProcessStreamingRequest(ELLMProvider ProviderId,
+	                                                const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest,
+	                                                int32 RequestTokens, const FLLMRequestOptions& Options,
+	                                                ELLMStreamFormat Format,
+	                                                FLLMRequestScheduler::FAttemptCallbacks Callbacks);
 };
\ No newline at end of file
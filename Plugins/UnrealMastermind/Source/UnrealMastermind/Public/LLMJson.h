@@ -0,0 +1,134 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+
+// Writes a JSON document straight into a UTF-8 buffer that is handed to the HTTP request as its body.
+// Strings are escaped and converted in the same pass, so a large prompt is copied once, into the body.
+class UNREALMASTERMIND_API FLLMJsonWriter
+{
+public:
+	explicit FLLMJsonWriter(int32 InitialCapacity = 0);
+
+	FLLMJsonWriter& BeginObject();
+	FLLMJsonWriter& EndObject();
+	FLLMJsonWriter& BeginArray();
+	FLLMJsonWriter& EndArray();
+
+	// Name of the next value in the current object; names are plain ASCII and written unescaped
+	FLLMJsonWriter& Key(FAnsiStringView Name);
+
+	FLLMJsonWriter& String(FStringView Text);
+
+	// Text that already is UTF-8 is copied as is, apart from the escapes
+	FLLMJsonWriter& String(FUtf8StringView Text);
+	FLLMJsonWriter& Int(int64 Value);
+	FLLMJsonWriter& Number(double Value);
+	FLLMJsonWriter& Bool(bool bValue);
+
+	int32 Num() const { return Buffer.Num(); }
+	FUtf8StringView ToView() const;
+
+	// The document written so far; the writer is empty afterwards
+	TArray<uint8> MoveBytes();
+
+private:
+	void BeginValue();
+	void AppendAscii(FAnsiStringView Text);
+	void AppendEscape(uint32 Char);
+
+	TArray<uint8> Buffer;
+
+	// Per open object or array, whether it has a value yet
+	TArray<bool, TInlineAllocator<16>> HasValue;
+	bool bAfterKey = false;
+};
+
+// Reads a JSON document in one forward pass without building a DOM. The visitor sees every string,
+// number, boolean and null with the path that leads to it, and only the strings it asks for are
+// unescaped and converted.
+class UNREALMASTERMIND_API FLLMJsonScanner
+{
+public:
+	struct FPathSegment
+	{
+		// Member name as written in the document, or empty for an array element
+		FAnsiStringView Key;
+		int32 Index = INDEX_NONE;
+	};
+
+	struct FPath
+	{
+		TArray<FPathSegment, TInlineAllocator<16>> Segments;
+
+		// Pattern of dot-separated member names and array indices, with * for any one segment,
+		// e.g. "choices.0.message.content" or "content.*.text"
+		bool Matches(FAnsiStringView Pattern) const;
+	};
+
+	struct FValue
+	{
+		enum class EType : uint8
+		{
+			String,
+			Number,
+			Bool,
+			Null
+		};
+
+		EType Type = EType::Null;
+
+		// The value as written, without the quotes of a string and with its escapes
+		FUtf8StringView Raw;
+
+		// Unescapes a string onto the end of Out
+		void AppendString(FString& Out) const;
+		FString GetString() const;
+		int64 GetInt() const;
+		bool GetBool() const;
+	};
+
+	using FVisitor = TFunctionRef<void(const FPath& Path, const FValue& Value)>;
+
+	// False if the document isn't valid JSON; the visitor may have seen part of it by then
+	static bool Scan(FUtf8StringView Json, FVisitor Visitor);
+
+private:
+	FLLMJsonScanner(FUtf8StringView Json, FVisitor InVisitor);
+
+	bool ScanValue(int32 Depth);
+	bool ScanString(FUtf8StringView& OutRaw);
+	void SkipWhitespace();
+
+	const UTF8CHAR* Cursor;
+	const UTF8CHAR* End;
+	FVisitor ValueVisitor;
+	FPath Path;
+};
+
+// File of one JSON document per line, only ever added to, for records that have to survive a crash: every
+// line is on disk before Write returns, and a line cut off by a crash is ended when the file is opened again,
+// so it fails to scan instead of spoiling the next one. Escaped strings never contain a line break, so a
+// document written by FLLMJsonWriter is one line.
+class UNREALMASTERMIND_API FLLMJsonLinesFile
+{
+public:
+	FLLMJsonLinesFile();
+	~FLLMJsonLinesFile();
+
+	// Starts an empty file, or adds to the lines already in it
+	bool Open(const FString& Filename, bool bAppend);
+	bool IsOpen() const { return File.IsValid(); }
+
+	// Takes the document out of the writer
+	void Write(FLLMJsonWriter& Json);
+
+	// Every complete line, without its line break
+	static bool Read(const FString& Filename, TFunctionRef<void(FUtf8StringView Line)> Visitor);
+
+private:
+	TUniquePtr<IFileHandle> File;
+};
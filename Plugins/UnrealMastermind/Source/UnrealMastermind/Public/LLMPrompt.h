@@ -0,0 +1,44 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A prompt as UTF-8, the encoding it is sent in. Copies share the text, so a prompt exists once no matter
+// how many cache lookups, hedged legs and retries use it, and goes into the request body without conversion.
+// The prefix is the start of the prompt that is byte for byte the same in every request of its kind; providers
+// mark it for their prompt cache, so it is processed once rather than with every request.
+class FLLMPrompt
+{
+public:
+	FLLMPrompt() = default;
+
+	explicit FLLMPrompt(TArray<UTF8CHAR>&& InText, int32 InPrefixLen = 0)
+		: Text(MakeShared<const TArray<UTF8CHAR>, ESPMode::ThreadSafe>(MoveTemp(InText)))
+		, PrefixLen(FMath::Clamp(InPrefixLen, 0, Text->Num()))
+	{
+	}
+
+	explicit FLLMPrompt(FUtf8StringView InText, int32 InPrefixLen = 0)
+		: Text(MakeShared<const TArray<UTF8CHAR>, ESPMode::ThreadSafe>(InText.GetData(), InText.Len()))
+		, PrefixLen(FMath::Clamp(InPrefixLen, 0, Text->Num()))
+	{
+	}
+
+	FUtf8StringView GetView() const
+	{
+		return Text.IsValid() ? FUtf8StringView(Text->GetData(), Text->Num()) : FUtf8StringView();
+	}
+
+	// The shared prefix and what follows it
+	FUtf8StringView GetPrefix() const { return GetView().Left(PrefixLen); }
+	FUtf8StringView GetSuffix() const { return GetView().RightChop(PrefixLen); }
+
+	// Length in bytes
+	int32 Len() const { return Text.IsValid() ? Text->Num() : 0; }
+	bool IsEmpty() const { return Len() == 0; }
+
+private:
+	TSharedPtr<const TArray<UTF8CHAR>, ESPMode::ThreadSafe> Text;
+	int32 PrefixLen = 0;
+};
@@ -0,0 +1,64 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "LLMPrompt.h"
+#include "LLMResponse.h"
+#include "LLMResponseStream.h"
+
+enum class ELLMProvider : uint8;
+
+// Everything a provider needs to build one chat request
+struct FLLMProviderRequest
+{
+	FString Model;
+	FString SystemPrompt;
+	FLLMPrompt Prompt;
+	int32 MaxTokens = 0;
+	float Temperature = 0.0f;
+
+	// Ask for a server-sent-events response; only set if the provider supports streaming
+	bool bStream = false;
+};
+
+// One LLM API: how to build its requests and read its responses. Credentials and endpoints come from
+// the plugin settings. Providers hold no per-request state and are used from any thread.
+class UNREALMASTERMIND_API ILLMProvider
+{
+public:
+	virtual ~ILLMProvider() = default;
+
+	// Model used unless another one is asked for
+	virtual FString GetDefaultModel() const = 0;
+	virtual FString GetEndpoint() const = 0;
+
+	// Why requests can't be sent with the current settings, or empty if they can
+	virtual FString GetConfigurationError() const = 0;
+
+	virtual TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FLLMProviderRequest& Request) const = 0;
+
+	// The documentation and usage in a complete response, or the error
+	virtual FLLMResponseFields ParseResponse(FHttpResponsePtr Response, bool bWasSuccessful) const = 0;
+
+	virtual bool SupportsStreaming() const { return false; }
+	virtual ELLMStreamFormat GetStreamFormat() const { return ELLMStreamFormat::OpenAI; }
+};
+
+// The provider behind each ELLMProvider setting; the built-in ones are registered by the module
+class UNREALMASTERMIND_API FLLMProviderRegistry
+{
+public:
+	static FLLMProviderRegistry& Get();
+
+	void Register(ELLMProvider Id, TSharedRef<const ILLMProvider> Provider);
+	void Unregister(ELLMProvider Id);
+
+	TSharedPtr<const ILLMProvider> Find(ELLMProvider Id) const;
+
+private:
+	mutable FRWLock Lock;
+	TMap<ELLMProvider, TSharedRef<const ILLMProvider>> Providers;
+};
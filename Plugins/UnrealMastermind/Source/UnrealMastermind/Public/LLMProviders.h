@@ -0,0 +1,43 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLMProvider.h"
+
+// Chat Completions API
+class UNREALMASTERMIND_API FOpenAIProvider : public ILLMProvider
+{
+public:
+	virtual FString GetDefaultModel() const override;
+	virtual FString GetEndpoint() const override;
+	virtual FString GetConfigurationError() const override;
+	virtual TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FLLMProviderRequest& Request) const override;
+	virtual FLLMResponseFields ParseResponse(FHttpResponsePtr Response, bool bWasSuccessful) const override;
+	virtual bool SupportsStreaming() const override { return true; }
+	virtual ELLMStreamFormat GetStreamFormat() const override { return ELLMStreamFormat::OpenAI; }
+};
+
+// Messages API
+class UNREALMASTERMIND_API FAnthropicProvider : public ILLMProvider
+{
+public:
+	virtual FString GetDefaultModel() const override;
+	virtual FString GetEndpoint() const override;
+	virtual FString GetConfigurationError() const override;
+	virtual TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FLLMProviderRequest& Request) const override;
+	virtual FLLMResponseFields ParseResponse(FHttpResponsePtr Response, bool bWasSuccessful) const override;
+	virtual bool SupportsStreaming() const override { return true; }
+	virtual ELLMStreamFormat GetStreamFormat() const override { return ELLMStreamFormat::Anthropic; }
+};
+
+// Any other completion API: a plain {"prompt": ...} request, and the text read from the most common fields
+class UNREALMASTERMIND_API FGenericLLMProvider : public ILLMProvider
+{
+public:
+	virtual FString GetDefaultModel() const override;
+	virtual FString GetEndpoint() const override;
+	virtual FString GetConfigurationError() const override;
+	virtual TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FLLMProviderRequest& Request) const override;
+	virtual FLLMResponseFields ParseResponse(FHttpResponsePtr Response, bool bWasSuccessful) const override;
+};
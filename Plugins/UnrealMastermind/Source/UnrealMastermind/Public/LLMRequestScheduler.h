@@ -0,0 +1,154 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+enum class ELLMProvider : uint8;
+
+enum class ELLMRequestPriority : uint8
+{
+	Interactive,    // Someone is waiting in the editor; runs before any background request
+	Background      // Batch work such as documenting a whole project
+};
+
+// Sends every request to a provider through one queue, so any number of generations share the
+// provider's rate limits instead of running into HTTP 429 on their own.
+// - Requests and tokens per minute are metered with token buckets. Their sizes come from the settings
+//   and are corrected by the rate-limit headers of each response.
+// - Rate-limited requests wait for retry-after (or the reset headers) and are sent again.
+// - Concurrency adapts: it is halved on 429, lowered by one when the time to the first byte climbs, and
+//   creeps back up while requests succeed quickly. The first byte leaves out how long the answer is.
+// - Each attempt is watched phase by phase, so a dead connection fails in seconds while a long
+//   generation that keeps sending is never cut short.
+class UNREALMASTERMIND_API FLLMRequestScheduler
+{
+public:
+	// Turns the final response into the result of the request; Seconds is how long that attempt took
+	using FResponseHandler = TFunction<FString(FHttpResponsePtr Response, bool bWasSuccessful, double Seconds)>;
+
+	// Limits in seconds on each phase of an attempt, zero for none
+	struct FPhaseTimeouts
+	{
+		// Until the request is being sent
+		float Connect = 0.0f;
+
+		// Until the response starts arriving
+		float FirstByte = 0.0f;
+
+		// Between two reads of the response, once it started
+		float Idle = 0.0f;
+
+		// The whole attempt
+		float Total = 0.0f;
+	};
+
+	struct FAttemptCallbacks
+	{
+		// Right before every attempt, so state built from an earlier, rate-limited attempt can be reset
+		TFunction<void()> OnStart;
+
+		// With the seconds from the start of the attempt to the first byte of a response that isn't an error
+		TFunction<void(double Seconds)> OnFirstByte;
+	};
+
+	static FLLMRequestScheduler& Get();
+
+	// Starts pumping the queues; called by the module
+	void Initialize();
+
+	// Fails the queued requests and cancels the sent ones
+	void Shutdown();
+
+	// Sends the request once the provider has capacity
+	TFuture<FString> Submit(ELLMProvider Provider, ELLMRequestPriority Priority, int32 EstimatedTokens,
+	                        const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest,
+	                        const FPhaseTimeouts& Timeouts, FResponseHandler ResponseHandler,
+	                        FAttemptCallbacks Callbacks = FAttemptCallbacks());
+
+	// Drops a request that is still queued, or cancels it if it was sent; the future of a queued request
+	// gets an error right away, that of a sent one once the HTTP module reports the cancellation
+	void Cancel(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest);
+
+private:
+	struct FJob
+	{
+		TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+		FResponseHandler ResponseHandler;
+		FAttemptCallbacks Callbacks;
+		FPhaseTimeouts Timeouts;
+		TPromise<FString> Promise;
+		ELLMRequestPriority Priority = ELLMRequestPriority::Interactive;
+		int32 EstimatedTokens = 0;
+		int32 NumAttempts = 0;
+
+		// Progress of the current attempt
+		double AttemptStartTime = 0.0;
+		double LastReceiveTime = 0.0;
+		uint64 BytesReceived = 0;
+		bool bConnected = false;
+
+		// From the start of the attempt to the first byte of the response, zero until it arrives
+		double FirstByteSeconds = 0.0;
+
+		// Why the watchdog cancelled the current attempt
+		FString TimeoutError;
+	};
+
+	// Refills continuously at Capacity per minute; a capacity of zero means no limit
+	struct FTokenBucket
+	{
+		double Capacity = 0.0;
+		double Level = 0.0;
+		double LastRefillTime = 0.0;
+
+		void Refill(double Now);
+		bool CanTake(double Amount) const;
+		void Take(double Amount);
+		void SetCapacity(double PerMinute);
+	};
+
+	struct FProviderState
+	{
+		// One queue per priority, drained in priority order
+		TArray<TSharedRef<FJob>> Queues[2];
+		TArray<TSharedRef<FJob>> InFlight;
+
+		FTokenBucket Requests;
+		FTokenBucket Tokens;
+
+		// Fractional so it can grow by a fraction of a request per success
+		double ConcurrencyLimit = 1.0;
+
+		// Nothing is sent before this time after a 429 or an exhausted limit
+		double BlockedUntil = 0.0;
+
+		// Time to the first byte, which grows with queueing at the provider but not with the answer's length
+		double AverageLatency = 0.0;
+		double BestLatency = 0.0;
+	};
+
+	FProviderState& GetProviderState(ELLMProvider Provider);
+
+	bool Tick(float DeltaTime);
+	void Pump();
+	void CheckTimeouts();
+	void OnAttemptProgress(const TSharedRef<FJob>& Job, uint64 BytesSent, uint64 BytesReceived);
+	static void Send(const TSharedRef<FJob>& Job);
+	void OnAttemptComplete(ELLMProvider Provider, const TSharedRef<FJob>& Job, FHttpResponsePtr Response,
+	                       bool bWasSuccessful);
+
+	static void ApplyRateLimitHeaders(FProviderState& State, const FHttpResponsePtr& Response, double Now);
+	static double ParseResetDelay(const FString& Value);
+
+	FCriticalSection Lock;
+	TMap<ELLMProvider, FProviderState> Providers;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// Set by Shutdown; nothing is queued or sent afterwards
+	bool bShutDown = false;
+};
@@ -0,0 +1,29 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// What the plugin reads from a provider's response; everything else in it is skipped
+struct FLLMResponseFields
+{
+	// The generated documentation
+	FString Content;
+
+	// Why generation stopped, in the provider's words, e.g. "stop", "end_turn", "length" or "max_tokens"
+	FString StopReason;
+
+	// Zero if the provider didn't report usage. InputTokens is the whole prompt, cached or not.
+	int32 InputTokens = 0;
+	int32 OutputTokens = 0;
+
+	// Prompt tokens read from the provider's prompt cache, and written to it for later requests
+	int32 CachedInputTokens = 0;
+	int32 CacheWriteInputTokens = 0;
+
+	// "Error: ..." if the request failed
+	FString Error;
+
+	// Generation ran into the max_tokens limit
+	bool IsTruncated() const { return StopReason == TEXT("length") || StopReason == TEXT("max_tokens"); }
+};
@@ -0,0 +1,49 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ELLMProvider : uint8;
+
+// Whether a request may be answered from the response cache
+enum class ELLMCachePolicy : uint8
+{
+	Use,        // Answer from the cache if possible, store new responses
+	Refresh     // Always send the request, and replace the cached response with the new one
+};
+
+// Responses of earlier requests in Saved/UnrealMastermind/ResponseCache, one file per response named
+// after the hash of everything that shapes it (provider, endpoint, model, system prompt, sampling and
+// the prompt itself). Repeating a request for an unchanged Blueprint costs a file read instead of a
+// round trip. The cache is capped in size; the least recently used responses are evicted first.
+class UNREALMASTERMIND_API FLLMResponseCache
+{
+public:
+	static FLLMResponseCache& Get();
+
+	static FString MakeKey(ELLMProvider Provider, FStringView Endpoint, FStringView Model, FStringView SystemPrompt,
+	                       float Temperature, int32 MaxTokens, FUtf8StringView Prompt);
+
+	bool Find(const FString& Key, FString& OutResponse);
+	void Store(const FString& Key, const FString& Response, int64 MaxTotalSize);
+
+private:
+	struct FEntry
+	{
+		int64 Size = 0;
+		FDateTime LastAccess;
+	};
+
+	static FString GetCacheDirectory();
+	static FString GetEntryPath(const FString& Key);
+
+	// Caller holds Lock
+	void LoadIndex();
+	void Evict(int64 MaxTotalSize);
+
+	FCriticalSection Lock;
+	TMap<FString, FEntry> Entries;
+	int64 TotalSize = 0;
+	bool bIndexLoaded = false;
+};
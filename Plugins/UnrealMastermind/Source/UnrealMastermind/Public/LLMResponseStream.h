@@ -0,0 +1,57 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpResponse.h"
+#include "LLMResponse.h"
+
+// Wire format of a streamed chat response
+enum class ELLMStreamFormat : uint8
+{
+	OpenAI,       // data: {"choices":[{"delta":{"content":"..."}}]} ... data: [DONE]
+	Anthropic     // event: content_block_delta / data: {"delta":{"type":"text_delta","text":"..."}}
+};
+
+// Decodes a server-sent-events response body as it arrives and hands out the generated text piece by
+// piece. Bytes are fed from the HTTP thread; events are only decoded once complete, so a UTF-8
+// character split across two reads is never cut in half.
+class UNREALMASTERMIND_API FLLMResponseStream
+{
+public:
+	// Called on the HTTP thread with each piece of text, in order
+	using FOnTextReceived = TFunction<void(const FString& /*Text*/)>;
+
+	FLLMResponseStream(ELLMStreamFormat InFormat, FOnTextReceived InOnTextReceived);
+
+	// Forget everything received so far, for a request that is sent (again)
+	void Restart();
+
+	// Feed the next bytes of the body; always accepts them
+	bool Append(const void* Data, int64 Length);
+
+	// The whole generated text with the usage the stream reported, or the error if the request or the stream failed
+	FLLMResponseFields Finish(FHttpResponsePtr Response, bool bWasSuccessful);
+
+	// Seconds from the (re)start to the first piece of text, or a negative value if none arrived yet
+	double GetTimeToFirstToken() const;
+
+private:
+	void ProcessEvent(FUtf8StringView Event);
+	void ProcessData(FUtf8StringView Data);
+
+	const ELLMStreamFormat Format;
+	const FOnTextReceived OnTextReceived;
+	double StartTime;
+
+	mutable FCriticalSection Lock;
+
+	// Bytes after the last complete event
+	TArray<uint8> Pending;
+
+	// The whole body as received, reported as is when the request failed
+	TArray<uint8> Body;
+
+	FLLMResponseFields Fields;
+	double FirstTokenTime = -1.0;
+};
@@ -0,0 +1,47 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Counts tokens like a byte-pair encoding model, offline, from a vocabulary in tiktoken's format: one base64
+// token and its rank per line. Text is split into pieces the way cl100k_base splits it (words with the space
+// before them, numbers of up to 3 digits, runs of punctuation, whitespace), then the bytes of each piece are
+// merged lowest rank first. With cl100k_base the count matches OpenAI's for ASCII text; other text and other
+// providers' models come out close, which is what budgets and cost estimates need.
+class UNREALMASTERMIND_API FLLMTokenizer
+{
+public:
+	// The tokenizer for the vocabulary in the plugin settings, loaded on first use and again once the setting
+	// changes. Null without a vocabulary, in which case callers estimate from the length of the text.
+	static TSharedPtr<const FLLMTokenizer> GetConfigured();
+
+	// Null if the file can't be read or isn't a tiktoken vocabulary
+	static TSharedPtr<const FLLMTokenizer> LoadFromFile(const FString& Filename, FString& OutError);
+
+	int32 CountTokens(FUtf8StringView Text) const;
+
+	int32 GetVocabularySize() const { return Entries.Num(); }
+
+private:
+	// A token is Bytes[Offset, Offset + Len); lower ranks were merged earlier when the vocabulary was trained
+	struct FEntry
+	{
+		int32 Offset = 0;
+		int32 Len = 0;
+		int32 Rank = 0;
+	};
+
+	void BuildIndex();
+
+	// INDEX_NONE if the bytes aren't a token
+	int32 FindRank(const UTF8CHAR* Token, int32 Len) const;
+
+	int32 CountPieceTokens(const UTF8CHAR* Piece, int32 Len) const;
+
+	TArray<uint8> Bytes;
+	TArray<FEntry> Entries;
+
+	// Open addressing into Entries, a power of two in size; INDEX_NONE marks an empty slot
+	TArray<int32> Slots;
+};
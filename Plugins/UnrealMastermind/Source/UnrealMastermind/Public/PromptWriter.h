@@ -0,0 +1,60 @@
+// Copyright 2025 © Froströk. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Append-only text buffer used to build prompts without per-line temporaries.
+// Values are written straight into one growing buffer (no Printf, no ChrN indent strings), and the
+// thread-local instance keeps its capacity between uses so steady-state extraction does not reallocate.
+// The buffer holds UTF-8, the encoding prompts are sent in, so text is converted once, as it is written.
+class UNREALMASTERMIND_API FPromptWriter
+{
+public:
+	FPromptWriter() = default;
+	explicit FPromptWriter(int32 InitialCapacity) { Reserve(InitialCapacity); }
+
+	// Writer owned by the calling thread; always returned empty, with the capacity of previous uses
+	static FPromptWriter& GetThreadLocal();
+
+	void Reset() { Buffer.Reset(); }
+
+	// Drop everything after the first NumBytes, keeping the capacity; never splits a character
+	void Truncate(int32 NumBytes);
+	void Reserve(int32 NumBytes);
+
+	// Length in bytes of UTF-8
+	int32 Len() const { return Buffer.Num(); }
+	bool IsEmpty() const { return Buffer.Num() == 0; }
+	FUtf8StringView ToView() const { return FUtf8StringView(Buffer.GetData(), Buffer.Num()); }
+	FString ToString() const;
+
+	// The text written so far; the writer is empty afterwards
+	TArray<UTF8CHAR> MoveText();
+
+	// How often the buffer had to grow since it was created
+	int32 GetNumGrowths() const { return NumGrowths; }
+
+	FPromptWriter& Append(FStringView Text);
+	FPromptWriter& Append(FUtf8StringView Text);
+	FPromptWriter& Append(TCHAR Char);
+	FPromptWriter& Append(FName Name);
+	FPromptWriter& AppendInt(int64 Value);
+
+	// Write a number of spaces in place
+	FPromptWriter& Indent(int32 NumSpaces);
+
+	FPromptWriter& operator<<(FStringView Text) { return Append(Text); }
+	FPromptWriter& operator<<(FUtf8StringView Text) { return Append(Text); }
+	FPromptWriter& operator<<(const FString& Text) { return Append(FStringView(Text)); }
+	FPromptWriter& operator<<(const TCHAR* Text) { return Append(FStringView(Text)); }
+	FPromptWriter& operator<<(TCHAR Char) { return Append(Char); }
+	FPromptWriter& operator<<(FName Name) { return Append(Name); }
+	FPromptWriter& operator<<(int32 Value) { return AppendInt(Value); }
+
+private:
+	UTF8CHAR* AddUninitialized(int32 NumBytes);
+
+	TArray<UTF8CHAR> Buffer;
+	int32 NumGrowths = 0;
+};
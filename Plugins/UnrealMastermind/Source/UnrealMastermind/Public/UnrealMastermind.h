@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+// Shared by the connector and the tokenizer; defined in LLMConnector.cpp
+DECLARE_LOG_CATEGORY_EXTERN(LogUnrealMastermindLLM, Log, All);
+
 class FToolBarBuilder;
 class FMenuBuilder;
 
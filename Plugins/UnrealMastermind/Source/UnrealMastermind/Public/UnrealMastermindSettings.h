@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "Engine/EngineTypes.h"
+#include "BlueprintDocumentationSettings.h"
 #include "UnrealMastermindSettings.generated.h"
 
 UENUM(BlueprintType)
@@ -46,49 +48,130 @@ public:
 	UPROPERTY(config, EditAnywhere, Category="Documentation Generation", meta=(ToolTip="Component/property names that start with these prefixes will be excluded from documentation"))
 	TArray<FString> IgnoredPropertyPrefixes;
 
+	UPROPERTY(config, EditAnywhere, Category="Documentation Generation", meta=(ClampMin="0.5", ClampMax="50.0", Units="ms", ToolTip="Time per editor frame spent reading a Blueprint before documentation is generated. Lower values keep the editor smoother on large Blueprints, higher values finish sooner"))
+	float SnapshotFrameBudgetMs;
+
+	UPROPERTY(config, EditAnywhere, Category="Documentation Generation", meta=(ToolTip="If enabled, Blueprints too large for one prompt are documented one function and event at a time, and the parts are then combined. If disabled, details are left out until the Blueprint fits one prompt"))
+	bool bSplitLargeBlueprints;
+
 	// The currently selected LLM provider
 	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(ToolTip="Select which AI provider to use for generating documentation"))
 	ELLMProvider SelectedProvider;
 
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(ClampMin="1", ClampMax="32", ToolTip="How many requests may run at the same time when a large Blueprint is documented in parts"))
+	int32 MaxConcurrentRequests;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(ClampMin="0", ToolTip="Requests per minute allowed by your provider account, 0 if unknown. Either way the limits reported by the provider with each response are followed"))
+	int32 RequestsPerMinute;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(ClampMin="0", ToolTip="Tokens per minute allowed by your provider account, 0 if unknown. Either way the limits reported by the provider with each response are followed"))
+	int32 TokensPerMinute;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(ToolTip="If enabled, documentation from OpenAI and Anthropic is shown as it is written instead of all at once when complete"))
+	bool bStreamResponses;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(ToolTip="If enabled, responses are kept in Saved/UnrealMastermind/ResponseCache and reused when the exact same request is made again, e.g. for an unchanged Blueprint. Shift-click Generate Documentation to ask the model again"))
+	bool bUseResponseCache;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(EditCondition="bUseResponseCache", ClampMin="1", Units="MB", ToolTip="Largest size of the response cache. The least recently used responses are removed first"))
+	int32 ResponseCacheSizeMB;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration", meta=(ToolTip="If enabled, the system prompt, instructions and glossary that start every prompt are marked for the provider's prompt cache, so they are processed once instead of with every request: cache_control for Anthropic, a cache key for OpenAI. Providers only cache prompt starts of some length, e.g. 1024 tokens"))
+	bool bUsePromptCaching;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Timeouts", meta=(ClampMin="0.0", Units="s", ToolTip="Time for a connection to the provider to be made, 0 for no limit"))
+	float ConnectTimeoutSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Timeouts", meta=(ClampMin="0.0", Units="s", ToolTip="Time for a streamed response to start once the request is sent, 0 for no limit. Responses that are not streamed only arrive once complete and are limited by the request timeout instead"))
+	float FirstByteTimeoutSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Timeouts", meta=(ClampMin="0.0", Units="s", ToolTip="Longest pause in a response once it started, 0 for no limit. A response that keeps arriving is never cut short by this"))
+	float IdleTimeoutSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Timeouts", meta=(ClampMin="0.0", Units="s", ToolTip="Longest time a request may take in total, 0 for no limit. Time spent waiting for the provider's rate limits is not counted"))
+	float RequestTimeoutSeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Hedging", meta=(ToolTip="If enabled, a request the selected provider is slow to answer is also sent to the hedge provider, and whichever answers first is used. A request that fails is sent to the hedge provider right away. Costs a second request whenever it kicks in"))
+	bool bHedgeRequests;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Hedging", meta=(EditCondition="bHedgeRequests", ToolTip="Provider asked when the selected one is slow or fails. Its credentials are set in its own section, and it should accept prompts as large as the selected provider does. May be the selected provider itself, with another model"))
+	ELLMProvider HedgeProvider;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Hedging", meta=(EditCondition="bHedgeRequests", ToolTip="Model of the hedge provider to use, or empty for the model set in its section. Not used by Other providers"))
+	FString HedgeModel;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Hedging", meta=(EditCondition="bHedgeRequests", ClampMin="50.0", ClampMax="99.9", ToolTip="A request is hedged once the selected provider has taken longer to start answering than this percentage of recent requests did"))
+	float HedgeLatencyPercentile;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Hedging", meta=(EditCondition="bHedgeRequests", ClampMin="0.0", Units="s", ToolTip="Time to wait for the selected provider to start answering until enough requests have been timed to use the percentile"))
+	float HedgeDelaySeconds;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Cost", meta=(ClampMin="0.0", ToolTip="Price per million prompt tokens of the selected model, in dollars. Shown as the estimated cost of a request before it is sent; 0 to show no cost"))
+	float InputCostPerMillionTokens;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Cost", meta=(ClampMin="0.0", ToolTip="Price per million prompt tokens read from the provider's prompt cache, in dollars; 0 for the normal input price"))
+	float CachedInputCostPerMillionTokens;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Cost", meta=(ClampMin="0.0", ToolTip="Price per million generated tokens of the selected model, in dollars"))
+	float OutputCostPerMillionTokens;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Tokenizer", meta=(FilePathFilter="tiktoken", ToolTip="Vocabulary used to count prompt tokens exactly, in tiktoken's format, e.g. cl100k_base.tiktoken. Empty for Resources/Tokenizers/cl100k_base.tiktoken in the plugin, which Scripts/fetch_tokenizer.py downloads. Without a vocabulary tokens are estimated at 4 bytes each"))
+	FFilePath TokenizerVocabulary;
+
 	// AI Prompt Settings
 	UPROPERTY(config, EditAnywhere, Category="AI Settings", meta=(DisplayName="System Prompt", MultiLine=true, ToolTip="This is the initial prompt that defines the AI's role and behavior when generating documentation"))
 	FString SystemPrompt;
 
+	UPROPERTY(config, EditAnywhere, Category="AI Settings", meta=(DisplayName="Project Glossary", MultiLine=true, ToolTip="Terms, abbreviations and naming conventions of your project for the documentation to use. Sent with every request, at the start of the prompt where the provider can cache it"))
+	FString ProjectGlossary;
+
 	UPROPERTY(config, EditAnywhere, Category= "AI Settings", meta=(DisplayName="Temperature", ClampMin="0.0", ClampMax="1.0", ToolTip="Controls the randomness of the AI's output. Lower values are more deterministic, higher values are more creative"))
 	float Temperature;
 
-	UPROPERTY(config, EditAnywhere, Category= "AI Settings", meta=(DisplayName="Max Tokens", ClampMin="100", ClampMax="16000", ToolTip="The maximum length of the generated documentation (in tokens, roughly 4 characters per token)"))
+	UPROPERTY(config, EditAnywhere, Category= "AI Settings", meta=(DisplayName="Max Tokens", ClampMin="100", ClampMax="16000", ToolTip="The maximum length of the generated documentation, in tokens. A token is about 4 characters of English text"))
 	int32 MaxTokens;
 
 	// OpenAI Configuration
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI", ToolTip="Your OpenAI API key. Required to use OpenAI's services"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI || (bHedgeRequests && HedgeProvider == ELLMProvider::OpenAI)", ToolTip="Your OpenAI API key. Required to use OpenAI's services"))
 	FString OpenAIApiKey;
 
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI", ToolTip="The OpenAI model to use (e.g., gpt-4, gpt-3.5-turbo)"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI || (bHedgeRequests && HedgeProvider == ELLMProvider::OpenAI)", ToolTip="The OpenAI model to use (e.g., gpt-4, gpt-3.5-turbo)"))
 	FString OpenAIModel;
 
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI", ToolTip="The endpoint URL for OpenAI API calls. Usually leave as default unless using a proxy"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI || (bHedgeRequests && HedgeProvider == ELLMProvider::OpenAI)", ToolTip="The endpoint URL for OpenAI API calls. Usually leave as default unless using a proxy"))
 	FString OpenAIEndpoint;
 
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI || (bHedgeRequests && HedgeProvider == ELLMProvider::OpenAI)", ClampMin="500", ToolTip="Largest prompt to send to OpenAI, in tokens. Blueprint details are reduced until the prompt fits. Leave room for Max Tokens within the model's context window"))
+	int32 OpenAIMaxInputTokens;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|OpenAI", meta = (EditCondition = "SelectedProvider == ELLMProvider::OpenAI || (bHedgeRequests && HedgeProvider == ELLMProvider::OpenAI)", ClampMin="-1", ToolTip="For OpenAI-compatible local servers such as llama.cpp: the slot requests run in, so each prompt reuses the start of the previous one kept in that slot. Requests then take turns in that slot. -1 to leave it to the server, which api.openai.com requires"))
+	int32 OpenAIServerSlot;
+
 	// Anthropic Configuration
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Anthropic", meta = (EditCondition = "SelectedProvider == ELLMProvider::Anthropic", ToolTip="Your Anthropic API key. Required to use Anthropic services"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Anthropic", meta = (EditCondition = "SelectedProvider == ELLMProvider::Anthropic || (bHedgeRequests && HedgeProvider == ELLMProvider::Anthropic)", ToolTip="Your Anthropic API key. Required to use Anthropic services"))
 	FString AnthropicApiKey;
 	
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Anthropic", meta = (EditCondition = "SelectedProvider == ELLMProvider::Anthropic", ToolTip="The Anthropic model to use (e.g., claude-2, claude-instant-1)"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Anthropic", meta = (EditCondition = "SelectedProvider == ELLMProvider::Anthropic || (bHedgeRequests && HedgeProvider == ELLMProvider::Anthropic)", ToolTip="The Anthropic model to use (e.g., claude-2, claude-instant-1)"))
 	FString AnthropicModel;
 	
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Anthropic", meta = (EditCondition = "SelectedProvider == ELLMProvider::Anthropic", ToolTip="The endpoint URL for Anthropic API calls"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Anthropic", meta = (EditCondition = "SelectedProvider == ELLMProvider::Anthropic || (bHedgeRequests && HedgeProvider == ELLMProvider::Anthropic)", ToolTip="The endpoint URL for Anthropic API calls"))
 	FString AnthropicApiEndpoint;
 
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Anthropic", meta = (EditCondition = "SelectedProvider == ELLMProvider::Anthropic || (bHedgeRequests && HedgeProvider == ELLMProvider::Anthropic)", ClampMin="500", ToolTip="Largest prompt to send to Anthropic, in tokens. Blueprint details are reduced until the prompt fits"))
+	int32 AnthropicMaxInputTokens;
+
 	// Other Provider Configuration
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Other", meta = (EditCondition = "SelectedProvider == ELLMProvider::Other", ToolTip="Name of the alternative AI provider you're using"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Other", meta = (EditCondition = "SelectedProvider == ELLMProvider::Other || (bHedgeRequests && HedgeProvider == ELLMProvider::Other)", ToolTip="Name of the alternative AI provider you're using"))
 	FString OtherProviderName;
 
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Other", meta = (EditCondition = "SelectedProvider == ELLMProvider::Other", ToolTip="API key for the alternative provider"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Other", meta = (EditCondition = "SelectedProvider == ELLMProvider::Other || (bHedgeRequests && HedgeProvider == ELLMProvider::Other)", ToolTip="API key for the alternative provider"))
 	FString OtherProviderApiKey;
 
-	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Other", meta = (EditCondition = "SelectedProvider == ELLMProvider::Other", ToolTip="Endpoint URL for the alternative provider"))
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Other", meta = (EditCondition = "SelectedProvider == ELLMProvider::Other || (bHedgeRequests && HedgeProvider == ELLMProvider::Other)", ToolTip="Endpoint URL for the alternative provider"))
 	FString OtherProviderEndpoint;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LLM Configuration|Other", meta = (EditCondition = "SelectedProvider == ELLMProvider::Other || (bHedgeRequests && HedgeProvider == ELLMProvider::Other)", ClampMin="500", ToolTip="Largest prompt to send to the alternative provider, in tokens. Blueprint details are reduced until the prompt fits"))
+	int32 OtherProviderMaxInputTokens;
 	
 
 	// Display Settings
@@ -97,6 +180,13 @@ public:
 	int32 DocumentationPreviewChars;
 
 public:
+	// Settings used to extract and render a Blueprint, populated from these persistent settings
+	FBlueprintDocumentationSettings MakeDocumentationSettings() const;
+
+	// Input token limit of the selected provider
+	int32 GetMaxInputTokens() const;
+	int32 GetMaxInputTokens(ELLMProvider Provider) const;
+
 	//~ Begin UDeveloperSettings Interface
 	virtual FName GetCategoryName() const override;
 	virtual FText GetSectionText() const override;
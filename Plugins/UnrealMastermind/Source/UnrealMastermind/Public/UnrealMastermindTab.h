@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "BlueprintDocumentationSettings.h"
+#include "LLMConnector.h"
 #include "SSearchableComboBox.h"
 #include "Widgets/SCompoundWidget.h"
 #include "EdGraph/EdGraphNode.h"
@@ -12,6 +13,11 @@
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "Widgets/Notifications/SProgressBar.h"
 
+class FBlueprintSnapshotTask;
+struct FAssetData;
+struct FBlueprintIR;
+struct FBlueprintPromptBudgetReport;
+
 class SUnrealMastermindTab : public SCompoundWidget
 {
 public:
@@ -37,9 +43,13 @@ private:
 	TSharedPtr<SProgressBar> GenerationProgressBar;
 	TSharedPtr<STextBlock> GenerationStatusText;
 	TSharedPtr<SVerticalBox> LoadingIndicatorBox;
+
+	// Prompt tokens, cost and time of the last request, shown before it is sent
+	TSharedPtr<STextBlock> RequestEstimateText;
 	
 	// Button Callbacks
 	FReply OnGenerateDocumentationClicked();
+	FReply OnEstimateClicked();
 	FReply OnSaveDocumentationClicked() const;
 	
 	// Blueprint Functions
@@ -47,21 +57,35 @@ private:
 	void OnBlueprintSelected(TSharedPtr<FString> SelectedItem, ESelectInfo::Type SelectInfo);
 	TSharedRef<SWidget> MakeBlueprintComboItemWidget(TSharedPtr<FString> BlueprintName);
 	UBlueprint* GetSelectedBlueprint() const;
-	void ExtractEventGraphInfo(UBlueprint* Blueprint, const FBlueprintDocumentationSettings& Settings,
-	                           FString& BlueprintInfo);
-	void ExtractFunctionGraphInfo(UBlueprint* Blueprint, const FBlueprintDocumentationSettings& Settings,
-	                              FString& BlueprintInfo);
-	void ExtractVariableInfo(UBlueprint* Blueprint, FString& BlueprintInfo) const;
-	FString ExtractBlueprintInfo(UBlueprint* Blueprint, const FBlueprintDocumentationSettings& Settings);
-	void AddImportantComponentProperties(FString& BlueprintInfo, UActorComponent* Component, const USCS_Node* Node) const;
-	void TraceExecutionFlow(UEdGraphPin* ExecPin, FString& BlueprintInfo, int32 Depth, int32 MaxDepth);
-	FString GetPinValue(UEdGraphPin* Pin) const;
+	// Registry data of the selected Blueprint, without loading it
+	bool FindSelectedAsset(FAssetData& OutAsset) const;
+	void ShowDocumentation(const FString& Documentation);
+	// Renders through the calling thread's FPromptWriter and returns a copy the caller owns
+	static FLLMPrompt ExtractBlueprintInfo(const FBlueprintIR& Snapshot,
+	                                       const FBlueprintDocumentationSettings& Settings, int32 TokenBudget,
+	                                       FBlueprintPromptBudgetReport& OutReport);
+	// Snapshot the selected Blueprint and render its prompt, then send it unless only an estimate is wanted
+	void AnalyzeSelectedBlueprint(bool bEstimateOnly);
+	void OnSnapshotComplete(TSharedPtr<const FBlueprintIR> Snapshot, FBlueprintDocumentationSettings DocSettings,
+	                        FString CustomPromptText, bool bEstimateOnly);
+	void ShowRequestEstimate(const FLLMRequestEstimate& Estimate, int32 NumParts);
+	void OnDocumentationTextReceived(const FString& Text, double RequestStartTime);
 
 	// Documentation Generation
 	TSharedPtr<FString> CurrentSelectedBlueprint;
 	FString GeneratedDocumentation;
 
-	void AddAllComponentProperties(FString& BlueprintInfo, UActorComponent* Component, const USCS_Node* Node, const TArray<FString>& IgnoredPrefixes) const;
+	// What the generated documentation was generated from, stamped on it when it is saved
+	FString GeneratedSourceHash;
+
+	// Documentation received so far while the response is streamed
+	FString StreamedDocumentation;
+
+	// Shift-click asks the model again instead of reusing a cached response
+	ELLMCachePolicy CachePolicy = ELLMCachePolicy::Use;
+
+	// Game-thread capture of the Blueprint being documented
+	TSharedPtr<FBlueprintSnapshotTask> ActiveSnapshot;
 	
 	// Generation status
 	bool bIsGenerating;